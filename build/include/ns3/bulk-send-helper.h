@@ -0,0 +1 @@
+#include "/root/repo/src/applications/helper/bulk-send-helper.h"
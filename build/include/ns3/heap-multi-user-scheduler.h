@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/he/heap-multi-user-scheduler.h"
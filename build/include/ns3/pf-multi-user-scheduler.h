@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/he/pf-multi-user-scheduler.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/internet/model/rip-header.h"
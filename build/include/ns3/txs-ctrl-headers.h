@@ -0,0 +1 @@
+#include "/root/repo/src/txs-module/model/txs-ctrl-headers.h"
@@ -0,0 +1,10 @@
+#ifdef NS3_MODULE_COMPILATION 
+    error "Do not include ns3 module aggregator headers from other modules these are meant only for end user scripts." 
+#endif 
+#ifndef NS3_MODULE_TXS_MODULE
+    // Module headers: 
+    #include <ns3/txs-wifi-mac-helper.h>
+    #include <ns3/txs-ctrl-headers.h>
+    #include <ns3/txs-frame-exchange-manager.h>
+    #include <ns3/txs-multi-user-scheduler.h>
+#endif 
\ No newline at end of file
@@ -0,0 +1 @@
+#include "/root/repo/src/txs-module/model/txs-multi-user-scheduler.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/txs-module/helper/txs-wifi-mac-helper.h"
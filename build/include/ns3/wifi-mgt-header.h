@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/wifi-mgt-header.h"
@@ -494,9 +494,6 @@ class Callback : public CallbackBase
               typename... BArgs>
     Callback(T func, BArgs... bargs)
     {
-        // store the function in a std::function object
-        std::function<R(BArgs..., UArgs...)> f(func);
-
         // The original function is comparable if it is a function pointer or
         // a pointer to a member function or a pointer to a member data.
         constexpr bool isComp =
@@ -506,11 +503,33 @@ class Callback : public CallbackBase
             {std::make_shared<CallbackComponent<T, isComp>>(func),
              std::make_shared<CallbackComponent<std::decay_t<BArgs>>>(bargs)...});
 
-        m_impl = Create<CallbackImpl<R, UArgs...>>(
-            [f, bargs...](auto&&... uargs) -> R {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        if constexpr (std::is_member_function_pointer_v<T>)
+        {
+            // invoke the member function directly (e.g., for the callbacks built by
+            // MakeCallback() to trace sinks), which saves the indirect call through
+            // an intermediate std::function object. As through the std::function,
+            // the bound arguments are passed by value: the copy of the pointer to the
+            // object keeps the object alive if the member function destroys the
+            // callback (e.g., by replacing the callback of the object).
+            m_impl = Create<CallbackImpl<R, UArgs...>>(
+                [func, bargs...](auto&&... uargs) -> R {
+                    return [func](std::decay_t<BArgs>... b, decltype(uargs)... u) -> R {
+                        return std::invoke(func, b..., std::forward<decltype(u)>(u)...);
+                    }(bargs..., std::forward<decltype(uargs)>(uargs)...);
+                },
+                components);
+        }
+        else
+        {
+            // store the function in a std::function object
+            std::function<R(BArgs..., UArgs...)> f(func);
+
+            m_impl = Create<CallbackImpl<R, UArgs...>>(
+                [f, bargs...](auto&&... uargs) -> R {
+                    return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
+                },
+                components);
+        }
     }
 
   private:
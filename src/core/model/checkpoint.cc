@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "checkpoint.h"
+
+#include "abort.h"
+#include "log.h"
+#include "multithreaded-simulator-impl.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <thread>
+
+#ifndef __WIN32__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::Checkpoint implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Checkpoint");
+
+namespace
+{
+
+/** The variant index of this process. */
+uint32_t g_variant = Checkpoint::NO_VARIANT;
+
+/** The number of children of the last checkpoint that did not exit successfully. */
+uint32_t g_nFailed = 0;
+
+} // namespace
+
+EventId
+Checkpoint::Schedule(const Time& delay,
+                     uint32_t nVariants,
+                     VariantCallback variant,
+                     uint32_t maxChildren)
+{
+    NS_LOG_FUNCTION(delay << nVariants << maxChildren);
+    NS_ASSERT_MSG(nVariants > 0, "A checkpoint needs at least one variant");
+    NS_ASSERT_MSG(!variant.IsNull(), "A checkpoint needs a variant callback");
+    if (maxChildren == 0)
+    {
+        maxChildren = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    return Simulator::Schedule(delay, &Checkpoint::Fork, nVariants, variant, maxChildren);
+}
+
+uint32_t
+Checkpoint::GetVariant()
+{
+    return g_variant;
+}
+
+uint32_t
+Checkpoint::GetNFailed()
+{
+    return g_nFailed;
+}
+
+void
+Checkpoint::Fork(uint32_t nVariants, VariantCallback variant, uint32_t maxChildren)
+{
+    NS_LOG_FUNCTION(nVariants << maxChildren);
+#ifdef __WIN32__
+    NS_FATAL_ERROR("Checkpoints are not supported on Windows");
+#else
+    NS_ABORT_MSG_UNLESS(g_variant == NO_VARIANT, "Checkpoints cannot be nested");
+    auto mt = DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    NS_ABORT_MSG_IF(mt && mt->GetNPartitions() > 1,
+                    "Checkpoints cannot be used while events are executed by several threads");
+
+    // do not let the children write again what the parent has buffered
+    std::cout.flush();
+    std::cerr.flush();
+    std::clog.flush();
+    std::fflush(nullptr);
+
+    g_nFailed = 0;
+    // the children forked by this checkpoint, in the order they were forked; other children
+    // of this process (e.g., created by the simulation script) are never waited for here
+    std::deque<pid_t> children;
+
+    auto waitChild = [&children]() {
+        pid_t pid = children.front();
+        children.pop_front();
+        int status;
+        pid_t ret;
+        do
+        {
+            ret = waitpid(pid, &status, 0);
+        } while (ret < 0 && errno == EINTR);
+        NS_ABORT_MSG_IF(ret < 0, "waitpid() failed for child process " << pid);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            NS_LOG_WARN("Child process " << pid << " failed");
+            g_nFailed++;
+        }
+    };
+
+    for (uint32_t i = 0; i < nVariants; i++)
+    {
+        if (children.size() == maxChildren)
+        {
+            waitChild();
+        }
+        pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "fork() failed");
+        if (pid == 0)
+        {
+            // child process: apply the variant and continue the simulation
+            g_variant = i;
+            NS_LOG_LOGIC("Variant " << i << " started at " << Simulator::Now().As(Time::S));
+            variant(i);
+            return;
+        }
+        NS_LOG_LOGIC("Forked process " << pid << " for variant " << i);
+        children.push_back(pid);
+    }
+
+    while (!children.empty())
+    {
+        waitChild();
+    }
+    NS_LOG_LOGIC(nVariants << " variants completed, " << g_nFailed << " failed");
+    Simulator::Stop();
+#endif
+}
+
+} // namespace ns3
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "callback.h"
+#include "event-id.h"
+#include "nstime.h"
+
+#include <limits>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::Checkpoint declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Fork the simulation into several variants sharing the same warm-up.
+ *
+ * Many simulation campaigns run a set of variants that only differ after
+ * an initial warm-up phase (association, address resolution, TCP slow
+ * start, ...). A checkpoint scheduled at the end of the warm-up forks the
+ * simulation process into one child process per variant: every child
+ * inherits a copy of the whole simulation state at the checkpoint (event
+ * list, objects, random number generator streams, open files), invokes the
+ * variant callback with its variant index so that the variant parameters
+ * can be applied (e.g., by means of Config::Set()) and the output files
+ * renamed, and then continues the simulation from the checkpoint.
+ *
+ * The parent process executes no further event: it waits for the children
+ * to exit, running at most the given number of children at the same time,
+ * and then stops the simulation. Hence, the typical usage is:
+ *
+ * \code
+ *   Checkpoint::Schedule(Seconds(2), nVariants, MakeCallback(&ApplyVariant));
+ *   Simulator::Run();
+ *   if (Checkpoint::GetVariant() == Checkpoint::NO_VARIANT)
+ *   {
+ *       // parent process: the variants were executed by the children
+ *       Simulator::Destroy();
+ *       return Checkpoint::GetNFailed() == 0 ? 0 : 1;
+ *   }
+ *   // child process: collect and write the results of the variant
+ * \endcode
+ *
+ * Note that the random variables created before the checkpoint keep their
+ * state in all the children, i.e., changing the run number in the variant
+ * callback only affects the random variables created afterwards. The
+ * output of the parent buffered by the C and C++ standard streams is
+ * flushed before forking, so that it is not duplicated by the children.
+ *
+ * This facility relies on the POSIX fork() function, hence it is not
+ * available on Windows, and cannot be used with a simulator implementation
+ * running events in several threads, because only the calling thread
+ * exists in the children.
+ */
+class Checkpoint
+{
+  public:
+    /** Variant index returned by GetVariant() in the parent process. */
+    static constexpr uint32_t NO_VARIANT = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * Callback invoked by each child process with its variant index, in
+     * the range <tt>[0, nVariants)</tt>.
+     */
+    typedef Callback<void, uint32_t> VariantCallback;
+
+    /**
+     * Schedule a checkpoint forking the simulation into the given number of
+     * variants.
+     *
+     * \param [in] delay The delay of the checkpoint, relative to the current time.
+     * \param [in] nVariants The number of variants (i.e., of child processes).
+     * \param [in] variant The callback invoked by each child with its variant index.
+     * \param [in] maxChildren The maximum number of children executed at the
+     *             same time (0: the number of hardware threads).
+     * \return The id of the checkpoint event.
+     */
+    static EventId Schedule(const Time& delay,
+                            uint32_t nVariants,
+                            VariantCallback variant,
+                            uint32_t maxChildren = 0);
+
+    /**
+     * \return The variant index of the calling process, or NO_VARIANT in the
+     * parent process (including before the checkpoint).
+     */
+    static uint32_t GetVariant();
+
+    /**
+     * \return The number of children of the last checkpoint that did not
+     * exit successfully (only meaningful in the parent process).
+     */
+    static uint32_t GetNFailed();
+
+  private:
+    /**
+     * Fork the child processes, executed at the checkpoint.
+     *
+     * \param [in] nVariants The number of variants.
+     * \param [in] variant The callback invoked by each child with its variant index.
+     * \param [in] maxChildren The maximum number of children executed at the same time.
+     */
+    static void Fork(uint32_t nVariants, VariantCallback variant, uint32_t maxChildren);
+};
+
+} // namespace ns3
+
+#endif /* CHECKPOINT_H */
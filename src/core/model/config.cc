@@ -25,8 +25,12 @@
 #include "object.h"
 #include "pointer.h"
 #include "singleton.h"
+#include "trace-source-accessor.h"
 
+#include <functional>
+#include <map>
 #include <sstream>
+#include <unordered_map>
 
 /**
  * \file
@@ -197,6 +201,9 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, at construction, into the list of
+ * the index ranges it matches.
  */
 class ArrayMatcher
 {
@@ -216,6 +223,12 @@ class ArrayMatcher
     bool Matches(std::size_t i) const;
 
   private:
+    /**
+     * Parse one of the alternatives of the Config path specification.
+     *
+     * \param [in] element The alternative.
+     */
+    void Parse(std::string element);
     /**
      * Convert a string to an \c uint32_t.
      *
@@ -226,73 +239,77 @@ class ArrayMatcher
     bool StringToUint32(std::string str, uint32_t* value) const;
     /** The Config path element. */
     std::string m_element;
+    /** Whether the element matches all the indices. */
+    bool m_any;
+    /** The ranges of indices matched by the element, bounds included. */
+    std::vector<std::pair<uint32_t, uint32_t>> m_ranges;
 
 }; // class ArrayMatcher
 
 ArrayMatcher::ArrayMatcher(std::string element)
-    : m_element(element)
+    : m_element(element),
+      m_any(false)
 {
     NS_LOG_FUNCTION(this << element);
+    std::string::size_type start = 0;
+    std::string::size_type tmp;
+    while ((tmp = element.find('|', start)) != std::string::npos)
+    {
+        Parse(element.substr(start, tmp - start));
+        start = tmp + 1;
+    }
+    Parse(element.substr(start));
 }
 
-bool
-ArrayMatcher::Matches(std::size_t i) const
+void
+ArrayMatcher::Parse(std::string element)
 {
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
-    {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
-    }
-    std::string::size_type tmp;
-    tmp = m_element.find('|');
-    if (tmp != std::string::npos)
+    NS_LOG_FUNCTION(this << element);
+    if (element == "*")
     {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
-        }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
-        }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
+        m_any = true;
+        return;
     }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
         dash < rightBracket)
     {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
+        std::string lowerBound = element.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = element.substr(dash + 1, rightBracket - (dash + 1));
         uint32_t min;
         uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max))
         {
-            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-            return true;
-        }
-        else
-        {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
-            return false;
+            m_ranges.emplace_back(min, max);
         }
+        return;
     }
     uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
+    if (StringToUint32(element, &value))
+    {
+        m_ranges.emplace_back(value, value);
+    }
+}
+
+bool
+ArrayMatcher::Matches(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    if (m_any)
     {
         NS_LOG_DEBUG("Array " << i << " matches " << m_element);
         return true;
     }
+    for (const auto& [min, max] : m_ranges)
+    {
+        if (i >= min && i <= max)
+        {
+            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+            return true;
+        }
+    }
     NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
     return false;
 }
@@ -307,6 +324,188 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
     return !iss.bad() && !iss.fail();
 }
 
+/**
+ * \ingroup config-impl
+ * A Config path, parsed once into its elements.
+ *
+ * Each element holds what does not depend on the objects matching the path:
+ * the index matcher, the TypeId of a GetObject element and, for each TypeId
+ * of the objects met on the path, the attributes matching the element.
+ * The ConfigImpl keeps the compiled paths, so that repeated Config calls
+ * with the same path neither parse the path nor search the attributes
+ * of the TypeIds again.
+ */
+class CompiledPath : public SimpleRefCount<CompiledPath>
+{
+  public:
+    /** An attribute matching a path element. */
+    struct Attribute
+    {
+        /** The attribute name. */
+        std::string name;
+        /** The attribute accessor, or null if the attribute is not gettable. */
+        Ptr<const AttributeAccessor> accessor;
+        /** Whether the attribute is an ObjectPtrContainer, otherwise a Pointer. */
+        bool container;
+    };
+
+    /** The attributes matching an element, in the order of the TypeId hierarchy. */
+    typedef std::vector<Attribute> Attributes;
+
+    /** An element of the path. */
+    struct Element
+    {
+        /**
+         * Constructor.
+         *
+         * \param [in] element The path element.
+         */
+        Element(std::string element);
+
+        /** The path element. */
+        std::string item;
+        /** Whether the element starts the "/Names" name space. */
+        bool names;
+        /** Whether the element is a call to GetObject. */
+        bool getObject;
+        /** Whether tid holds the TypeId of a call to GetObject. */
+        bool hasTid;
+        /** The TypeId of a call to GetObject. */
+        TypeId tid;
+        /** The element as a matcher of the indices of a container. */
+        ArrayMatcher matcher;
+        /** The attributes matching the element, indexed by TypeId uid. */
+        std::unordered_map<uint16_t, Attributes> attributes;
+    };
+
+    /**
+     * Compile a Config path.
+     *
+     * \param [in] path The Config path.
+     */
+    CompiledPath(std::string path);
+
+    /** \returns The number of elements of the path. */
+    std::size_t GetN() const;
+
+    /**
+     * \param [in] i The index of the element.
+     * \returns The element.
+     */
+    const Element& Get(std::size_t i) const;
+
+    /**
+     * Get the attributes of a TypeId matching an element, searching them
+     * on the first call for the TypeId.
+     *
+     * \param [in] i The index of the element.
+     * \param [in] tid The TypeId of the object matching the path so far.
+     * \returns The attributes of \pname{tid} matching the element.
+     */
+    const Attributes& GetAttributes(std::size_t i, TypeId tid);
+
+  private:
+    /** The elements of the path. */
+    std::vector<Element> m_elements;
+
+}; // class CompiledPath
+
+CompiledPath::Element::Element(std::string element)
+    : item(element),
+      names(element.compare(0, 5, "Names") == 0),
+      getObject(element.find('$') == 0),
+      hasTid(false),
+      matcher(element)
+{
+    if (getObject)
+    {
+        // an unknown TypeId is reported when the element is reached
+        hasTid = TypeId::LookupByNameFailSafe(element.substr(1), &tid);
+    }
+}
+
+CompiledPath::CompiledPath(std::string path)
+{
+    NS_LOG_FUNCTION(this << path);
+
+    // ensure that we start and end with a '/'
+    if (path.find('/') != 0)
+    {
+        // no slash at start
+        path = "/" + path;
+    }
+    if (path.find_last_of('/') != (path.size() - 1))
+    {
+        // no slash at end
+        path = path + "/";
+    }
+
+    std::string::size_type start = 1;
+    std::string::size_type next;
+    while ((next = path.find('/', start)) != std::string::npos)
+    {
+        m_elements.emplace_back(path.substr(start, next - start));
+        start = next + 1;
+    }
+}
+
+std::size_t
+CompiledPath::GetN() const
+{
+    return m_elements.size();
+}
+
+const CompiledPath::Element&
+CompiledPath::Get(std::size_t i) const
+{
+    return m_elements[i];
+}
+
+const CompiledPath::Attributes&
+CompiledPath::GetAttributes(std::size_t i, TypeId tid)
+{
+    Element& element = m_elements[i];
+    auto it = element.attributes.find(tid.GetUid());
+    if (it != element.attributes.end())
+    {
+        return it->second;
+    }
+
+    NS_LOG_FUNCTION(this << i << tid.GetName());
+    Attributes& attributes = element.attributes[tid.GetUid()];
+    TypeId nextTid = tid;
+    do
+    {
+        tid = nextTid;
+
+        for (std::size_t j = 0; j < tid.GetAttributeN(); j++)
+        {
+            TypeId::AttributeInformation info = tid.GetAttribute(j);
+            if (info.name != element.item && element.item != "*")
+            {
+                continue;
+            }
+            bool gettable = (info.flags & TypeId::ATTR_GET) && info.accessor->HasGetter();
+            Ptr<const AttributeAccessor> accessor = gettable ? info.accessor : nullptr;
+            if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+            {
+                attributes.push_back({info.name, accessor, false});
+            }
+            else if (dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                     nullptr)
+            {
+                attributes.push_back({info.name, accessor, true});
+            }
+            // this could be anything else and we don't know what to do with it.
+            // So, we just ignore it.
+        }
+
+        nextTid = tid.GetParent();
+    } while (nextTid != tid);
+
+    return attributes;
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
@@ -315,11 +514,11 @@ class Resolver
 {
   public:
     /**
-     * Construct from a base Config path.
+     * Construct from a compiled Config path.
      *
      * \param [in] path The Config path.
      */
-    Resolver(std::string path);
+    Resolver(Ptr<CompiledPath> path);
     /** Destructor. */
     virtual ~Resolver();
 
@@ -333,55 +532,73 @@ class Resolver
     void Resolve(Ptr<Object> root);
 
   private:
-    /** Ensure the Config path starts and ends with a '/'. */
-    void Canonicalize();
     /**
      * Parse the next element in the Config path.
      *
-     * \param [in] path The remaining portion of the Config path.
+     * \param [in] i The index of the next element of the Config path.
      * \param [in] root The object corresponding to the current position
      *                  in the Config path.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoResolve(std::size_t i, Ptr<Object> root);
     /**
      * Parse an index on the Config path.
      *
-     * \param [in] path The remaining Config path.
+     * \param [in] i The index of the next element of the Config path.
      * \param [in,out] vector The resulting list of matching objects.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    void DoArrayResolve(std::size_t i, const ObjectPtrContainerValue& vector);
     /**
      * Handle one object found on the path.
      *
      * \param [in] object The current object on the Config path.
      */
     void DoResolveOne(Ptr<Object> object);
+    /**
+     * Get the value of an attribute leading to the next objects on the path.
+     *
+     * \param [in] object The current object on the Config path.
+     * \param [in] attribute The attribute.
+     * \param [out] value The value of the attribute.
+     */
+    void GetAttribute(Ptr<Object> object,
+                      const CompiledPath::Attribute& attribute,
+                      AttributeValue& value) const;
+    /**
+     * Append an element to the current Config path.
+     *
+     * \param [in] item The element.
+     */
+    void Push(const std::string& item);
+    /** Remove the last element of the current Config path. */
+    void Pop();
     /**
      * Get the current Config path.
      *
      * \returns The current Config path.
      */
-    std::string GetResolvedPath() const;
+    const std::string& GetResolvedPath() const;
     /**
      * Handle one found object.
      *
      * \param [in] object The found object.
      * \param [in] path The matching Config path context.
      */
-    virtual void DoOne(Ptr<Object> object, std::string path) = 0;
+    virtual void DoOne(Ptr<Object> object, const std::string& path) = 0;
 
-    /** Current list of path tokens. */
-    std::vector<std::string> m_workStack;
+    /** The lengths of the current Config path before each element was appended. */
+    std::vector<std::size_t> m_workStack;
+    /** The current Config path. */
+    std::string m_resolvedPath;
     /** The Config path. */
-    std::string m_path;
+    Ptr<CompiledPath> m_path;
 
 }; // class Resolver
 
-Resolver::Resolver(std::string path)
-    : m_path(path)
+Resolver::Resolver(Ptr<CompiledPath> path)
+    : m_resolvedPath("/"),
+      m_path(path)
 {
     NS_LOG_FUNCTION(this << path);
-    Canonicalize();
 }
 
 Resolver::~Resolver()
@@ -390,44 +607,32 @@ Resolver::~Resolver()
 }
 
 void
-Resolver::Canonicalize()
+Resolver::Resolve(Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION(this << root);
 
-    // ensure that we start and end with a '/'
-    std::string::size_type tmp = m_path.find('/');
-    if (tmp != 0)
-    {
-        // no slash at start
-        m_path = "/" + m_path;
-    }
-    tmp = m_path.find_last_of('/');
-    if (tmp != (m_path.size() - 1))
-    {
-        // no slash at end
-        m_path = m_path + "/";
-    }
+    DoResolve(0, root);
 }
 
 void
-Resolver::Resolve(Ptr<Object> root)
+Resolver::Push(const std::string& item)
 {
-    NS_LOG_FUNCTION(this << root);
+    m_workStack.push_back(m_resolvedPath.size());
+    m_resolvedPath += item;
+    m_resolvedPath += '/';
+}
 
-    DoResolve(m_path, root);
+void
+Resolver::Pop()
+{
+    m_resolvedPath.resize(m_workStack.back());
+    m_workStack.pop_back();
 }
 
-std::string
+const std::string&
 Resolver::GetResolvedPath() const
 {
-    NS_LOG_FUNCTION(this);
-
-    std::string fullPath = "/";
-    for (auto i = m_workStack.begin(); i != m_workStack.end(); i++)
-    {
-        fullPath += *i + "/";
-    }
-    return fullPath;
+    return m_resolvedPath;
 }
 
 void
@@ -440,13 +645,23 @@ Resolver::DoResolveOne(Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+Resolver::GetAttribute(Ptr<Object> object,
+                       const CompiledPath::Attribute& attribute,
+                       AttributeValue& value) const
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    if (!attribute.accessor || !attribute.accessor->Get(PeekPointer(object), value))
+    {
+        // Let ObjectBase::GetAttribute raise any errors
+        object->GetAttribute(attribute.name, value);
+    }
+}
+
+void
+Resolver::DoResolve(std::size_t i, Ptr<Object> root)
+{
+    NS_LOG_FUNCTION(this << i << root);
 
-    if (next == std::string::npos)
+    if (i == m_path->GetN())
     {
         //
         // If root is zero, we're beginning to see if we can use the object name
@@ -462,8 +677,8 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         }
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const CompiledPath::Element& element = m_path->Get(i);
+    const std::string& item = element.item;
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -472,16 +687,12 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     // the root of the "/Names" namespace, so we just ignore it and move on to
     // the next segment.
     //
-    if (!root)
+    if (!root && element.names)
     {
-        std::string::size_type offset = path.find("/Names");
-        if (offset == 0)
-        {
-            m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
-            m_workStack.pop_back();
-            return;
-        }
+        Push(item);
+        DoResolve(i + 1, root);
+        Pop();
+        return;
     }
 
     //
@@ -494,9 +705,9 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     if (namedObject)
     {
         NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
-        m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
-        m_workStack.pop_back();
+        Push(item);
+        DoResolve(i + 1, namedObject);
+        Pop();
         return;
     }
 
@@ -511,85 +722,61 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         return;
     }
-    std::string::size_type dollarPos = item.find('$');
-    if (dollarPos == 0)
+    if (element.getObject)
     {
         // This is a call to GetObject
-        std::string tidString = item.substr(1, item.size() - 1);
-        NS_LOG_DEBUG("GetObject=" << tidString << " on path=" << GetResolvedPath());
-        TypeId tid = TypeId::LookupByName(tidString);
+        NS_LOG_DEBUG("GetObject=" << item.substr(1) << " on path=" << GetResolvedPath());
+        TypeId tid = element.hasTid ? element.tid : TypeId::LookupByName(item.substr(1));
         Ptr<Object> object = root->GetObject<Object>(tid);
         if (!object)
         {
-            NS_LOG_DEBUG("GetObject (" << tidString << ") failed on path=" << GetResolvedPath());
+            NS_LOG_DEBUG("GetObject (" << item.substr(1)
+                                       << ") failed on path=" << GetResolvedPath());
             return;
         }
-        m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
-        m_workStack.pop_back();
+        Push(item);
+        DoResolve(i + 1, object);
+        Pop();
     }
     else
     {
         // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
         bool foundMatch = false;
 
-        do
+        for (const auto& attribute : m_path->GetAttributes(i, root->GetInstanceTypeId()))
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            if (!attribute.container)
             {
-                TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
+                NS_LOG_DEBUG("GetAttribute(ptr)=" << attribute.name
+                                                  << " on path=" << GetResolvedPath());
+                PointerValue pValue;
+                GetAttribute(root, attribute, pValue);
+                Ptr<Object> object = pValue.Get<Object>();
+                if (!object)
                 {
+                    NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
+                                                            << GetResolvedPath()
+                                                            << "\""
+                                                               " but is null.");
                     continue;
                 }
-                // attempt to cast to a pointer checker.
-                const auto pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
-                    root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
-                }
-                // attempt to cast to an object vector.
-                const auto vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
-                }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
+                foundMatch = true;
+                Push(attribute.name);
+                DoResolve(i + 1, object);
+                Pop();
             }
-
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
+            else
+            {
+                NS_LOG_DEBUG("GetAttribute(vector)=" << attribute.name
+                                                     << " on path=" << GetResolvedPath());
+                foundMatch = true;
+                ObjectPtrContainerValue vector;
+                GetAttribute(root, attribute, vector);
+                Push(attribute.name);
+                DoArrayResolve(i + 1, vector);
+                Pop();
+            }
+        }
 
         if (!foundMatch)
         {
@@ -601,30 +788,23 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+Resolver::DoArrayResolve(std::size_t i, const ObjectPtrContainerValue& container)
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << i << &container);
+    if (i == m_path->GetN())
     {
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
 
-    ArrayMatcher matcher = ArrayMatcher(item);
+    const ArrayMatcher& matcher = m_path->Get(i).matcher;
     ObjectPtrContainerValue::Iterator it;
     for (it = container.Begin(); it != container.End(); ++it)
     {
         if (matcher.Matches((*it).first))
         {
-            std::ostringstream oss;
-            oss << (*it).first;
-            m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
-            m_workStack.pop_back();
+            Push(std::to_string((*it).first));
+            DoResolve(i + 1, (*it).second);
+            Pop();
         }
     }
 }
@@ -642,10 +822,10 @@ class ConfigImpl : public Singleton<ConfigImpl>
     void Set(std::string path, const AttributeValue& value);
     /** \copydoc ns3::Config::SetFailSafe() */
     bool SetFailSafe(std::string path, const AttributeValue& value);
-    /** \copydoc ns3::Config::ConnectWithoutContextFailSafe() */
-    bool ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb);
-    /** \copydoc ns3::Config::ConnectFailSafe() */
-    bool ConnectFailSafe(std::string path, const CallbackBase& cb);
+    /** \copydoc ns3::Config::ConnectWithoutContextAll() */
+    std::size_t ConnectWithoutContextAll(std::string path, const CallbackBase& cb);
+    /** \copydoc ns3::Config::ConnectAll() */
+    std::size_t ConnectAll(std::string path, const CallbackBase& cb);
     /** \copydoc ns3::Config::DisconnectWithoutContext() */
     void DisconnectWithoutContext(std::string path, const CallbackBase& cb);
     /** \copydoc ns3::Config::Disconnect() */
@@ -664,6 +844,12 @@ class ConfigImpl : public Singleton<ConfigImpl>
     Ptr<Object> GetRootNamespaceObject(std::size_t i) const;
 
   private:
+    /**
+     * Action applied to the objects matching a Config path: the object and
+     * the matching Config path context.
+     */
+    typedef std::function<void(Ptr<Object>, const std::string&)> Action;
+
     /**
      * Break a Config path into the leading path and the last leaf token.
      * \param [in] path The Config path.
@@ -673,12 +859,50 @@ class ConfigImpl : public Singleton<ConfigImpl>
      */
     void ParsePath(std::string path, std::string* root, std::string* leaf) const;
 
+    /**
+     * Get the compiled form of a Config path, compiling it on first use.
+     * \param [in] path The Config path.
+     * \returns The compiled Config path.
+     */
+    Ptr<CompiledPath> Compile(const std::string& path);
+
+    /**
+     * Resolve a Config path and apply an action to each matching object,
+     * in a single pass over the matching objects.
+     * \param [in] path The Config path.
+     * \param [in] action The action.
+     */
+    void Resolve(const std::string& path, const Action& action);
+
+    /**
+     * Find a trace source of a TypeId, searching it on the first call
+     * for the TypeId and the trace source name.
+     * \param [in] tid The TypeId.
+     * \param [in] name The name of the trace source.
+     * \returns The trace source accessor, or null if there is no such
+     *   trace source.
+     */
+    Ptr<const TraceSourceAccessor> LookupTraceSource(TypeId tid, const std::string& name);
+
     /** Container type to hold the root Config path tokens. */
     typedef std::vector<Ptr<Object>> Roots;
 
     /** The list of Config path roots. */
     Roots m_roots;
 
+    /**
+     * The maximum number of compiled Config paths kept: the paths built
+     * with the indices of the objects (e.g., "/NodeList/12/...") are
+     * discarded when the limit is reached.
+     */
+    static constexpr std::size_t MAX_COMPILED_PATHS = 1024;
+
+    /** The compiled Config paths, indexed by Config path. */
+    std::unordered_map<std::string, Ptr<CompiledPath>> m_compiledPaths;
+
+    /** The trace source accessors, indexed by TypeId uid and trace source name. */
+    std::map<std::pair<uint16_t, std::string>, Ptr<const TraceSourceAccessor>> m_traceSources;
+
 }; // class ConfigImpl
 
 void
@@ -693,6 +917,72 @@ ConfigImpl::ParsePath(std::string path, std::string* root, std::string* leaf) co
     NS_LOG_FUNCTION(path << *root << *leaf);
 }
 
+Ptr<CompiledPath>
+ConfigImpl::Compile(const std::string& path)
+{
+    auto it = m_compiledPaths.find(path);
+    if (it != m_compiledPaths.end())
+    {
+        return it->second;
+    }
+    NS_LOG_FUNCTION(this << path);
+    if (m_compiledPaths.size() >= MAX_COMPILED_PATHS)
+    {
+        m_compiledPaths.clear();
+    }
+    Ptr<CompiledPath> compiled = Create<CompiledPath>(path);
+    m_compiledPaths[path] = compiled;
+    return compiled;
+}
+
+void
+ConfigImpl::Resolve(const std::string& path, const Action& action)
+{
+    NS_LOG_FUNCTION(this << path);
+
+    class ActionResolver : public Resolver
+    {
+      public:
+        ActionResolver(Ptr<CompiledPath> path, const Action& action)
+            : Resolver(path),
+              m_action(action)
+        {
+        }
+
+        void DoOne(Ptr<Object> object, const std::string& path) override
+        {
+            m_action(object, path);
+        }
+
+        const Action& m_action;
+    } resolver = ActionResolver(Compile(path), action);
+
+    for (auto i = m_roots.begin(); i != m_roots.end(); i++)
+    {
+        resolver.Resolve(*i);
+    }
+
+    //
+    // See if we can do something with the object name service.  Starting with
+    // the root pointer zeroed indicates to the resolver that it should start
+    // looking at the root of the "/Names" namespace during this go.
+    //
+    resolver.Resolve(nullptr);
+}
+
+Ptr<const TraceSourceAccessor>
+ConfigImpl::LookupTraceSource(TypeId tid, const std::string& name)
+{
+    auto key = std::make_pair(tid.GetUid(), name);
+    auto it = m_traceSources.find(key);
+    if (it == m_traceSources.end())
+    {
+        NS_LOG_FUNCTION(this << tid.GetName() << name);
+        it = m_traceSources.emplace(key, tid.LookupTraceSourceByName(name)).first;
+    }
+    return it->second;
+}
+
 void
 ConfigImpl::Set(std::string path, const AttributeValue& value)
 {
@@ -701,8 +991,10 @@ ConfigImpl::Set(std::string path, const AttributeValue& value)
     std::string root;
     std::string leaf;
     ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    container.Set(leaf, value);
+    Resolve(root, [&leaf, &value](Ptr<Object> object, const std::string& /* context */) {
+        // Let ObjectBase::SetAttribute raise any errors
+        object->SetAttribute(leaf, value);
+    });
 }
 
 bool
@@ -713,19 +1005,30 @@ ConfigImpl::SetFailSafe(std::string path, const AttributeValue& value)
     std::string root;
     std::string leaf;
     ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    return container.SetFailSafe(leaf, value);
+    bool ok = false;
+    Resolve(root, [&leaf, &value, &ok](Ptr<Object> object, const std::string& /* context */) {
+        ok |= object->SetAttributeFailSafe(leaf, value);
+    });
+    return ok;
 }
 
-bool
-ConfigImpl::ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb)
+std::size_t
+ConfigImpl::ConnectWithoutContextAll(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(this << path << &cb);
     std::string root;
     std::string leaf;
     ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    return container.ConnectWithoutContextFailSafe(leaf, cb);
+    std::size_t n = 0;
+    Resolve(root, [this, &leaf, &cb, &n](Ptr<Object> object, const std::string& /* context */) {
+        Ptr<const TraceSourceAccessor> accessor =
+            LookupTraceSource(object->GetInstanceTypeId(), leaf);
+        if (accessor && accessor->ConnectWithoutContext(PeekPointer(object), cb))
+        {
+            n++;
+        }
+    });
+    return n;
 }
 
 void
@@ -746,16 +1049,24 @@ ConfigImpl::DisconnectWithoutContext(std::string path, const CallbackBase& cb)
     container.DisconnectWithoutContext(leaf, cb);
 }
 
-bool
-ConfigImpl::ConnectFailSafe(std::string path, const CallbackBase& cb)
+std::size_t
+ConfigImpl::ConnectAll(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(this << path << &cb);
 
     std::string root;
     std::string leaf;
     ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    return container.ConnectFailSafe(leaf, cb);
+    std::size_t n = 0;
+    Resolve(root, [this, &leaf, &cb, &n](Ptr<Object> object, const std::string& context) {
+        Ptr<const TraceSourceAccessor> accessor =
+            LookupTraceSource(object->GetInstanceTypeId(), leaf);
+        if (accessor && accessor->Connect(PeekPointer(object), context + leaf, cb))
+        {
+            n++;
+        }
+    });
+    return n;
 }
 
 void
@@ -782,37 +1093,14 @@ ConfigImpl::LookupMatches(std::string path)
 {
     NS_LOG_FUNCTION(this << path);
 
-    class LookupMatchesResolver : public Resolver
-    {
-      public:
-        LookupMatchesResolver(std::string path)
-            : Resolver(path)
-        {
-        }
+    std::vector<Ptr<Object>> objects;
+    std::vector<std::string> contexts;
+    Resolve(path, [&objects, &contexts](Ptr<Object> object, const std::string& context) {
+        objects.push_back(object);
+        contexts.push_back(context);
+    });
 
-        void DoOne(Ptr<Object> object, std::string path) override
-        {
-            m_objects.push_back(object);
-            m_contexts.push_back(path);
-        }
-
-        std::vector<Ptr<Object>> m_objects;
-        std::vector<std::string> m_contexts;
-    } resolver = LookupMatchesResolver(path);
-
-    for (auto i = m_roots.begin(); i != m_roots.end(); i++)
-    {
-        resolver.Resolve(*i);
-    }
-
-    //
-    // See if we can do something with the object name service.  Starting with
-    // the root pointer zeroed indicates to the resolver that it should start
-    // looking at the root of the "/Names" namespace during this go.
-    //
-    resolver.Resolve(nullptr);
-
-    return MatchContainer(resolver.m_objects, resolver.m_contexts, path);
+    return MatchContainer(objects, contexts, path);
 }
 
 void
@@ -960,7 +1248,14 @@ bool
 ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(path << &cb);
-    return ConfigImpl::Get()->ConnectWithoutContextFailSafe(path, cb);
+    return ConfigImpl::Get()->ConnectWithoutContextAll(path, cb) > 0;
+}
+
+std::size_t
+ConnectWithoutContextAll(std::string path, const CallbackBase& cb)
+{
+    NS_LOG_FUNCTION(path << &cb);
+    return ConfigImpl::Get()->ConnectWithoutContextAll(path, cb);
 }
 
 void
@@ -984,7 +1279,14 @@ bool
 ConnectFailSafe(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(path << &cb);
-    return ConfigImpl::Get()->ConnectFailSafe(path, cb);
+    return ConfigImpl::Get()->ConnectAll(path, cb) > 0;
+}
+
+std::size_t
+ConnectAll(std::string path, const CallbackBase& cb)
+{
+    NS_LOG_FUNCTION(path << &cb);
+    return ConfigImpl::Get()->ConnectAll(path, cb);
 }
 
 void
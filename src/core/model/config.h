@@ -140,6 +140,19 @@ void ConnectWithoutContext(std::string path, const CallbackBase& cb);
  * \returns \c true if any trace sources could be connected.
  */
 bool ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb);
+/**
+ * \ingroup config
+ * \param [in] path A path to match trace sources.
+ * \param [in] cb The callback to connect to the matching trace sources.
+ * \returns The number of trace sources the callback was connected to.
+ *
+ * This function connects the input callback to all the trace sources
+ * which match the input path, in a single pass over the matching objects:
+ * unlike LookupMatches() followed by
+ * MatchContainer::ConnectWithoutContext(), it does not store the matching
+ * objects nor their paths.  No error is raised if no trace source matches.
+ */
+std::size_t ConnectWithoutContextAll(std::string path, const CallbackBase& cb);
 /**
  * \ingroup config
  * \param [in] path A path to match trace sources.
@@ -174,6 +187,19 @@ void Connect(std::string path, const CallbackBase& cb);
  * \returns \c true if any trace sources could be connected.
  */
 bool ConnectFailSafe(std::string path, const CallbackBase& cb);
+/**
+ * \ingroup config
+ * \param [in] path A path to match trace sources.
+ * \param [in] cb The callback to connect to the matching trace sources.
+ * \returns The number of trace sources the callback was connected to.
+ *
+ * This function connects the input callback to all the trace sources
+ * which match the input path, in a single pass over the matching objects,
+ * in such a way that the callback will receive an extra context string
+ * upon trace event notification.  No error is raised if no trace source
+ * matches.
+ */
+std::size_t ConnectAll(std::string path, const CallbackBase& cb);
 /**
  * \ingroup config
  * \param [in] path A path to match trace sources.
@@ -19,12 +19,16 @@
 
 #include "default-simulator-impl.h"
 
+#include "abort.h"
 #include "assert.h"
+#include "enum.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
 
 #include <cmath>
+#include <fstream>
 
 /**
  * \file
@@ -42,13 +46,117 @@ NS_LOG_COMPONENT_DEFINE("DefaultSimulatorImpl");
 
 NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 
+/**
+ * \ingroup simulator
+ * Recycler of the wrappers of the events scheduled from a thread other than
+ * the main thread, so that no memory is allocated per event once enough
+ * wrappers are in circulation.
+ *
+ * The main thread returns the wrappers of the events it moved to the event
+ * queue to a lock-free free list shared by all the simulator instances. A
+ * thread scheduling events takes wrappers from a cache of its own and, when
+ * the cache is empty, moves the whole shared free list to its cache. Since
+ * wrappers are only pushed to (and never popped one at a time from) the
+ * shared free list, the list is immune to the ABA problem.
+ */
+class DefaultSimulatorImpl::EventWithContextPool
+{
+  public:
+    /**
+     * \return a wrapper for an event scheduled from the calling thread
+     */
+    static EventWithContext* Allocate();
+    /**
+     * Return a list of wrappers to the shared free list.
+     *
+     * \param [in] first The first wrapper of the list.
+     * \param [in] last The last wrapper of the list.
+     */
+    static void Release(EventWithContext* first, EventWithContext* last);
+
+  private:
+    /** Wrappers cached by a thread, deleted when the thread exits. */
+    struct Cache
+    {
+        /** Destructor. */
+        ~Cache();
+        /** The first cached wrapper. */
+        EventWithContext* head{nullptr};
+    };
+
+    /** The shared free list. */
+    static std::atomic<EventWithContext*> m_freeList;
+    /** The cache of the calling thread. */
+    static thread_local Cache m_cache;
+};
+
+std::atomic<DefaultSimulatorImpl::EventWithContext*>
+    DefaultSimulatorImpl::EventWithContextPool::m_freeList{nullptr};
+thread_local DefaultSimulatorImpl::EventWithContextPool::Cache
+    DefaultSimulatorImpl::EventWithContextPool::m_cache;
+
+DefaultSimulatorImpl::EventWithContextPool::Cache::~Cache()
+{
+    while (head != nullptr)
+    {
+        auto next = head->next;
+        delete head;
+        head = next;
+    }
+}
+
+DefaultSimulatorImpl::EventWithContext*
+DefaultSimulatorImpl::EventWithContextPool::Allocate()
+{
+    auto& cache = m_cache;
+    if (cache.head == nullptr)
+    {
+        cache.head = m_freeList.exchange(nullptr, std::memory_order_acquire);
+        if (cache.head == nullptr)
+        {
+            return new EventWithContext;
+        }
+    }
+    auto wrapper = cache.head;
+    cache.head = wrapper->next;
+    return wrapper;
+}
+
+void
+DefaultSimulatorImpl::EventWithContextPool::Release(EventWithContext* first, EventWithContext* last)
+{
+    last->next = m_freeList.load(std::memory_order_relaxed);
+    while (!m_freeList.compare_exchange_weak(last->next,
+                                             first,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed))
+    {
+    }
+}
+
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
     static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
                             .SetParent<SimulatorImpl>()
                             .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+                            .AddConstructor<DefaultSimulatorImpl>()
+                            .AddAttribute("ProfileFile",
+                                          "The name of the file the event profile is written to "
+                                          "at Simulator::Destroy(), in the folded stack format "
+                                          "of the flame graphs. If empty, the events are not "
+                                          "profiled.",
+                                          StringValue(""),
+                                          MakeStringAccessor(&DefaultSimulatorImpl::m_profileFile),
+                                          MakeStringChecker())
+                            .AddAttribute("ProfileWeight",
+                                          "The weight of the stacks of the event profile.",
+                                          EnumValue(EventProfiler::WALL_TIME),
+                                          MakeEnumAccessor(&DefaultSimulatorImpl::m_profileWeight),
+                                          MakeEnumChecker(EventProfiler::WALL_TIME,
+                                                          "WallTime",
+                                                          EventProfiler::EVENT_COUNT,
+                                                          "EventCount"));
     return tid;
 }
 
@@ -62,7 +170,7 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
-    m_eventsWithContextEmpty = true;
+    m_eventsWithContext = nullptr;
     m_mainThreadId = std::this_thread::get_id();
 }
 
@@ -100,6 +208,15 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+
+    if (m_profiler)
+    {
+        NS_LOG_LOGIC("write event profile to " << m_profileFile);
+        std::ofstream os(m_profileFile);
+        NS_ABORT_MSG_UNLESS(os.is_open(), "Cannot open the event profile file " << m_profileFile);
+        m_profiler->Write(os, m_profileWeight);
+        m_profiler->Clear();
+    }
 }
 
 void
@@ -141,7 +258,16 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiler)
+    {
+        auto start = EventProfiler::Clock::now();
+        next.impl->Invoke();
+        m_profiler->Record(*next.impl, next.key.m_context, EventProfiler::Clock::now() - start);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -156,31 +282,35 @@ DefaultSimulatorImpl::IsFinished() const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext()
 {
-    if (m_eventsWithContextEmpty)
+    if (m_eventsWithContext.load(std::memory_order_relaxed) == nullptr)
     {
         return;
     }
 
-    // swap queues
-    EventsWithContext eventsWithContext;
+    // take all the events at once and reverse the list, which is in LIFO order
+    EventWithContext* event = m_eventsWithContext.exchange(nullptr, std::memory_order_acquire);
+    EventWithContext* first = nullptr;
+    EventWithContext* last = event;
+    while (event != nullptr)
     {
-        std::unique_lock lock{m_eventsWithContextMutex};
-        m_eventsWithContext.swap(eventsWithContext);
-        m_eventsWithContextEmpty = true;
+        EventWithContext* next = event->next;
+        event->next = first;
+        first = event;
+        event = next;
     }
-    while (!eventsWithContext.empty())
+
+    for (event = first; event != nullptr; event = event->next)
     {
-        EventWithContext event = eventsWithContext.front();
-        eventsWithContext.pop_front();
         Scheduler::Event ev;
-        ev.impl = event.event;
-        ev.key.m_ts = m_currentTs + event.timestamp;
-        ev.key.m_context = event.context;
+        ev.impl = event->event;
+        ev.key.m_ts = m_currentTs + event->timestamp;
+        ev.key.m_context = event->context;
         ev.key.m_uid = m_uid;
         m_uid++;
         m_unscheduledEvents++;
         m_events->Insert(ev);
     }
+    EventWithContextPool::Release(first, last);
 }
 
 void
@@ -189,6 +319,10 @@ DefaultSimulatorImpl::Run()
     NS_LOG_FUNCTION(this);
     // Set the current threadId as the main threadId
     m_mainThreadId = std::this_thread::get_id();
+    if (!m_profileFile.empty() && !m_profiler)
+    {
+        m_profiler = std::make_unique<EventProfiler>();
+    }
     ProcessEventsWithContext();
     m_stop = false;
 
@@ -259,15 +393,17 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
     }
     else
     {
-        EventWithContext ev;
-        ev.context = context;
+        EventWithContext* ev = EventWithContextPool::Allocate();
+        ev->context = context;
         // Current time added in ProcessEventsWithContext()
-        ev.timestamp = delay.GetTimeStep();
-        ev.event = event;
+        ev->timestamp = delay.GetTimeStep();
+        ev->event = event;
+        ev->next = m_eventsWithContext.load(std::memory_order_relaxed);
+        while (!m_eventsWithContext.compare_exchange_weak(ev->next,
+                                                          ev,
+                                                          std::memory_order_release,
+                                                          std::memory_order_relaxed))
         {
-            std::unique_lock lock{m_eventsWithContextMutex};
-            m_eventsWithContext.push_back(ev);
-            m_eventsWithContextEmpty = false;
         }
     }
 }
@@ -391,6 +527,12 @@ DefaultSimulatorImpl::GetContext() const
     return m_currentContext;
 }
 
+void
+DefaultSimulatorImpl::SetContext(uint32_t context)
+{
+    m_currentContext = context;
+}
+
 uint64_t
 DefaultSimulatorImpl::GetEventCount() const
 {
@@ -20,10 +20,12 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "event-profiler.h"
 #include "simulator-impl.h"
 
+#include <atomic>
 #include <list>
-#include <mutex>
+#include <memory>
 #include <thread>
 
 /**
@@ -42,6 +44,11 @@ class Scheduler;
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * If the ProfileFile attribute is set, the event count and the wall clock
+ * time spent executing the events are attributed to the event types and to
+ * the contexts by an EventProfiler, and written to the given file in the
+ * folded stack format at Simulator::Destroy().
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -76,6 +83,7 @@ class DefaultSimulatorImpl : public SimulatorImpl
     void SetScheduler(ObjectFactory schedulerFactory) override;
     uint32_t GetSystemId() const override;
     uint32_t GetContext() const override;
+    void SetContext(uint32_t context) override;
     uint64_t GetEventCount() const override;
 
   private:
@@ -95,19 +103,19 @@ class DefaultSimulatorImpl : public SimulatorImpl
         uint64_t timestamp;
         /** The event implementation. */
         EventImpl* event;
+        /** The next event in the list of events from a different context. */
+        EventWithContext* next;
     };
 
-    /** Container type for the events from a different context. */
-    typedef std::list<EventWithContext> EventsWithContext;
-    /** The container of events from a different context. */
-    EventsWithContext m_eventsWithContext;
+    /** Recycler of the EventWithContext wrappers. */
+    class EventWithContextPool;
+
     /**
-     * Flag \c true if all events with context have been moved to the
-     * primary event queue.
+     * Lock-free stack of the events from a different context, most recent
+     * event first. Other threads push events with a compare-and-swap, while
+     * the main thread takes all of them at once in ProcessEventsWithContext().
      */
-    bool m_eventsWithContextEmpty;
-    /** Mutex to control access to the list of events with context. */
-    std::mutex m_eventsWithContextMutex;
+    std::atomic<EventWithContext*> m_eventsWithContext;
 
     /** Container type for the events to run at Simulator::Destroy() */
     typedef std::list<EventId> DestroyEvents;
@@ -136,6 +144,13 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** The name of the file the event profile is written to (empty to disable profiling). */
+    std::string m_profileFile;
+    /** The weight of the stacks of the event profile. */
+    EventProfiler::Weight m_profileWeight;
+    /** The event profiler, if profiling is enabled. */
+    std::unique_ptr<EventProfiler> m_profiler;
 };
 
 } // namespace ns3
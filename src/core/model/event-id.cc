@@ -51,10 +51,24 @@ EventId::EventId(const Ptr<EventImpl>& impl, uint64_t ts, uint32_t context, uint
     NS_LOG_FUNCTION(this << impl << ts << context << uid);
 }
 
+EventId::EventId(EventImpl* impl, uint64_t ts, uint32_t context, uint32_t uid)
+    : m_eventImpl(impl),
+      m_ts(ts),
+      m_context(context),
+      m_uid(uid)
+{
+    NS_LOG_FUNCTION(this << impl << ts << context << uid);
+}
+
 void
 EventId::Cancel()
 {
     NS_LOG_FUNCTION(this);
+    if (!m_eventImpl || m_eventImpl->IsCancelled())
+    {
+        // nothing to cancel: avoid the lookup of the simulator implementation
+        return;
+    }
     Simulator::Cancel(*this);
 }
 
@@ -80,6 +80,16 @@ class EventId
      * \param [in] uid The unique id for this EventId.
      */
     EventId(const Ptr<EventImpl>& impl, uint64_t ts, uint32_t context, uint32_t uid);
+    /**
+     * Construct a real event from the raw pointer held by the event list,
+     * without creating a temporary Ptr.
+     *
+     * \param [in] impl The implementation of this event.
+     * \param [in] ts The virtual time stamp this event should occur.
+     * \param [in] context The execution context for this event.
+     * \param [in] uid The unique id for this EventId.
+     */
+    EventId(EventImpl* impl, uint64_t ts, uint32_t context, uint32_t uid);
     /**
      * This method is syntactic sugar for the ns3::Simulator::Cancel
      * method.
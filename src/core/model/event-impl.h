@@ -19,6 +19,7 @@
 #ifndef EVENT_IMPL_H
 #define EVENT_IMPL_H
 
+#include "pool-allocator.h"
 #include "simple-ref-count.h"
 
 #include <stdint.h>
@@ -41,8 +42,13 @@ namespace ns3
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * Events are allocated through the PoolAllocator: the storage of an event
+ * (including the arguments bound by MakeEvent(), which are members of the
+ * subclass) is recycled for a later event of the same size once the event
+ * has been invoked or removed from the event list.
  */
-class EventImpl : public SimpleRefCount<EventImpl>
+class EventImpl : public SimpleRefCount<EventImpl>, public PoolAllocated
 {
   public:
     /** Default constructor. */
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+
+#include "event-impl.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+void
+EventProfiler::Record(const EventImpl& event, uint32_t context, Clock::duration elapsed)
+{
+    Stats& stats = m_stats[std::type_index(typeid(event))][context];
+    stats.count++;
+    stats.elapsed += elapsed;
+}
+
+void
+EventProfiler::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_stats.clear();
+}
+
+std::string
+EventProfiler::GetTypeName(const std::type_index& type)
+{
+    std::string name = type.name();
+#if (__GNUC__ >= 3)
+    int status;
+    char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (status == 0)
+    {
+        name = demangled;
+    }
+    std::free(demangled);
+#endif
+
+    // the events created by MakeEvent() are instances of classes local to
+    // MakeEvent(): name them after the template arguments or the parameters
+    // of MakeEvent(), i.e., the bound function and its arguments
+    const std::string prefix = "ns3::MakeEvent";
+    if (name.compare(0, prefix.size(), prefix) == 0 && name.size() > prefix.size())
+    {
+        char open = name[prefix.size()];
+        char close = (open == '<') ? '>' : ')';
+        int depth = 1;
+        std::size_t end = prefix.size() + 1;
+        for (; end < name.size() && depth > 0; end++)
+        {
+            depth += (name[end] == open) - (name[end] == close);
+        }
+        if ((open == '<' || open == '(') && depth == 0)
+        {
+            name = name.substr(prefix.size() + 1, end - prefix.size() - 2);
+        }
+    }
+
+    // semicolons separate the frames of the folded stacks
+    std::replace(name.begin(), name.end(), ';', ',');
+    return name;
+}
+
+void
+EventProfiler::Write(std::ostream& os, Weight weight) const
+{
+    NS_LOG_FUNCTION(this << &os << weight);
+    std::vector<std::tuple<uint64_t, std::string, uint32_t>> lines;
+    for (const auto& [type, contexts] : m_stats)
+    {
+        std::string name = GetTypeName(type);
+        for (const auto& [context, stats] : contexts)
+        {
+            uint64_t value =
+                (weight == EVENT_COUNT)
+                    ? stats.count
+                    : std::chrono::duration_cast<std::chrono::nanoseconds>(stats.elapsed).count();
+            lines.emplace_back(value, name, context);
+        }
+    }
+    // decreasing weight first, then increasing type name and context
+    std::sort(lines.begin(), lines.end(), [](const auto& a, const auto& b) {
+        return std::tie(std::get<0>(b), std::get<1>(a), std::get<2>(a)) <
+               std::tie(std::get<0>(a), std::get<1>(b), std::get<2>(b));
+    });
+
+    for (const auto& [value, name, context] : lines)
+    {
+        os << name << ";";
+        if (context == Simulator::NO_CONTEXT)
+        {
+            os << "no context";
+        }
+        else
+        {
+            os << "node " << context;
+        }
+        os << " " << value << std::endl;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <chrono>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Attribute the event count and the wall clock time spent executing
+ * the events to the event types and to the execution contexts.
+ *
+ * The type of an event is the dynamic type of its EventImpl, i.e., for the
+ * events created by MakeEvent() (hence by the Simulator::Schedule*()
+ * methods), the type of the bound function and of its arguments. Unlike
+ * DesMetrics, which traces the scheduling of the events, the profiler
+ * measures the execution of the events.
+ *
+ * The results are written in the folded stack format read by the flame
+ * graph tools (e.g., `flamegraph.pl`): each line holds a stack of two
+ * frames, the event type and the context (node), separated by a semicolon,
+ * followed by the weight of the stack, i.e., the number of events or the
+ * wall clock time in nanoseconds.
+ *
+ * The DefaultSimulatorImpl profiles the events when its ProfileFile
+ * attribute is set, and writes the results at Simulator::Destroy().
+ */
+class EventProfiler
+{
+  public:
+    /** The weight of the stacks written by Write(). */
+    enum Weight
+    {
+        WALL_TIME,  //!< The wall clock time spent executing the events, in nanoseconds.
+        EVENT_COUNT //!< The number of events executed.
+    };
+
+    /** The clock measuring the execution time of the events. */
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * Record the execution of an event.
+     *
+     * \param [in] event The event.
+     * \param [in] context The execution context of the event.
+     * \param [in] elapsed The wall clock time spent executing the event.
+     */
+    void Record(const EventImpl& event, uint32_t context, Clock::duration elapsed);
+
+    /**
+     * Write the results in the folded stack format, one line per event type
+     * and context, in decreasing order of weight.
+     *
+     * \param [in,out] os The output stream.
+     * \param [in] weight The weight of the stacks.
+     */
+    void Write(std::ostream& os, Weight weight) const;
+
+    /** Discard the results. */
+    void Clear();
+
+    /**
+     * \param [in] type The dynamic type of an event.
+     * \return The name of the event type, as written by Write().
+     */
+    static std::string GetTypeName(const std::type_index& type);
+
+  private:
+    /** The statistics of an event type in a context. */
+    struct Stats
+    {
+        uint64_t count{0};         //!< The number of events executed.
+        Clock::duration elapsed{}; //!< The wall clock time spent executing the events.
+    };
+
+    /** The statistics of an event type, indexed by context. */
+    typedef std::unordered_map<uint32_t, Stats> ContextStats;
+
+    /** The statistics, indexed by event type. */
+    std::unordered_map<std::type_index, ContextStats> m_stats;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
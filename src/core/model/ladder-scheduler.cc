@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+namespace
+{
+
+/**
+ * Ordering of the events in the bottom, which is sorted in decreasing order
+ * so that the earliest event is removed from the back of the vector.
+ *
+ * \param [in] a The first event.
+ * \param [in] b The second event.
+ * \returns \c true if \p a is later than \p b.
+ */
+inline bool
+IsLater(const Scheduler::Event& a, const Scheduler::Event& b)
+{
+    return b.key < a.key;
+}
+
+} // namespace
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LadderScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<LadderScheduler>();
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topStart(0),
+      m_topMin(std::numeric_limits<uint64_t>::max()),
+      m_topMax(0),
+      m_rungs(MAX_RUNGS),
+      m_nRungs(0),
+      m_size(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+LadderScheduler::Rung::GetCurrentStart() const
+{
+    return start + current * width;
+}
+
+std::size_t
+LadderScheduler::Rung::GetBucket(uint64_t ts) const
+{
+    std::size_t bucket = (ts - start) / width;
+    NS_ASSERT(bucket < nBuckets);
+    return bucket;
+}
+
+void
+LadderScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    m_size++;
+    uint64_t ts = ev.key.m_ts;
+
+    if (ts >= m_topStart)
+    {
+        m_top.push_back(ev);
+        m_topMin = std::min(m_topMin, ts);
+        m_topMax = std::max(m_topMax, ts);
+        return;
+    }
+
+    for (std::size_t i = 0; i < m_nRungs; i++)
+    {
+        Rung& rung = m_rungs[i];
+        if (ts >= rung.GetCurrentStart())
+        {
+            rung.buckets[rung.GetBucket(ts)].push_back(ev);
+            rung.nEvents++;
+            return;
+        }
+    }
+
+    InsertIntoBottom(ev);
+
+    if (m_bottom.size() > THRESHOLD && m_nRungs < MAX_RUNGS &&
+        m_bottom.front().key.m_ts != m_bottom.back().key.m_ts)
+    {
+        // the bottom is too large to keep it sorted: spread its events over a new rung
+        // covering the time span up to the start of the current bucket of the last rung
+        uint64_t end = (m_nRungs > 0) ? m_rungs[m_nRungs - 1].GetCurrentStart() : m_topStart;
+        uint64_t start = m_bottom.back().key.m_ts;
+        NS_LOG_LOGIC("bottom overflow, new rung from " << start << " to " << end);
+        SpawnRung(m_bottom, start, end - start);
+    }
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    // refilling the bottom does not change the set of events in the queue
+    const_cast<LadderScheduler*>(this)->FillBottom();
+    return m_bottom.back();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    FillBottom();
+    Scheduler::Event ev = m_bottom.back();
+    m_bottom.pop_back();
+    m_size--;
+    NS_LOG_LOGIC("remove ts=" << ev.key.m_ts << ", key=" << ev.key.m_uid);
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(!IsEmpty());
+    uint64_t ts = ev.key.m_ts;
+    auto sameUid = [&ev](const Event& e) { return e.key.m_uid == ev.key.m_uid; };
+
+    // remove from an unsorted vector by swapping with the last element
+    auto removeUnsorted = [&](std::vector<Event>& events) {
+        auto it = std::find_if(events.begin(), events.end(), sameUid);
+        NS_ASSERT(it != events.end());
+        NS_ASSERT(ev.impl == it->impl);
+        *it = events.back();
+        events.pop_back();
+    };
+
+    m_size--;
+
+    if (ts >= m_topStart)
+    {
+        removeUnsorted(m_top);
+        return;
+    }
+
+    for (std::size_t i = 0; i < m_nRungs; i++)
+    {
+        Rung& rung = m_rungs[i];
+        if (ts >= rung.GetCurrentStart())
+        {
+            removeUnsorted(rung.buckets[rung.GetBucket(ts)]);
+            rung.nEvents--;
+            return;
+        }
+    }
+
+    auto it = std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, IsLater);
+    NS_ASSERT(it != m_bottom.end() && it->key.m_uid == ev.key.m_uid);
+    NS_ASSERT(ev.impl == it->impl);
+    m_bottom.erase(it);
+}
+
+void
+LadderScheduler::SpawnRung(std::vector<Event>& events, uint64_t start, uint64_t span)
+{
+    NS_LOG_FUNCTION(this << events.size() << start << span);
+    NS_ASSERT(m_nRungs < MAX_RUNGS);
+    NS_ASSERT(span > 0);
+
+    Rung& rung = m_rungs[m_nRungs++];
+    uint64_t n = std::min(events.size(), MAX_BUCKETS);
+    rung.width = (span + n - 1) / n;
+    rung.nBuckets = (span + rung.width - 1) / rung.width;
+    if (rung.buckets.size() < rung.nBuckets)
+    {
+        rung.buckets.resize(rung.nBuckets);
+    }
+    rung.current = 0;
+    rung.start = start;
+    rung.nEvents = events.size();
+
+    for (const auto& ev : events)
+    {
+        rung.buckets[rung.GetBucket(ev.key.m_ts)].push_back(ev);
+    }
+    events.clear();
+}
+
+void
+LadderScheduler::SortIntoBottom(std::vector<Event>& events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    NS_ASSERT(m_bottom.empty());
+    std::sort(events.begin(), events.end(), IsLater);
+    // swap the storage, so that the bucket reuses the (empty) storage of the bottom
+    m_bottom.swap(events);
+}
+
+void
+LadderScheduler::InsertIntoBottom(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.key.m_ts << ev.key.m_uid);
+    m_bottom.insert(std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, IsLater), ev);
+}
+
+void
+LadderScheduler::FillBottom()
+{
+    NS_LOG_FUNCTION(this);
+
+    while (m_bottom.empty())
+    {
+        // drop the exhausted rungs
+        while (m_nRungs > 0 && m_rungs[m_nRungs - 1].nEvents == 0)
+        {
+            m_nRungs--;
+        }
+
+        if (m_nRungs == 0)
+        {
+            if (m_top.empty())
+            {
+                return;
+            }
+            // transfer the top to the first rung (or directly to the bottom, if small)
+            uint64_t start = m_topMin;
+            uint64_t span = m_topMax - m_topMin + 1;
+            m_topStart = m_topMax + 1;
+            m_topMin = std::numeric_limits<uint64_t>::max();
+            m_topMax = 0;
+            NS_LOG_LOGIC("transfer " << m_top.size() << " events from top, new top start "
+                                     << m_topStart);
+            if (m_top.size() <= THRESHOLD)
+            {
+                SortIntoBottom(m_top);
+            }
+            else
+            {
+                SpawnRung(m_top, start, span);
+            }
+            continue;
+        }
+
+        Rung& rung = m_rungs[m_nRungs - 1];
+        while (rung.buckets[rung.current].empty())
+        {
+            rung.current++;
+            NS_ASSERT(rung.current < rung.nBuckets);
+        }
+        Bucket& bucket = rung.buckets[rung.current];
+        uint64_t bucketStart = rung.GetCurrentStart();
+        rung.current++;
+        rung.nEvents -= bucket.size();
+
+        if (bucket.size() > THRESHOLD && rung.width > 1 && m_nRungs < MAX_RUNGS)
+        {
+            NS_LOG_LOGIC("spawn rung from bucket with " << bucket.size() << " events");
+            SpawnRung(bucket, bucketStart, rung.width);
+        }
+        else
+        {
+            SortIntoBottom(bucket);
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue described in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale Discrete
+ * Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and Ian Li-Jin
+ * Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * Events are stored in three tiers:
+ *  - the \em top, an unsorted `std::vector` holding the events scheduled
+ *    at or after a given time (the far future);
+ *  - the \em rungs, each one an array of buckets covering a uniform time
+ *    span.  The first rung is created by distributing the events of the top
+ *    over as many buckets as events; when the bucket to dequeue from holds
+ *    more than THRESHOLD events, its events are spread over a new, finer
+ *    rung, up to MAX_RUNGS rungs.  Buckets are unsorted `std::vector`s;
+ *  - the \em bottom, a sorted `std::vector` holding the events of the bucket
+ *    being dequeued (the near future), from which events are removed.
+ *
+ * Unlike the CalendarScheduler, the ladder queue never needs to be resized:
+ * the bucket width of a rung is derived from the events it is created from,
+ * which makes it robust to bursty event distributions such as those of
+ * Wi-Fi simulations (many events a few microseconds apart, mixed with
+ * timers of tens of milliseconds).  Insertion in the top or in a rung is
+ * a `push_back`, and events are only sorted when they reach the bottom, in
+ * batches of at most THRESHOLD events (except when MAX_RUNGS rungs are in
+ * use or all the events of a bucket share the same timestamp).  The bucket
+ * vectors of the rungs are reused, so that no memory is allocated once the
+ * scheduler has reached a steady state.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to top or rung bucket; sorted insertion in bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | ~Constant       | Possible transfer to bottom
+ * Remove()     | Linear          | Search within top, bucket or bottom
+ * RemoveNext() | ~Constant       | Possible transfer to bottom
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | MAX_RUNGS x rung<br/>(~1 kB)     | Rungs and their bucket arrays
+ * Per Event | 0                                | Events stored in `std::vector`s directly
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+    /** Maximum number of events of a bucket that are sorted into the bottom. */
+    static constexpr std::size_t THRESHOLD = 50;
+    /** Maximum number of rungs. */
+    static constexpr std::size_t MAX_RUNGS = 8;
+    /** Maximum number of buckets of a rung. */
+    static constexpr std::size_t MAX_BUCKETS = 65536;
+
+  private:
+    /** A bucket: an unsorted vector of Events. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** A rung of the ladder. */
+    struct Rung
+    {
+        std::vector<Bucket> buckets; //!< Buckets (only the first nBuckets are in use).
+        std::size_t nBuckets{0};     //!< Number of buckets in use.
+        std::size_t current{0};      //!< Index of the first bucket not yet dequeued.
+        uint64_t start{0};           //!< Timestamp of the start of the first bucket.
+        uint64_t width{1};           //!< Duration of a bucket, in dimensionless time units.
+        std::size_t nEvents{0};      //!< Number of events in the rung.
+
+        /**
+         * \returns The timestamp of the start of the current bucket.
+         */
+        uint64_t GetCurrentStart() const;
+        /**
+         * \param [in] ts The timestamp of an event within the range of this rung.
+         * \returns The index of the bucket the event belongs to.
+         */
+        std::size_t GetBucket(uint64_t ts) const;
+    };
+
+    /**
+     * Create a new rung, below the existing ones, covering the given time span
+     * and move the given events into it.
+     *
+     * \param [in,out] events The events to move, which are removed from the vector.
+     * \param [in] start The start of the time span covered by the new rung.
+     * \param [in] span The duration of the time span covered by the new rung.
+     */
+    void SpawnRung(std::vector<Scheduler::Event>& events, uint64_t start, uint64_t span);
+    /**
+     * Sort the given events and append them to the (empty) bottom.
+     *
+     * \param [in,out] events The events to move, which are removed from the vector.
+     */
+    void SortIntoBottom(std::vector<Scheduler::Event>& events);
+    /**
+     * Insert an event in the bottom, which is kept sorted.
+     *
+     * \param [in] ev The event to insert.
+     */
+    void InsertIntoBottom(const Scheduler::Event& ev);
+    /**
+     * Refill the bottom with the earliest events, if the bottom is empty.
+     */
+    void FillBottom();
+
+    std::vector<Scheduler::Event> m_top; //!< Events scheduled at or after m_topStart.
+    uint64_t m_topStart;                 //!< Smallest timestamp of the events in the top.
+    uint64_t m_topMin;                   //!< Minimum timestamp of the events in the top.
+    uint64_t m_topMax;                   //!< Maximum timestamp of the events in the top.
+
+    std::vector<Rung> m_rungs; //!< Rungs (only the first m_nRungs are in use), coarsest first.
+    std::size_t m_nRungs;      //!< Number of rungs in use.
+
+    /** Events in the near future, sorted in decreasing order. */
+    std::vector<Scheduler::Event> m_bottom;
+
+    uint32_t m_size; //!< Number of events in the queue.
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
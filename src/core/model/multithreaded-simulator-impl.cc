@@ -0,0 +1,754 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "abort.h"
+#include "assert.h"
+#include "log.h"
+#include "scheduler.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+namespace
+{
+
+/// Value of g_partition for the threads not executing a partition
+constexpr uint32_t NO_PARTITION = std::numeric_limits<uint32_t>::max();
+
+/// Index of the partition executed by the calling thread
+thread_local uint32_t g_partition = NO_PARTITION;
+
+/// Whether the calling thread executes a partition while other threads execute the others
+thread_local bool g_parallel = false;
+
+} // unnamed namespace
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("ThreadCount",
+                          "The number of partitions, each one executed by its own thread, "
+                          "used by the next call to Simulator::Run() (0 for one partition "
+                          "per hardware thread).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_threadCount),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Lookahead",
+                          "The minimum delay of the events scheduled for a context of another "
+                          "partition, e.g., the minimum delay of the channels connecting the "
+                          "nodes. If zero, all the events are executed by the main thread.",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::m_lookahead),
+                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_partitions(1),
+      m_threadCount(0),
+      m_lookahead(0),
+      m_lookaheadTs(0),
+      m_windowEnd(0),
+      m_running(false),
+      m_done(false),
+      m_stop(false),
+      m_stopTs(std::numeric_limits<uint64_t>::max()),
+      m_barrier(nullptr),
+      m_eventsWithContext(nullptr),
+      m_mainThreadId(std::this_thread::get_id())
+{
+    NS_LOG_FUNCTION(this);
+    m_partitions[0].outboxes.resize(1);
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    ProcessEventsWithContext();
+
+    for (auto& partition : m_partitions)
+    {
+        for (auto& outbox : partition.outboxes)
+        {
+            for (auto& ev : outbox)
+            {
+                ev.event->Unref();
+            }
+            outbox.clear();
+        }
+        if (partition.events)
+        {
+            while (!partition.events->IsEmpty())
+            {
+                Scheduler::Event next = partition.events->RemoveNext();
+                next.impl->Unref();
+            }
+            partition.events = nullptr;
+        }
+    }
+    m_stopTimes.clear();
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    NS_ASSERT_MSG(!m_running, "Cannot change the scheduler while the simulation is running");
+    m_schedulerFactory = schedulerFactory;
+
+    for (auto& partition : m_partitions)
+    {
+        Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+        if (partition.events)
+        {
+            while (!partition.events->IsEmpty())
+            {
+                Scheduler::Event next = partition.events->RemoveNext();
+                scheduler->Insert(next);
+            }
+        }
+        partition.events = scheduler;
+    }
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNPartitions() const
+{
+    return m_partitions.size();
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition(uint32_t context) const
+{
+    if (context == Simulator::NO_CONTEXT)
+    {
+        return 0;
+    }
+    return context % m_partitions.size();
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetCurrentPartition() const
+{
+    return (g_partition == NO_PARTITION) ? 0 : g_partition;
+}
+
+bool
+MultithreadedSimulatorImpl::IsParallel()
+{
+    return g_parallel;
+}
+
+bool
+MultithreadedSimulatorImpl::IsForeignThread() const
+{
+    return g_partition == NO_PARTITION && std::this_thread::get_id() != m_mainThreadId;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::Insert(Partition& partition,
+                                   uint64_t ts,
+                                   uint32_t context,
+                                   EventImpl* event)
+{
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    // partition i uses the unique ids equal to i modulo the number of partitions
+    ev.key.m_uid = partition.uid;
+    partition.uid += m_partitions.size();
+    partition.unscheduledEvents++;
+    partition.events->Insert(ev);
+    return ev.key.m_uid;
+}
+
+void
+MultithreadedSimulatorImpl::Repartition(uint32_t nPartitions)
+{
+    NS_LOG_FUNCTION(this << nPartitions);
+    std::vector<Partition> old(nPartitions);
+    old.swap(m_partitions);
+
+    uint32_t nextUid = 0;
+    uint64_t minTs = std::numeric_limits<uint64_t>::max();
+    uint64_t eventCount = 0;
+    for (const auto& partition : old)
+    {
+        nextUid = std::max(nextUid, partition.uid);
+        minTs = std::min(minTs, partition.currentTs);
+        eventCount += partition.eventCount;
+    }
+
+    for (uint32_t i = 0; i < nPartitions; i++)
+    {
+        Partition& partition = m_partitions[i];
+        partition.events = m_schedulerFactory.Create<Scheduler>();
+        partition.outboxes.resize(nPartitions);
+        partition.uid = nextUid + i;
+        partition.currentTs = minTs;
+        if (old.size() == 1)
+        {
+            partition.currentUid = old[0].currentUid;
+        }
+    }
+    m_partitions[0].currentContext = old[0].currentContext;
+    m_partitions[0].eventCount = eventCount;
+
+    // the events keep their unique id, which is unique among all the partitions
+    for (auto& partition : old)
+    {
+        NS_ASSERT(partition.events);
+        while (!partition.events->IsEmpty())
+        {
+            Scheduler::Event next = partition.events->RemoveNext();
+            Partition& destination = m_partitions[GetPartition(next.key.m_context)];
+            destination.events->Insert(next);
+            destination.unscheduledEvents++;
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessEventsWithContext()
+{
+    if (m_eventsWithContext.load(std::memory_order_relaxed) == nullptr)
+    {
+        return;
+    }
+
+    // take all the events at once and reverse the list, which is in LIFO order
+    EventWithContext* event = m_eventsWithContext.exchange(nullptr, std::memory_order_acquire);
+    EventWithContext* first = nullptr;
+    while (event != nullptr)
+    {
+        EventWithContext* next = event->next;
+        event->next = first;
+        first = event;
+        event = next;
+    }
+
+    while (first != nullptr)
+    {
+        Partition& partition = m_partitions[GetPartition(first->context)];
+        Insert(partition, partition.currentTs + first->timestamp, first->context, first->event);
+        EventWithContext* next = first->next;
+        delete first;
+        first = next;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Synchronize() noexcept
+{
+    const uint32_t nPartitions = m_partitions.size();
+
+    // move the events exchanged by the partitions to their destination, in an
+    // order that only depends on the order in which they were scheduled
+    for (uint32_t dst = 0; dst < nPartitions; dst++)
+    {
+        Partition& destination = m_partitions[dst];
+        for (auto& source : m_partitions)
+        {
+            for (const auto& ev : source.outboxes[dst])
+            {
+                NS_ASSERT(ev.timestamp >= destination.currentTs);
+                Insert(destination, ev.timestamp, ev.context, ev.event);
+            }
+            source.outboxes[dst].clear();
+        }
+    }
+    ProcessEventsWithContext();
+
+    m_stop = std::any_of(m_partitions.cbegin(), m_partitions.cend(), [](const Partition& p) {
+        return p.stop;
+    });
+
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    for (const auto& partition : m_partitions)
+    {
+        if (!partition.events->IsEmpty())
+        {
+            next = std::min(next, partition.events->PeekNext().key.m_ts);
+        }
+    }
+
+    if (!m_stop)
+    {
+        // the stop events earlier than the next event were cancelled
+        m_stopTimes.erase(m_stopTimes.begin(), m_stopTimes.lower_bound(next));
+    }
+
+    if (m_stop || next == std::numeric_limits<uint64_t>::max())
+    {
+        m_done = true;
+        return;
+    }
+
+    // no event scheduled by a partition in the window can be executed by another
+    // partition before the end of the window
+    if (nPartitions == 1 || next > std::numeric_limits<uint64_t>::max() - m_lookaheadTs)
+    {
+        m_windowEnd = std::numeric_limits<uint64_t>::max();
+    }
+    else
+    {
+        m_windowEnd = next + m_lookaheadTs;
+    }
+    // no partition executes events later than the next stop event
+    if (!m_stopTimes.empty() && *m_stopTimes.begin() < m_windowEnd)
+    {
+        m_windowEnd = *m_stopTimes.begin() + 1;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow(Partition& partition)
+{
+    const bool single = (m_partitions.size() == 1);
+
+    while (!partition.stop && !partition.events->IsEmpty())
+    {
+        uint64_t ts = partition.events->PeekNext().key.m_ts;
+        if (ts >= m_windowEnd || ts > m_stopTs.load(std::memory_order_relaxed))
+        {
+            break;
+        }
+        Scheduler::Event next = partition.events->RemoveNext();
+
+        PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+
+        NS_ASSERT(next.key.m_ts >= partition.currentTs);
+        partition.unscheduledEvents--;
+        partition.eventCount++;
+
+        partition.currentTs = next.key.m_ts;
+        partition.currentContext = next.key.m_context;
+        partition.currentUid = next.key.m_uid;
+        next.impl->Invoke();
+        next.impl->Unref();
+
+        if (single)
+        {
+            // no other partition is running, hence the events scheduled by other
+            // threads can be inserted right away, as in the DefaultSimulatorImpl
+            ProcessEventsWithContext();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunPartition(uint32_t index)
+{
+    g_partition = index;
+    g_parallel = (m_partitions.size() > 1);
+    Partition& partition = m_partitions[index];
+    while (true)
+    {
+        m_barrier->arrive_and_wait();
+        if (m_done)
+        {
+            break;
+        }
+        ProcessWindow(partition);
+    }
+    g_partition = NO_PARTITION;
+    g_parallel = false;
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    return m_stop || std::all_of(m_partitions.cbegin(),
+                                 m_partitions.cend(),
+                                 [](const Partition& p) { return p.events->IsEmpty(); });
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(!m_running, "Simulator::Run() cannot be called by an event");
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+
+    uint32_t nPartitions = 1;
+    if (m_lookahead.IsStrictlyPositive())
+    {
+        nPartitions = m_threadCount;
+        if (nPartitions == 0)
+        {
+            nPartitions = std::max(std::thread::hardware_concurrency(), 1U);
+        }
+    }
+    if (nPartitions != m_partitions.size())
+    {
+        Repartition(nPartitions);
+    }
+    NS_LOG_LOGIC("running " << nPartitions << " partitions, lookahead " << m_lookahead);
+
+    m_lookaheadTs = m_lookahead.GetTimeStep();
+    m_stop = false;
+    m_stopTs = std::numeric_limits<uint64_t>::max();
+    for (auto& partition : m_partitions)
+    {
+        partition.stop = false;
+    }
+    m_done = false;
+    m_running = true;
+
+    std::barrier<WindowCompletion> barrier(nPartitions, WindowCompletion{this});
+    m_barrier = &barrier;
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < nPartitions; i++)
+    {
+        threads.emplace_back(&MultithreadedSimulatorImpl::RunPartition, this, i);
+    }
+    RunPartition(0);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    m_barrier = nullptr;
+    m_running = false;
+
+    // align the clocks of the partitions, so that the simulation time does not
+    // depend on the calling partition
+    uint64_t now = 0;
+    if (m_stop)
+    {
+        // the partitions executed all their events up to the time of the stop
+        now = m_stopTs.load(std::memory_order_relaxed);
+        m_stopTimes.erase(m_stopTimes.begin(), m_stopTimes.upper_bound(now));
+    }
+    else
+    {
+        // all the events were executed
+        for (const auto& partition : m_partitions)
+        {
+            NS_ASSERT(partition.unscheduledEvents == 0);
+            now = std::max(now, partition.currentTs);
+        }
+    }
+    if (now != std::numeric_limits<uint64_t>::max())
+    {
+        for (auto& partition : m_partitions)
+        {
+            if (partition.currentTs < now)
+            {
+                partition.currentTs = now;
+                partition.currentUid = partition.uid - 1;
+            }
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    Partition& partition = m_partitions[GetCurrentPartition()];
+    partition.stop = true;
+    // the other partitions do not execute the events later than the current one
+    uint64_t stopTs = m_stopTs.load(std::memory_order_relaxed);
+    while (partition.currentTs < stopTs &&
+           !m_stopTs.compare_exchange_weak(stopTs,
+                                           partition.currentTs,
+                                           std::memory_order_relaxed,
+                                           std::memory_order_relaxed))
+    {
+    }
+    if (!m_running)
+    {
+        m_stop = true;
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    EventId id = Simulator::Schedule(delay, &Simulator::Stop);
+    std::lock_guard<std::mutex> lock(m_stopTimesMutex);
+    m_stopTimes.insert(id.GetTs());
+    return id;
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(!IsForeignThread(), "Simulator::Schedule Thread-unsafe invocation!");
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+    uint32_t index = GetCurrentPartition();
+    Partition& partition = m_partitions[index];
+    uint32_t context = partition.currentContext;
+    uint32_t dst = GetPartition(context);
+    NS_ASSERT_MSG(!m_running || dst == index,
+                  "Simulator::Schedule(): the current context "
+                      << context << " belongs to another partition, "
+                      << "use Simulator::ScheduleWithContext()");
+
+    Partition& destination = m_partitions[dst];
+    uint64_t ts = std::max<uint64_t>(partition.currentTs + delay.GetTimeStep(),
+                                     destination.currentTs);
+    uint32_t uid = Insert(destination, ts, context, event);
+    return EventId(event, ts, context, uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+
+    if (IsForeignThread())
+    {
+        auto ev = new EventWithContext;
+        ev->context = context;
+        // Current time added in ProcessEventsWithContext()
+        ev->timestamp = delay.GetTimeStep();
+        ev->event = event;
+        ev->next = m_eventsWithContext.load(std::memory_order_relaxed);
+        while (!m_eventsWithContext.compare_exchange_weak(ev->next,
+                                                          ev,
+                                                          std::memory_order_release,
+                                                          std::memory_order_relaxed))
+        {
+        }
+        return;
+    }
+
+    uint32_t index = GetCurrentPartition();
+    Partition& partition = m_partitions[index];
+    uint64_t ts = partition.currentTs + delay.GetTimeStep();
+    uint32_t dst = GetPartition(context);
+
+    if (!m_running || dst == index)
+    {
+        Partition& destination = m_partitions[dst];
+        Insert(destination, std::max(ts, destination.currentTs), context, event);
+        return;
+    }
+
+    NS_ABORT_MSG_IF(static_cast<uint64_t>(delay.GetTimeStep()) < m_lookaheadTs,
+                    "Event for context " << context << " scheduled with delay " << delay
+                                         << ", smaller than the lookahead " << m_lookahead);
+    partition.outboxes[dst].push_back({context, ts, event, nullptr});
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+    EventId id(Ptr<EventImpl>(event, false),
+               m_partitions[GetCurrentPartition()].currentTs,
+               0xffffffff,
+               EventId::UID::DESTROY);
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(m_partitions[GetCurrentPartition()].currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    else
+    {
+        return TimeStep(id.GetTs() - m_partitions[GetCurrentPartition()].currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    uint32_t index = GetPartition(id.GetContext());
+    NS_ASSERT_MSG(!m_running || index == GetCurrentPartition(),
+                  "Cannot remove an event of another partition");
+    Partition& partition = m_partitions[index];
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    partition.events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+
+    partition.unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    // the event is compared with the clock of the partition it belongs to
+    const Partition& partition = m_partitions[GetPartition(id.GetContext())];
+    return id.PeekEventImpl() == nullptr || id.GetTs() < partition.currentTs ||
+           (id.GetTs() == partition.currentTs && id.GetUid() <= partition.currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return m_partitions[GetCurrentPartition()].currentContext;
+}
+
+void
+MultithreadedSimulatorImpl::SetContext(uint32_t context)
+{
+    m_partitions[GetCurrentPartition()].currentContext = context;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t eventCount = 0;
+    for (const auto& partition : m_partitions)
+    {
+        eventCount += partition.eventCount;
+    }
+    return eventCount;
+}
+
+} // namespace ns3
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "nstime.h"
+#include "object-factory.h"
+#include "simulator-impl.h"
+#include "simulator.h"
+
+#include <atomic>
+#include <barrier>
+#include <list>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+// Forward
+class Scheduler;
+
+/**
+ * \ingroup simulator
+ *
+ * \brief A single process simulator implementation that executes the
+ * events of different nodes in parallel threads.
+ *
+ * The execution contexts (i.e., the node IDs) are partitioned among
+ * ThreadCount partitions: the events of context \c c belong to partition
+ * <tt>c % ThreadCount</tt>, while the events without context belong to
+ * partition 0. Every partition has its own event list and its own clock
+ * and is executed by its own thread (partition 0 is executed by the
+ * thread calling Simulator::Run()).
+ *
+ * The partitions are synchronized by the conservative, window-based
+ * algorithm also used by the DistributedSimulatorImpl: the Lookahead
+ * attribute is the minimum delay of the events that a partition schedules
+ * for a context of another partition (i.e., the minimum delay of the
+ * channels connecting the nodes). If \c T is the timestamp of the earliest
+ * pending event, all the partitions can safely execute the events earlier
+ * than <tt>T + Lookahead</tt> in parallel, because no event scheduled by
+ * another partition can be earlier than that. The events scheduled for
+ * other partitions are buffered in per-destination vectors owned by the
+ * source partition, and are moved to the event lists of the destinations
+ * at the barrier that ends every window, in an order that does not depend
+ * on the thread timing. Hence, the simulation is deterministic for a given
+ * ThreadCount.
+ *
+ * The lookahead of a set of channels can be obtained with
+ * ChannelList::GetMinimumDelay(), for the channels declaring their minimum
+ * delay (see Channel::GetMinimumDelay()), and set before Simulator::Run()
+ * through Simulator::GetImplementation(). If the lookahead is zero, all the
+ * events are executed by the main thread, as with the DefaultSimulatorImpl.
+ *
+ * Events scheduled from a thread other than the simulation threads are
+ * pushed onto a lock-free stack and moved to the event list of the
+ * partition of their context at the next barrier.
+ *
+ * Simulator::Stop() stops all the partitions: the events later than the
+ * time of the call are not executed. The windows end at the time of the
+ * stop events scheduled by Simulator::Stop(const Time&), hence no partition
+ * executes events later than them; if an event calls Simulator::Stop(), the
+ * other partitions may have already executed the events later than the
+ * call in the current window.
+ *
+ * \warning The models executed in different partitions must not share
+ * state without synchronization. In particular, the reference counts of
+ * the objects (e.g., packets, devices and nodes) are not atomic: a channel
+ * must neither hand over to another partition objects that the source
+ * partition keeps using (e.g., the copies of a packet returned by
+ * Packet::Copy(), which share their datasets) nor copy the smart pointers
+ * of the objects of another partition. Only the channels that comply with
+ * this declare a minimum delay (see Channel::GetMinimumDelay()); they can
+ * use IsParallel() to avoid the cost of full copies when the events are
+ * executed by a single thread.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    void SetContext(uint32_t context) override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * \return the number of partitions the events are currently distributed among
+     */
+    uint32_t GetNPartitions() const;
+
+    /**
+     * \return \c true if the calling thread executes a partition of a simulation
+     * whose events are executed by several threads, i.e., if the objects handed
+     * over to another node may be accessed by another thread
+     */
+    static bool IsParallel();
+
+  private:
+    void DoDispose() override;
+
+    /** An event scheduled by a partition for another partition, or by another thread. */
+    struct EventWithContext
+    {
+        /** The event context. */
+        uint32_t context;
+        /**
+         * Event timestamp: absolute for events scheduled by another partition,
+         * relative for events scheduled by another thread.
+         */
+        uint64_t timestamp;
+        /** The event implementation. */
+        EventImpl* event;
+        /** The next event in the stack of events scheduled by another thread. */
+        EventWithContext* next;
+    };
+
+    /** The state of a partition, only accessed by the thread executing it during a window. */
+    struct Partition
+    {
+        /** The event list. */
+        Ptr<Scheduler> events;
+        /** Events scheduled for the other partitions, indexed by destination partition. */
+        std::vector<std::vector<EventWithContext>> outboxes;
+        /** Next event unique id. */
+        uint32_t uid{EventId::UID::VALID};
+        /** Unique id of the current event. */
+        uint32_t currentUid{EventId::UID::INVALID};
+        /** Timestamp of the current event. */
+        uint64_t currentTs{0};
+        /** Execution context of the current event. */
+        uint32_t currentContext{Simulator::NO_CONTEXT};
+        /** The event count. */
+        uint64_t eventCount{0};
+        /** Number of events that have been inserted but not yet executed. */
+        int unscheduledEvents{0};
+        /** Whether Simulator::Stop() was called by an event of this partition. */
+        bool stop{false};
+    };
+
+    /** Completion function of the barrier that ends every window. */
+    struct WindowCompletion
+    {
+        /** The simulator implementation. */
+        MultithreadedSimulatorImpl* impl;
+
+        /** Call Synchronize() on the simulator implementation. */
+        void operator()() noexcept
+        {
+            impl->Synchronize();
+        }
+    };
+
+    /**
+     * \param [in] context An execution context.
+     * \return The index of the partition of the given context.
+     */
+    uint32_t GetPartition(uint32_t context) const;
+    /**
+     * \return The index of the partition of the calling thread (partition 0
+     * for the main thread).
+     */
+    uint32_t GetCurrentPartition() const;
+    /**
+     * \return \c true if the calling thread is neither the main thread nor a
+     * thread executing a partition.
+     */
+    bool IsForeignThread() const;
+    /**
+     * Insert an event in the event list of a partition.
+     *
+     * \param [in,out] partition The partition.
+     * \param [in] ts The event timestamp.
+     * \param [in] context The event context.
+     * \param [in] event The event implementation.
+     * \return The unique id of the event.
+     */
+    uint32_t Insert(Partition& partition, uint64_t ts, uint32_t context, EventImpl* event);
+    /**
+     * Distribute the pending events among the given number of partitions.
+     *
+     * \param [in] nPartitions The number of partitions.
+     */
+    void Repartition(uint32_t nPartitions);
+    /**
+     * Execute the partition with the given index until the end of the simulation.
+     *
+     * \param [in] index The index of the partition.
+     */
+    void RunPartition(uint32_t index);
+    /**
+     * Execute the events of a partition that are earlier than the end of the current window.
+     *
+     * \param [in,out] partition The partition.
+     */
+    void ProcessWindow(Partition& partition);
+    /**
+     * Move the events scheduled by other threads to the event lists of the
+     * partitions of their context.
+     */
+    void ProcessEventsWithContext();
+    /**
+     * Executed by a single thread when all the partitions have completed
+     * the current window: move the events exchanged by the partitions to
+     * their destination and compute the end of the next window.
+     */
+    void Synchronize() noexcept;
+
+    /** The partitions. */
+    std::vector<Partition> m_partitions;
+    /** The factory of the event lists of the partitions. */
+    ObjectFactory m_schedulerFactory;
+    /** Number of partitions to use at the next Run() (0: one per hardware thread). */
+    uint32_t m_threadCount;
+    /** Minimum delay of the events scheduled for another partition. */
+    Time m_lookahead;
+    /** Minimum delay of the events scheduled for another partition, in time steps. */
+    uint64_t m_lookaheadTs;
+    /** Events strictly earlier than this timestamp are executed in the current window. */
+    uint64_t m_windowEnd;
+    /** Whether the partitions are being executed in parallel. */
+    bool m_running;
+    /** Whether the simulation is over (set by Synchronize()). */
+    bool m_done;
+    /** Flag calling for the end of the simulation. */
+    bool m_stop;
+    /**
+     * Timestamp of the earliest call to Simulator::Stop() in the current window:
+     * the partitions do not execute later events.
+     */
+    std::atomic<uint64_t> m_stopTs;
+    /** Timestamps of the stop events scheduled by Stop(const Time&). */
+    std::set<uint64_t> m_stopTimes;
+    /** Mutex protecting m_stopTimes from the partitions. */
+    std::mutex m_stopTimesMutex;
+    /** The barrier that ends every window. */
+    std::barrier<WindowCompletion>* m_barrier;
+    /** Lock-free stack of the events scheduled by another thread, most recent first. */
+    std::atomic<EventWithContext*> m_eventsWithContext;
+    /** Container type for the events to run at Simulator::Destroy() */
+    typedef std::list<EventId> DestroyEvents;
+    /** The container of events to run at Destroy. */
+    DestroyEvents m_destroyEvents;
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pool-allocator.h"
+
+#include <new>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::PoolAllocator implementation.
+ */
+
+namespace ns3
+{
+
+namespace
+{
+
+/// Number of size classes
+constexpr std::size_t N_SIZE_CLASSES = PoolAllocator::MAX_BLOCK_SIZE / PoolAllocator::GRANULARITY;
+
+/**
+ * A free block, linked to the next free block of the same size class
+ */
+struct FreeBlock
+{
+    FreeBlock* next; //!< the next free block
+};
+
+/**
+ * Per-thread allocator state. This struct is trivially destructible, so that
+ * blocks can be released while thread-local objects are being destroyed.
+ */
+struct PoolState
+{
+    FreeBlock* heads[N_SIZE_CLASSES];       //!< free list heads, per size class
+    std::size_t nCached[N_SIZE_CLASSES];    //!< number of free blocks, per size class
+    PoolAllocator::Stats stats;             //!< allocator statistics
+    bool exiting;                           //!< whether the thread is exiting
+};
+
+/// The allocator state of the current thread
+thread_local PoolState g_poolState{};
+
+/**
+ * Returns the blocks cached by a thread to the global heap when the thread exits.
+ * The guard of a thread is constructed when the thread caches a block for the
+ * first time, hence threads not using the allocator do not pay for it.
+ */
+struct PoolStateGuard
+{
+    /** Destructor. */
+    ~PoolStateGuard();
+    /** Whether the thread has cached a block. */
+    bool used{false};
+};
+
+/// The guard of the allocator state of the current thread
+thread_local PoolStateGuard g_poolStateGuard;
+
+PoolStateGuard::~PoolStateGuard()
+{
+    // blocks released by the thread-local objects destroyed after this guard are
+    // returned to the global heap rather than cached
+    g_poolState.exiting = true;
+    PoolAllocator::Trim();
+}
+
+/**
+ * \param size the requested size
+ * \return the size class of the given size
+ */
+inline std::size_t
+GetSizeClass(std::size_t size)
+{
+    return (size + PoolAllocator::GRANULARITY - 1) / PoolAllocator::GRANULARITY - 1;
+}
+
+} // unnamed namespace
+
+void*
+PoolAllocator::Allocate(std::size_t size)
+{
+    auto& state = g_poolState;
+    ++state.stats.allocations;
+    if (size == 0 || size > MAX_BLOCK_SIZE)
+    {
+        return ::operator new(size);
+    }
+    const auto sizeClass = GetSizeClass(size);
+    if (auto block = state.heads[sizeClass]; block != nullptr)
+    {
+        state.heads[sizeClass] = block->next;
+        --state.nCached[sizeClass];
+        --state.stats.cachedBlocks;
+        ++state.stats.recycled;
+        return block;
+    }
+    return ::operator new((sizeClass + 1) * GRANULARITY);
+}
+
+void
+PoolAllocator::Deallocate(void* p, std::size_t size) noexcept
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+    auto& state = g_poolState;
+    ++state.stats.deallocations;
+    if (size == 0 || size > MAX_BLOCK_SIZE)
+    {
+        ::operator delete(p);
+        return;
+    }
+    const auto sizeClass = GetSizeClass(size);
+    if (state.nCached[sizeClass] >= MAX_CACHED_BLOCKS || state.exiting)
+    {
+        ::operator delete(p);
+        return;
+    }
+    if (state.stats.cachedBlocks == 0)
+    {
+        // make sure that the cached blocks are released when the thread exits
+        g_poolStateGuard.used = true;
+    }
+    auto block = static_cast<FreeBlock*>(p);
+    block->next = state.heads[sizeClass];
+    state.heads[sizeClass] = block;
+    ++state.nCached[sizeClass];
+    ++state.stats.cachedBlocks;
+}
+
+PoolAllocator::Stats
+PoolAllocator::GetStats()
+{
+    return g_poolState.stats;
+}
+
+void
+PoolAllocator::Trim()
+{
+    auto& state = g_poolState;
+    for (std::size_t sizeClass = 0; sizeClass < N_SIZE_CLASSES; ++sizeClass)
+    {
+        while (auto block = state.heads[sizeClass])
+        {
+            state.heads[sizeClass] = block->next;
+            ::operator delete(block);
+        }
+        state.nCached[sizeClass] = 0;
+    }
+    state.stats.cachedBlocks = 0;
+}
+
+} // namespace ns3
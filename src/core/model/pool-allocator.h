@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::PoolAllocator and ns3::PoolAllocated declarations.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup core
+ * \brief Size-class free lists for small, short-lived objects.
+ *
+ * Requested sizes are rounded up to a multiple of GRANULARITY bytes. Blocks
+ * released by Deallocate() are kept in a free list per size class and handed
+ * out again by the next Allocate() call for the same size class, so that
+ * objects that are created and destroyed at a high rate (e.g., a PPDU for
+ * every transmission) do not hit the global heap once the simulation reached
+ * a steady state. Requests larger than MAX_BLOCK_SIZE bytes are forwarded to
+ * the global operator new.
+ *
+ * Free lists are thread local and every block is individually obtained from
+ * the global operator new, hence a block may be released by a thread other
+ * than the one that allocated it. At most MAX_CACHED_BLOCKS blocks are kept
+ * in each free list; blocks cached by a thread are returned to the global
+ * heap by calling Trim() from that thread or when that thread exits.
+ */
+class PoolAllocator
+{
+  public:
+    /// Size class granularity in bytes
+    static constexpr std::size_t GRANULARITY = 16;
+    /// Size in bytes of the largest block served from the free lists
+    static constexpr std::size_t MAX_BLOCK_SIZE = 1024;
+    /// Maximum number of blocks kept in the free list of a size class
+    static constexpr std::size_t MAX_CACHED_BLOCKS = 4096;
+
+    /**
+     * Allocator statistics of the calling thread
+     */
+    struct Stats
+    {
+        uint64_t allocations{0};   //!< number of calls to Allocate()
+        uint64_t recycled{0};      //!< number of allocations served from a free list
+        uint64_t deallocations{0}; //!< number of calls to Deallocate()
+        uint64_t cachedBlocks{0};  //!< number of blocks currently kept in the free lists
+    };
+
+    /**
+     * \param size the size in bytes of the block to allocate
+     * \return a pointer to a block of at least the given size
+     */
+    static void* Allocate(std::size_t size);
+    /**
+     * \param p a pointer returned by Allocate()
+     * \param size the size passed to Allocate() when the block was allocated
+     */
+    static void Deallocate(void* p, std::size_t size) noexcept;
+
+    /**
+     * \return the allocator statistics of the calling thread
+     */
+    static Stats GetStats();
+    /**
+     * Return all the blocks cached by the calling thread to the global heap.
+     */
+    static void Trim();
+};
+
+/**
+ * \ingroup core
+ * \brief Base class whose derived classes are allocated through the PoolAllocator.
+ *
+ * Derived classes that are deleted through a pointer to a base class must
+ * have a virtual destructor, so that the size of the most derived class is
+ * passed to operator delete.
+ */
+class PoolAllocated
+{
+  public:
+    /**
+     * \param size the size of the object to allocate
+     * \return a pointer to the storage for the object
+     */
+    static void* operator new(std::size_t size)
+    {
+        return PoolAllocator::Allocate(size);
+    }
+
+    /**
+     * \param p a pointer to the storage of the object
+     * \param size the size of the object
+     */
+    static void operator delete(void* p, std::size_t size) noexcept
+    {
+        PoolAllocator::Deallocate(p, size);
+    }
+};
+
+} // namespace ns3
+
+#endif /* POOL_ALLOCATOR_H */
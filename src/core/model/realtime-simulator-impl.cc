@@ -795,6 +795,12 @@ RealtimeSimulatorImpl::GetContext() const
     return m_currentContext;
 }
 
+void
+RealtimeSimulatorImpl::SetContext(uint32_t context)
+{
+    m_currentContext = context;
+}
+
 uint64_t
 RealtimeSimulatorImpl::GetEventCount() const
 {
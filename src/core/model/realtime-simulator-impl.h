@@ -106,6 +106,7 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     void SetScheduler(ObjectFactory schedulerFactory) override;
     uint32_t GetSystemId() const override;
     uint32_t GetContext() const override;
+    void SetContext(uint32_t context) override;
     uint64_t GetEventCount() const override;
 
     /** \copydoc ScheduleWithContext(uint32_t,const Time&,EventImpl*) */
@@ -98,6 +98,8 @@ class SimulatorImpl : public Object
     virtual uint32_t GetSystemId() const = 0;
     /** \copydoc Simulator::GetContext */
     virtual uint32_t GetContext() const = 0;
+    /** \copydoc Simulator::SetContext */
+    virtual void SetContext(uint32_t context) = 0;
     /** \copydoc Simulator::GetEventCount */
     virtual uint64_t GetEventCount() const = 0;
 
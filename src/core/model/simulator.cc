@@ -320,6 +320,12 @@ Simulator::GetContext()
     return GetImpl()->GetContext();
 }
 
+void
+Simulator::SetContext(uint32_t context)
+{
+    GetImpl()->SetContext(context);
+}
+
 uint64_t
 Simulator::GetEventCount()
 {
@@ -195,6 +195,20 @@ class Simulator
      */
     static uint32_t GetContext();
 
+    /**
+     * Change the context of the event being executed.
+     *
+     * This is only meant for objects, such as channels, that use a single
+     * event to deliver a signal to devices belonging to different nodes:
+     * switching to the context of each receiving node before handing it the
+     * signal ensures that the events it schedules are tagged with the right
+     * context. The caller is responsible for restoring the original context
+     * before returning from the event.
+     *
+     * @param [in] context The new context
+     */
+    static void SetContext(uint32_t context);
+
     /**
      * Context enum values.
      *
@@ -22,7 +22,9 @@
 
 #include "callback.h"
 
+#include <algorithm>
 #include <list>
+#include <vector>
 
 /**
  * \file
@@ -47,6 +49,17 @@ namespace ns3
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * The first Callback of the chain is stored inline, while the following
+ * ones are stored in a vector: invoking a TracedCallback with no Callback
+ * connected only costs the check of a couple of pointers, and invoking a TracedCallback
+ * with a single Callback connected does not access any other memory block
+ * than the Callback implementation.
+ *
+ * The Callbacks may connect and disconnect Callbacks (including themselves)
+ * while the chain is being invoked: the Callbacks connected are invoked, too,
+ * while the Callbacks disconnected are only removed from the chain when the
+ * invocation completes, so that all the other Callbacks are still invoked.
+ *
  * \tparam Ts \explicit Types of the functor arguments.
  */
 template <typename... Ts>
@@ -109,13 +122,40 @@ class TracedCallback
 
   private:
     /**
-     * Container type for holding the chain of Callbacks.
+     * Append a Callback to the chain.
+     *
+     * \param [in] callback Callback to add to chain.
+     */
+    void Append(const Callback<void, Ts...>& callback);
+    /**
+     * Remove from the chain the Callbacks that were disconnected while the
+     * chain was being invoked.
+     */
+    void Compact() const;
+
+    /**
+     * Container type for holding the chain of Callbacks but the first one.
      *
      * \tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
-    /** The chain of Callbacks. */
-    CallbackList m_callbackList;
+    typedef std::vector<Callback<void, Ts...>> CallbackList;
+    /**
+     * The first Callback of the chain (null if the chain is empty or if it was
+     * disconnected while the chain is being invoked).
+     */
+    mutable Callback<void, Ts...> m_first;
+    /**
+     * The chain of Callbacks following the first one (including null Callbacks
+     * if they were disconnected while the chain is being invoked).
+     */
+    mutable CallbackList m_others;
+    /** The number of invocations of the chain in progress. */
+    mutable uint32_t m_nInvocations;
+    /**
+     * The Callbacks disconnected while the chain is being invoked, which are kept
+     * alive until the invocation completes because they may be running.
+     */
+    mutable CallbackList m_disconnected;
 };
 
 } // namespace ns3
@@ -129,10 +169,27 @@ namespace ns3
 
 template <typename... Ts>
 TracedCallback<Ts...>::TracedCallback()
-    : m_callbackList()
+    : m_first(),
+      m_others(),
+      m_nInvocations(0),
+      m_disconnected()
 {
 }
 
+template <typename... Ts>
+void
+TracedCallback<Ts...>::Append(const Callback<void, Ts...>& callback)
+{
+    if (m_first.IsNull() && m_others.empty())
+    {
+        m_first = callback;
+    }
+    else
+    {
+        m_others.push_back(callback);
+    }
+}
+
 template <typename... Ts>
 void
 TracedCallback<Ts...>::ConnectWithoutContext(const CallbackBase& callback)
@@ -142,7 +199,7 @@ TracedCallback<Ts...>::ConnectWithoutContext(const CallbackBase& callback)
     {
         NS_FATAL_ERROR_NO_MSG();
     }
-    m_callbackList.push_back(cb);
+    Append(cb);
 }
 
 template <typename... Ts>
@@ -155,22 +212,49 @@ TracedCallback<Ts...>::Connect(const CallbackBase& callback, std::string path)
         NS_FATAL_ERROR("when connecting to " << path);
     }
     Callback<void, Ts...> realCb = cb.Bind(path);
-    m_callbackList.push_back(realCb);
+    Append(realCb);
 }
 
 template <typename... Ts>
 void
 TracedCallback<Ts...>::DisconnectWithoutContext(const CallbackBase& callback)
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); /* empty */)
+    if (m_nInvocations > 0)
     {
-        if ((*i).IsEqual(callback))
+        // do not move the Callbacks being invoked: nullify the disconnected ones, which
+        // are removed when the invocation completes
+        if (!m_first.IsNull() && m_first.IsEqual(callback))
+        {
+            m_disconnected.push_back(m_first);
+            m_first.Nullify();
+        }
+        for (auto& cb : m_others)
         {
-            i = m_callbackList.erase(i);
+            if (!cb.IsNull() && cb.IsEqual(callback))
+            {
+                m_disconnected.push_back(cb);
+                cb.Nullify();
+            }
+        }
+        return;
+    }
+    m_others.erase(std::remove_if(m_others.begin(),
+                                  m_others.end(),
+                                  [&callback](const Callback<void, Ts...>& cb) {
+                                      return cb.IsEqual(callback);
+                                  }),
+                   m_others.end());
+    if (!m_first.IsNull() && m_first.IsEqual(callback))
+    {
+        // the first of the remaining Callbacks (if any) becomes the first one
+        if (m_others.empty())
+        {
+            m_first.Nullify();
         }
         else
         {
-            i++;
+            m_first = m_others.front();
+            m_others.erase(m_others.begin());
         }
     }
 }
@@ -192,17 +276,50 @@ template <typename... Ts>
 void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
+    if (m_first.IsNull() && m_others.empty())
+    {
+        return;
+    }
+    m_nInvocations++;
+    if (!m_first.IsNull())
+    {
+        m_first(args...);
+    }
+    // Callbacks connected by the Callbacks being invoked are invoked, too
+    for (std::size_t i = 0; i < m_others.size(); i++)
+    {
+        if (!m_others[i].IsNull())
+        {
+            m_others[i](args...);
+        }
+    }
+    if (--m_nInvocations == 0 && !m_disconnected.empty())
+    {
+        Compact();
+    }
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::Compact() const
+{
+    m_others.erase(std::remove_if(m_others.begin(),
+                                  m_others.end(),
+                                  [](const Callback<void, Ts...>& cb) { return cb.IsNull(); }),
+                   m_others.end());
+    if (m_first.IsNull() && !m_others.empty())
     {
-        (*i)(args...);
+        m_first = m_others.front();
+        m_others.erase(m_others.begin());
     }
+    m_disconnected.clear();
 }
 
 template <typename... Ts>
 bool
 TracedCallback<Ts...>::IsEmpty() const
 {
-    return m_callbackList.empty();
+    return m_first.IsNull() && m_others.empty();
 }
 
 } // namespace ns3
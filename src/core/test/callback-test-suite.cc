@@ -991,6 +991,65 @@ NullifyCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(target1.IsNull(), true, "Nullified Callback reports not IsNull()");
 }
 
+/**
+ * \ingroup callback-tests
+ *
+ * Check that a Callback bound to a Ptr keeps the object alive while the
+ * member function destroys the Callback.
+ */
+class CallbackLifetimeTestCase : public TestCase
+{
+  public:
+    CallbackLifetimeTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Object whose member function destroys the callback bound to it. */
+    class Target : public SimpleRefCount<Target>
+    {
+      public:
+        ~Target()
+        {
+            m_alive = false;
+        }
+
+        /**
+         * Nullify the callback holding the last reference to this object.
+         * \return true if this object is still alive.
+         */
+        bool Run()
+        {
+            m_callback->Nullify();
+            return m_alive;
+        }
+
+        Callback<bool>* m_callback{nullptr}; //!< The callback bound to this object.
+        static bool m_alive;                 //!< Whether the last Target is alive.
+    };
+};
+
+bool CallbackLifetimeTestCase::Target::m_alive = false;
+
+CallbackLifetimeTestCase::CallbackLifetimeTestCase()
+    : TestCase("Check that a Callback keeps its bound object alive while invoked")
+{
+}
+
+void
+CallbackLifetimeTestCase::DoRun()
+{
+    Callback<bool> callback;
+    {
+        Ptr<Target> target = Create<Target>();
+        Target::m_alive = true;
+        target->m_callback = &callback;
+        callback = MakeCallback(&Target::Run, target);
+    }
+    NS_TEST_EXPECT_MSG_EQ(callback(), true, "Object destroyed while its member function runs");
+    NS_TEST_EXPECT_MSG_EQ(Target::m_alive, false, "Object not destroyed with the Callback");
+}
+
 /**
  * \ingroup callback-tests
  *
@@ -1197,6 +1256,7 @@ CallbackTestSuite::CallbackTestSuite()
     AddTestCase(new MakeBoundCallbackTestCase, TestCase::QUICK);
     AddTestCase(new CallbackEqualityTestCase, TestCase::QUICK);
     AddTestCase(new NullifyCallbackTestCase, TestCase::QUICK);
+    AddTestCase(new CallbackLifetimeTestCase, TestCase::QUICK);
     AddTestCase(new MakeCallbackTemplatesTestCase, TestCase::QUICK);
 }
 
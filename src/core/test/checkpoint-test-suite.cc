@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/checkpoint.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * Checkpoint test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup checkpoint-tests Checkpoint test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup checkpoint-tests
+ * Check that the children forked at a checkpoint continue the simulation
+ * exactly as a simulation applying the variant at the checkpoint time, and
+ * that the checkpoint does not wait for children it did not fork.
+ */
+class CheckpointTestCase : public TestCase
+{
+  public:
+    CheckpointTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Set up the simulation: a periodic event drawing random numbers.
+     * \param [in] variant The variant to apply at the checkpoint time, if
+     *             no checkpoint is used, or Checkpoint::NO_VARIANT.
+     */
+    void Setup(uint32_t variant);
+    /** Periodic event, drawing a random number. */
+    void Tick();
+    /**
+     * Apply a variant.
+     * \param [in] variant The variant index.
+     */
+    void SetVariant(uint32_t variant);
+    /**
+     * \param [in] variant The variant index.
+     * \return The name of the file where the child executing the variant
+     * writes its results.
+     */
+    std::string GetFilename(uint32_t variant);
+
+    /** The variant that makes the child process fail. */
+    static constexpr uint32_t FAILING_VARIANT = 3;
+
+    Ptr<UniformRandomVariable> m_rng; //!< The random variable.
+    uint32_t m_offset;                //!< The offset of the period and of the draws.
+    std::vector<uint32_t> m_values;   //!< The random numbers drawn.
+};
+
+CheckpointTestCase::CheckpointTestCase()
+    : TestCase("Check that the children of a checkpoint continue the simulation")
+{
+}
+
+void
+CheckpointTestCase::Setup(uint32_t variant)
+{
+    m_rng = CreateObject<UniformRandomVariable>();
+    m_rng->SetStream(42);
+    m_offset = 0;
+    m_values.clear();
+    if (variant == Checkpoint::NO_VARIANT)
+    {
+        Checkpoint::Schedule(Seconds(1),
+                             FAILING_VARIANT + 1,
+                             MakeCallback(&CheckpointTestCase::SetVariant, this),
+                             2);
+    }
+    else
+    {
+        Simulator::Schedule(Seconds(1), &CheckpointTestCase::SetVariant, this, variant);
+    }
+    Simulator::Schedule(Seconds(0), &CheckpointTestCase::Tick, this);
+    Simulator::Stop(Seconds(2));
+}
+
+void
+CheckpointTestCase::Tick()
+{
+    m_values.push_back(m_rng->GetInteger(0, 1000) + m_offset);
+    Simulator::Schedule(MilliSeconds(100 + m_offset), &CheckpointTestCase::Tick, this);
+}
+
+void
+CheckpointTestCase::SetVariant(uint32_t variant)
+{
+    m_offset = 10 * variant;
+}
+
+std::string
+CheckpointTestCase::GetFilename(uint32_t variant)
+{
+    std::ostringstream oss;
+    oss << "checkpoint-" << variant << ".txt";
+    return CreateTempDirFilename(oss.str());
+}
+
+void
+CheckpointTestCase::DoRun()
+{
+    // a child of the test runner that is not a variant of the checkpoint
+    pid_t other = fork();
+    NS_TEST_ASSERT_MSG_EQ((other >= 0), true, "fork() failed");
+    if (other == 0)
+    {
+        std::_Exit(7);
+    }
+
+    Setup(Checkpoint::NO_VARIANT);
+    Simulator::Run();
+
+    uint32_t variant = Checkpoint::GetVariant();
+    if (variant != Checkpoint::NO_VARIANT)
+    {
+        // child process: write the results and exit without returning to the test runner
+        std::ofstream file(GetFilename(variant));
+        for (auto value : m_values)
+        {
+            file << value << std::endl;
+        }
+        file.close();
+        std::_Exit(variant == FAILING_VARIANT ? EXIT_FAILURE : EXIT_SUCCESS);
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(),
+                          Seconds(1),
+                          "The parent did not stop at the checkpoint");
+    NS_TEST_EXPECT_MSG_EQ(m_values.size(),
+                          10,
+                          "Unexpected number of events before the checkpoint");
+    NS_TEST_EXPECT_MSG_EQ(Checkpoint::GetNFailed(), 1, "Unexpected number of failed children");
+    int status;
+    NS_TEST_EXPECT_MSG_EQ(waitpid(other, &status, 0),
+                          other,
+                          "The checkpoint waited for a child it did not fork");
+    NS_TEST_EXPECT_MSG_EQ((WIFEXITED(status) && WEXITSTATUS(status) == 7),
+                          true,
+                          "Unexpected exit status of the other child");
+    Simulator::Destroy();
+
+    for (uint32_t i = 0; i <= FAILING_VARIANT; i++)
+    {
+        Setup(i);
+        Simulator::Run();
+        Simulator::Destroy();
+
+        std::ifstream file(GetFilename(i));
+        NS_TEST_ASSERT_MSG_EQ(file.is_open(), true, "Missing results of variant " << i);
+        std::vector<uint32_t> values;
+        uint32_t value;
+        while (file >> value)
+        {
+            values.push_back(value);
+        }
+        NS_TEST_EXPECT_MSG_EQ((values == m_values),
+                              true,
+                              "Variant " << i << " differs from a run without checkpoint");
+    }
+}
+
+/**
+ * \ingroup checkpoint-tests
+ * Checkpoint test suite
+ */
+class CheckpointTestSuite : public TestSuite
+{
+  public:
+    CheckpointTestSuite();
+};
+
+CheckpointTestSuite::CheckpointTestSuite()
+    : TestSuite("checkpoint", UNIT)
+{
+    AddTestCase(new CheckpointTestCase(), TestCase::QUICK);
+}
+
+static CheckpointTestSuite g_checkpointTestSuite; //!< Static variable for test initialization
+
+} // namespace tests
+
+} // namespace ns3
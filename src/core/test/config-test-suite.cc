@@ -30,6 +30,7 @@
 #include "ns3/traced-value.h"
 
 #include <sstream>
+#include <vector>
 
 /**
  * \file
@@ -864,6 +865,137 @@ SearchAttributesOfParentObjectsTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), 42, "Object Attribute \"X\" not settable in derived class");
 }
 
+/**
+ * \ingroup config-tests
+ * Test the single pass connection of a trace sink to all the matching
+ * trace sources, and the reuse of the compiled Config paths.
+ */
+class ConnectAllConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ConnectAllConfigTestCase();
+
+    /** Destructor. */
+    ~ConnectAllConfigTestCase() override
+    {
+    }
+
+    /**
+     * Trace callback without context.
+     * \param oldValue The old value.
+     * \param newValue The new value.
+     */
+    void Trace(int16_t oldValue [[maybe_unused]], int16_t newValue)
+    {
+        m_count++;
+        m_newValue = newValue;
+    }
+
+    /**
+     * Trace callback with context path.
+     * \param path The context path.
+     * \param old The old value.
+     * \param newValue The new value.
+     */
+    void TraceWithPath(std::string path, int16_t old [[maybe_unused]], int16_t newValue)
+    {
+        m_newValue = newValue;
+        m_path = path;
+    }
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    uint32_t m_count;   //!< The number of calls of Trace().
+    int16_t m_newValue; //!< Flag to detect tracing result.
+    std::string m_path; //!< The context path.
+};
+
+ConnectAllConfigTestCase::ConnectAllConfigTestCase()
+    : TestCase("Check the connection of a trace sink to all the matching trace sources")
+{
+}
+
+void
+ConnectAllConfigTestCase::DoRun()
+{
+    //
+    // Name an object holding four objects in its NodesB attribute, so that
+    // the paths below do not match the root namespace objects of the other
+    // test cases.
+    //
+    Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject>();
+    Names::Add("ConnectAllRoot", root);
+    std::vector<Ptr<ConfigTestObject>> objects;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        objects.push_back(CreateObject<ConfigTestObject>());
+        root->AddNodeB(objects.back());
+    }
+
+    std::size_t n =
+        Config::ConnectWithoutContextAll("/Names/ConnectAllRoot/NodesB/*/Source",
+                                         MakeCallback(&ConnectAllConfigTestCase::Trace, this));
+    NS_TEST_ASSERT_MSG_EQ(n, 4, "Unexpected number of trace sources connected");
+    m_count = 0;
+    int16_t value = 0;
+    for (const auto& object : objects)
+    {
+        object->SetAttribute("Source", IntegerValue(++value));
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_count, 4, "Unexpected number of trace sink calls");
+
+    n = Config::ConnectAll("/Names/ConnectAllRoot/NodesB/[1-2]|0/Source",
+                           MakeCallback(&ConnectAllConfigTestCase::TraceWithPath, this));
+    NS_TEST_ASSERT_MSG_EQ(n, 3, "Unexpected number of trace sources connected");
+    m_path = "";
+    objects[2]->SetAttribute("Source", IntegerValue(-2));
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, -2, "Trace 2 did not fire as expected");
+    NS_TEST_ASSERT_MSG_EQ(m_path,
+                          "/Names/ConnectAllRoot/NodesB/2/Source",
+                          "Trace 2 did not provide expected context");
+    m_path = "";
+    objects[3]->SetAttribute("Source", IntegerValue(-3));
+    NS_TEST_ASSERT_MSG_EQ(m_path, "", "Trace 3 fired unexpectedly");
+
+    //
+    // The compiled path is reused: check that it matches the objects added
+    // after its first use.
+    //
+    objects.push_back(CreateObject<ConfigTestObject>());
+    root->AddNodeB(objects.back());
+    n = Config::ConnectWithoutContextAll("/Names/ConnectAllRoot/NodesB/*/Source",
+                                         MakeCallback(&ConnectAllConfigTestCase::Trace, this));
+    NS_TEST_ASSERT_MSG_EQ(n, 5, "Unexpected number of trace sources connected");
+    m_count = 0;
+    objects.back()->SetAttribute("Source", IntegerValue(-4));
+    NS_TEST_ASSERT_MSG_EQ(m_count, 1, "Unexpected number of trace sink calls");
+
+    for (int8_t value : {3, 4})
+    {
+        Config::Set("/Names/ConnectAllRoot/NodesB/*/A", IntegerValue(value));
+        for (const auto& object : objects)
+        {
+            NS_TEST_ASSERT_MSG_EQ(object->GetA(), value, "Object Attribute \"A\" not set");
+        }
+    }
+
+    n = Config::ConnectAll("/Names/ConnectAllRoot/NodesB/*/NoSource",
+                           MakeCallback(&ConnectAllConfigTestCase::TraceWithPath, this));
+    NS_TEST_ASSERT_MSG_EQ(n, 0, "Connected to a trace source which does not exist");
+    n = Config::ConnectAll("/Names/ConnectAllRoot/NoNodes/*/Source",
+                           MakeCallback(&ConnectAllConfigTestCase::TraceWithPath, this));
+    NS_TEST_ASSERT_MSG_EQ(n, 0, "Connected through an attribute which does not exist");
+}
+
+void
+ConnectAllConfigTestCase::DoTeardown()
+{
+    Names::Clear();
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -882,6 +1014,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new ConnectAllConfigTestCase);
 }
 
 /**
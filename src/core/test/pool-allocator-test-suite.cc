@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/pool-allocator.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * PoolAllocator test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup pool-allocator-tests PoolAllocator test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup pool-allocator-tests
+ * Pool allocated base class
+ */
+class PooledBase : public SimpleRefCount<PooledBase>, public PoolAllocated
+{
+  public:
+    /** Destructor. */
+    virtual ~PooledBase() = default;
+
+    uint32_t m_value{0}; //!< a value
+};
+
+/**
+ * \ingroup pool-allocator-tests
+ * Pool allocated derived class, larger than the base class
+ */
+class PooledDerived : public PooledBase
+{
+  public:
+    uint8_t m_payload[200]{}; //!< a payload
+};
+
+/**
+ * \ingroup pool-allocator-tests
+ * Check that released blocks are recycled per size class.
+ */
+class PoolAllocatorTestCase : public TestCase
+{
+  public:
+    PoolAllocatorTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PoolAllocatorTestCase::PoolAllocatorTestCase()
+    : TestCase("Check recycling of blocks released to the pool allocator")
+{
+}
+
+void
+PoolAllocatorTestCase::DoRun()
+{
+    PoolAllocator::Trim();
+    auto stats = PoolAllocator::GetStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.cachedBlocks, 0, "No block should be cached after Trim()");
+
+    // the storage of a destroyed object is reused by an object of the same type
+    Ptr<PooledBase> base = Create<PooledBase>();
+    const void* baseStorage = PeekPointer(base);
+    base = nullptr;
+    NS_TEST_EXPECT_MSG_EQ(PoolAllocator::GetStats().cachedBlocks,
+                          stats.cachedBlocks + 1,
+                          "The released block should be cached");
+    base = Create<PooledBase>();
+    NS_TEST_EXPECT_MSG_EQ(PeekPointer(base), baseStorage, "The released block was not reused");
+
+    // objects deleted through a pointer to the base class release a block of the
+    // size of the derived class
+    Ptr<PooledBase> derived = Create<PooledDerived>();
+    const void* derivedStorage = PeekPointer(derived);
+    derived = nullptr;
+    base = nullptr;
+    Ptr<PooledDerived> derived2 = Create<PooledDerived>();
+    NS_TEST_EXPECT_MSG_EQ(static_cast<const void*>(PeekPointer(derived2)),
+                          derivedStorage,
+                          "The block of the derived object was not reused");
+    Ptr<PooledBase> base2 = Create<PooledBase>();
+    NS_TEST_EXPECT_MSG_EQ(PeekPointer(base2),
+                          baseStorage,
+                          "The block of the base object was not reused");
+
+    // the number of cached blocks per size class is bounded
+    std::vector<void*> blocks;
+    for (std::size_t i = 0; i < PoolAllocator::MAX_CACHED_BLOCKS + 10; ++i)
+    {
+        blocks.push_back(PoolAllocator::Allocate(48));
+    }
+    const auto cachedBefore = PoolAllocator::GetStats().cachedBlocks;
+    for (auto block : blocks)
+    {
+        PoolAllocator::Deallocate(block, 48);
+    }
+    NS_TEST_EXPECT_MSG_EQ(PoolAllocator::GetStats().cachedBlocks - cachedBefore,
+                          PoolAllocator::MAX_CACHED_BLOCKS,
+                          "Unexpected number of cached blocks");
+
+    // blocks larger than the maximum block size are not cached
+    const auto recycledBefore = PoolAllocator::GetStats().recycled;
+    void* large = PoolAllocator::Allocate(PoolAllocator::MAX_BLOCK_SIZE + 1);
+    PoolAllocator::Deallocate(large, PoolAllocator::MAX_BLOCK_SIZE + 1);
+    large = PoolAllocator::Allocate(PoolAllocator::MAX_BLOCK_SIZE + 1);
+    PoolAllocator::Deallocate(large, PoolAllocator::MAX_BLOCK_SIZE + 1);
+    NS_TEST_EXPECT_MSG_EQ(PoolAllocator::GetStats().recycled,
+                          recycledBefore,
+                          "Large blocks should not be recycled");
+
+    PoolAllocator::Trim();
+    NS_TEST_EXPECT_MSG_EQ(PoolAllocator::GetStats().cachedBlocks, 0, "Trim() left cached blocks");
+}
+
+/**
+ * \ingroup pool-allocator-tests
+ * Check that the free lists of a thread are independent of the free lists of the
+ * other threads. The blocks cached by a thread are released when the thread exits,
+ * which leak checkers (e.g., valgrind) verify when running this test.
+ */
+class PoolAllocatorThreadTestCase : public TestCase
+{
+  public:
+    PoolAllocatorThreadTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PoolAllocatorThreadTestCase::PoolAllocatorThreadTestCase()
+    : TestCase("Check the free lists of threads other than the main thread")
+{
+}
+
+void
+PoolAllocatorThreadTestCase::DoRun()
+{
+    const auto before = PoolAllocator::GetStats();
+    PoolAllocator::Stats threadStats{};
+
+    std::thread thread([&threadStats]() {
+        std::vector<Ptr<PooledBase>> objects;
+        for (std::size_t i = 0; i < 100; ++i)
+        {
+            objects.push_back(Create<PooledDerived>());
+        }
+        objects.clear();
+        threadStats = PoolAllocator::GetStats();
+    });
+    thread.join();
+
+    NS_TEST_EXPECT_MSG_EQ(threadStats.allocations, 100, "Unexpected number of allocations");
+    NS_TEST_EXPECT_MSG_EQ(threadStats.cachedBlocks, 100, "The released blocks should be cached");
+
+    const auto after = PoolAllocator::GetStats();
+    NS_TEST_EXPECT_MSG_EQ(after.allocations,
+                          before.allocations,
+                          "The statistics of the main thread should not change");
+    NS_TEST_EXPECT_MSG_EQ(after.cachedBlocks,
+                          before.cachedBlocks,
+                          "The free lists of the main thread should not change");
+}
+
+/**
+ * \ingroup pool-allocator-tests
+ * Check that the storage of the simulation events is recycled.
+ */
+class PooledEventTestCase : public TestCase
+{
+  public:
+    PooledEventTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Schedule the next event of the chain, while there are events left.
+     * \param count the number of events left to schedule
+     * \param arg an argument bound to the event
+     */
+    void Chain(uint32_t count, uint64_t arg);
+};
+
+PooledEventTestCase::PooledEventTestCase()
+    : TestCase("Check recycling of the storage of simulation events")
+{
+}
+
+void
+PooledEventTestCase::Chain(uint32_t count, uint64_t arg)
+{
+    if (count > 0)
+    {
+        // the event being scheduled is released to the pool after this event is executed,
+        // hence it cannot reuse the storage of this event, which is only released after this
+        // function returns; schedule and cancel an event of the same type to check that its
+        // storage is recycled by a later event
+        EventId cancelled =
+            Simulator::Schedule(MicroSeconds(1), &PooledEventTestCase::Chain, this, 0, arg);
+        cancelled.Remove();
+        Simulator::Schedule(MicroSeconds(1), &PooledEventTestCase::Chain, this, count - 1, arg);
+    }
+}
+
+void
+PooledEventTestCase::DoRun()
+{
+    const uint32_t nEvents = 100;
+    Simulator::Schedule(MicroSeconds(1), &PooledEventTestCase::Chain, this, nEvents, 0);
+    Simulator::Run();
+
+    const auto before = PoolAllocator::GetStats();
+    Simulator::Schedule(MicroSeconds(1), &PooledEventTestCase::Chain, this, nEvents, 0);
+    Simulator::Run();
+    const auto after = PoolAllocator::GetStats();
+    Simulator::Destroy();
+
+    // each call to Chain() (but the last one) schedules two events
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(after.allocations - before.allocations,
+                                2 * nEvents + 1,
+                                "Events were not allocated through the pool allocator");
+    // in steady state, all the events are served from the free lists
+    NS_TEST_EXPECT_MSG_EQ(after.recycled - before.recycled,
+                          after.allocations - before.allocations,
+                          "The storage of the events was not recycled");
+}
+
+/**
+ * \ingroup pool-allocator-tests
+ * Test suite for the pool allocator
+ */
+class PoolAllocatorTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    PoolAllocatorTestSuite()
+        : TestSuite("pool-allocator")
+    {
+        AddTestCase(new PoolAllocatorTestCase());
+        AddTestCase(new PoolAllocatorThreadTestCase());
+        AddTestCase(new PooledEventTestCase());
+    }
+};
+
+/**
+ * \ingroup pool-allocator-tests
+ * PoolAllocatorTestSuite instance variable.
+ */
+static PoolAllocatorTestSuite g_poolAllocatorTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
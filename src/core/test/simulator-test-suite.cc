@@ -17,12 +17,25 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/calendar-scheduler.h"
+#include "ns3/enum.h"
+#include "ns3/event-profiler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
+#include "ns3/multithreaded-simulator-impl.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <random>
+#include <tuple>
+#include <vector>
 
 using namespace ns3;
 
@@ -707,6 +720,464 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that a Scheduler returns the same sequence of events as the MapScheduler.
+ *
+ * Events are inserted, removed and dequeued in a random order, with delays drawn
+ * from different distributions: uniform, bursty (many events at the same time or
+ * a few slots apart, mixed with far future timers) and all events at the same time.
+ */
+class SchedulerConsistencyTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param schedulerFactory Factory of the Scheduler to check.
+     */
+    SchedulerConsistencyTestCase(ObjectFactory schedulerFactory);
+
+  private:
+    void DoRun() override;
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerConsistencyTestCase::SchedulerConsistencyTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check consistency of " + schedulerFactory.GetTypeId().GetName() +
+               " with MapScheduler"),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerConsistencyTestCase::DoRun()
+{
+    for (uint8_t pattern = 0; pattern < 3; pattern++)
+    {
+        auto scheduler = m_schedulerFactory.Create<Scheduler>();
+        auto reference = CreateObject<MapScheduler>();
+        std::mt19937_64 rng(pattern);
+        uint64_t now = 0;
+        uint32_t uid = 0;
+        std::vector<Scheduler::Event> events; // events that may still be in the queue
+        std::vector<bool> removed;            // whether an event was removed, by uid
+
+        for (uint32_t step = 0; step < 100000; step++)
+        {
+            auto op = rng() % 10;
+            if (op < 5 || reference->IsEmpty())
+            {
+                uint64_t delay = 0;
+                if (pattern == 0)
+                {
+                    delay = rng() % 1000;
+                }
+                else if (pattern == 1)
+                {
+                    delay = (rng() % 8 == 0) ? 100000000 : (rng() % 4) * 9000;
+                }
+                Scheduler::Event ev;
+                ev.impl = nullptr;
+                ev.key = {now + delay, uid++, 0};
+                scheduler->Insert(ev);
+                reference->Insert(ev);
+                events.push_back(ev);
+                removed.push_back(false);
+            }
+            else if (op < 9)
+            {
+                NS_TEST_ASSERT_MSG_EQ(scheduler->PeekNext().key.m_uid,
+                                      reference->PeekNext().key.m_uid,
+                                      "Unexpected next event at step " << step);
+                auto ev = scheduler->RemoveNext();
+                auto expected = reference->RemoveNext();
+                NS_TEST_ASSERT_MSG_EQ(ev.key.m_uid,
+                                      expected.key.m_uid,
+                                      "Unexpected event removed at step " << step);
+                now = ev.key.m_ts;
+                removed[ev.key.m_uid] = true;
+            }
+            else
+            {
+                auto i = rng() % events.size();
+                auto ev = events[i];
+                events[i] = events.back();
+                events.pop_back();
+                if (!removed[ev.key.m_uid])
+                {
+                    scheduler->Remove(ev);
+                    reference->Remove(ev);
+                    removed[ev.key.m_uid] = true;
+                }
+            }
+        }
+
+        while (!reference->IsEmpty())
+        {
+            NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), false, "Scheduler unexpectedly empty");
+            NS_TEST_ASSERT_MSG_EQ(scheduler->RemoveNext().key.m_uid,
+                                  reference->RemoveNext().key.m_uid,
+                                  "Unexpected event removed while draining");
+        }
+        NS_TEST_EXPECT_MSG_EQ(scheduler->IsEmpty(), true, "Scheduler not empty");
+    }
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that the MultithreadedSimulatorImpl executes the same events
+ * as the DefaultSimulatorImpl.
+ *
+ * Every node (i.e., context) periodically sends messages to other nodes,
+ * with a delay not smaller than the lookahead, and some of the received
+ * messages are forwarded to another node. The messages received by every
+ * node are compared.
+ */
+class MultithreadedSimulatorTestCase : public TestCase
+{
+  public:
+    MultithreadedSimulatorTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// A received message: receive timestamp, context, sender and sequence number
+    using Message = std::tuple<int64_t, uint32_t, uint32_t, uint32_t>;
+
+    /**
+     * Run the simulation with the given simulator implementation.
+     *
+     * \param simulatorType The simulator implementation type.
+     * \param threads The number of threads of the MultithreadedSimulatorImpl.
+     * \return The messages received by every node, sorted.
+     */
+    std::vector<std::vector<Message>> RunSimulation(const std::string& simulatorType,
+                                                    uint32_t threads);
+    /**
+     * Send a message to another node and schedule the next transmission.
+     *
+     * \param node The sending node.
+     */
+    void Send(uint32_t node);
+    /**
+     * Receive a message.
+     *
+     * \param node The receiving node.
+     * \param sender The sending node.
+     * \param seq The sequence number of the message.
+     */
+    void Receive(uint32_t node, uint32_t sender, uint32_t seq);
+
+    /// Number of nodes
+    static constexpr uint32_t N_NODES = 16;
+    /// Number of messages sent by every node
+    static constexpr uint32_t N_MESSAGES = 200;
+    /// Sequence number offset of the forwarded messages
+    static constexpr uint32_t FORWARDED = 10000;
+
+    Time m_lookahead;                             //!< The minimum delay of the messages.
+    std::vector<uint32_t> m_sent;                 //!< Number of messages sent, per node.
+    std::vector<std::vector<Message>> m_received; //!< Messages received, per node.
+};
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase()
+    : TestCase("Check that the MultithreadedSimulatorImpl executes the same events as the "
+               "DefaultSimulatorImpl"),
+      m_lookahead(MicroSeconds(10))
+{
+}
+
+void
+MultithreadedSimulatorTestCase::Send(uint32_t node)
+{
+    uint32_t seq = m_sent[node]++;
+    uint32_t dst = (node * 7 + seq) % N_NODES;
+    if (dst == node)
+    {
+        dst = (dst + 1) % N_NODES;
+    }
+    Time delay = m_lookahead + NanoSeconds((node * 13 + seq * 7) % 1000);
+    Simulator::ScheduleWithContext(dst,
+                                   delay,
+                                   &MultithreadedSimulatorTestCase::Receive,
+                                   this,
+                                   dst,
+                                   node,
+                                   seq);
+    if (seq + 1 < N_MESSAGES)
+    {
+        Simulator::Schedule(MicroSeconds(1 + (seq * node) % 5),
+                            &MultithreadedSimulatorTestCase::Send,
+                            this,
+                            node);
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::Receive(uint32_t node, uint32_t sender, uint32_t seq)
+{
+    m_received[node].emplace_back(Simulator::Now().GetTimeStep(),
+                                  Simulator::GetContext(),
+                                  sender,
+                                  seq);
+    if (seq < FORWARDED && seq % 4 == 0)
+    {
+        uint32_t dst = (node + 1) % N_NODES;
+        Simulator::ScheduleWithContext(dst,
+                                       m_lookahead,
+                                       &MultithreadedSimulatorTestCase::Receive,
+                                       this,
+                                       dst,
+                                       node,
+                                       seq + FORWARDED);
+    }
+}
+
+std::vector<std::vector<MultithreadedSimulatorTestCase::Message>>
+MultithreadedSimulatorTestCase::RunSimulation(const std::string& simulatorType, uint32_t threads)
+{
+    ObjectFactory factory(simulatorType);
+    if (threads > 0)
+    {
+        factory.Set("ThreadCount", UintegerValue(threads));
+        factory.Set("Lookahead", TimeValue(m_lookahead));
+    }
+    Simulator::SetImplementation(factory.Create<SimulatorImpl>());
+
+    m_sent.assign(N_NODES, 0);
+    m_received.assign(N_NODES, {});
+    for (uint32_t node = 0; node < N_NODES; node++)
+    {
+        Simulator::ScheduleWithContext(node,
+                                       NanoSeconds(node),
+                                       &MultithreadedSimulatorTestCase::Send,
+                                       this,
+                                       node);
+    }
+    Simulator::Run();
+    if (threads > 0)
+    {
+        auto impl = DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+        NS_TEST_EXPECT_MSG_EQ(impl->GetNPartitions(), threads, "Unexpected number of partitions");
+    }
+    Simulator::Destroy();
+
+    for (auto& received : m_received)
+    {
+        std::sort(received.begin(), received.end());
+    }
+    return m_received;
+}
+
+void
+MultithreadedSimulatorTestCase::DoRun()
+{
+    auto expected = RunSimulation("ns3::DefaultSimulatorImpl", 0);
+
+    for (uint32_t threads : {1, 3, 4})
+    {
+        auto received = RunSimulation("ns3::MultithreadedSimulatorImpl", threads);
+        for (uint32_t node = 0; node < N_NODES; node++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(received[node].size(),
+                                  expected[node].size(),
+                                  "Unexpected number of messages received by node "
+                                      << node << " with " << threads << " threads");
+            NS_TEST_EXPECT_MSG_EQ((received[node] == expected[node]),
+                                  true,
+                                  "Unexpected messages received by node "
+                                      << node << " with " << threads << " threads");
+        }
+    }
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that Simulator::Stop() stops all the partitions of the
+ * MultithreadedSimulatorImpl at the stop time.
+ */
+class MultithreadedSimulatorStopTestCase : public TestCase
+{
+  public:
+    MultithreadedSimulatorStopTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record the execution of an event and schedule the next one.
+     *
+     * \param node The node executing the event.
+     */
+    void Tick(uint32_t node);
+
+    /// Number of nodes
+    static constexpr uint32_t N_NODES = 8;
+
+    std::vector<Time> m_last; //!< Timestamp of the last event executed, per node.
+};
+
+MultithreadedSimulatorStopTestCase::MultithreadedSimulatorStopTestCase()
+    : TestCase("Check that Simulator::Stop() stops all the partitions of the "
+               "MultithreadedSimulatorImpl")
+{
+}
+
+void
+MultithreadedSimulatorStopTestCase::Tick(uint32_t node)
+{
+    m_last[node] = Simulator::Now();
+    Simulator::Schedule(NanoSeconds(100), &MultithreadedSimulatorStopTestCase::Tick, this, node);
+}
+
+void
+MultithreadedSimulatorStopTestCase::DoRun()
+{
+    ObjectFactory factory("ns3::MultithreadedSimulatorImpl");
+    factory.Set("ThreadCount", UintegerValue(4));
+    factory.Set("Lookahead", TimeValue(MicroSeconds(10)));
+    Simulator::SetImplementation(factory.Create<SimulatorImpl>());
+
+    m_last.assign(N_NODES, Time(0));
+    for (uint32_t node = 0; node < N_NODES; node++)
+    {
+        Simulator::ScheduleWithContext(node,
+                                       NanoSeconds(node),
+                                       &MultithreadedSimulatorStopTestCase::Tick,
+                                       this,
+                                       node);
+    }
+    // the first stop event is cancelled, the second one is not in the first window
+    EventId cancelled = Simulator::Stop(MicroSeconds(5));
+    Simulator::Stop(MicroSeconds(25));
+    cancelled.Cancel();
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MicroSeconds(25), "Unexpected stop time");
+    for (uint32_t node = 0; node < N_NODES; node++)
+    {
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(m_last[node],
+                                    MicroSeconds(25) - NanoSeconds(100),
+                                    "Node " << node << " stopped before the stop time");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(m_last[node],
+                                    MicroSeconds(25),
+                                    "Node " << node << " executed events after the stop time");
+    }
+
+    // an event calling Simulator::Stop() stops the other partitions by the end of the window
+    Simulator::ScheduleWithContext(3, MicroSeconds(1), &Simulator::Stop);
+    Simulator::Run();
+    Time stop = MicroSeconds(26);
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(Simulator::Now(), stop, "Unexpected stop time");
+    for (uint32_t node = 0; node < N_NODES; node++)
+    {
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(m_last[node],
+                                    stop - NanoSeconds(100),
+                                    "Node " << node << " stopped before the stop time");
+        NS_TEST_EXPECT_MSG_LT(m_last[node],
+                              stop + MicroSeconds(10),
+                              "Node " << node << " executed events after the window");
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the event profile written by the DefaultSimulatorImpl.
+ */
+class EventProfilerTestCase : public TestCase
+{
+  public:
+    EventProfilerTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** An event without arguments. */
+    void EventA();
+    /**
+     * An event with an argument.
+     * \param value An argument.
+     */
+    void EventB(uint32_t value);
+    /** A static event. */
+    static void EventC();
+};
+
+EventProfilerTestCase::EventProfilerTestCase()
+    : TestCase("Check the event profile of the DefaultSimulatorImpl")
+{
+}
+
+void
+EventProfilerTestCase::EventA()
+{
+}
+
+void
+EventProfilerTestCase::EventB(uint32_t value)
+{
+}
+
+void
+EventProfilerTestCase::EventC()
+{
+}
+
+void
+EventProfilerTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("simulator-profile.folded");
+    ObjectFactory factory("ns3::DefaultSimulatorImpl");
+    factory.Set("ProfileFile", StringValue(filename));
+    factory.Set("ProfileWeight", EnumValue(EventProfiler::EVENT_COUNT));
+    Simulator::SetImplementation(factory.Create<SimulatorImpl>());
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Simulator::ScheduleWithContext(1, Seconds(i), &EventProfilerTestCase::EventA, this);
+        Simulator::ScheduleWithContext(2, Seconds(i), &EventProfilerTestCase::EventB, this, i);
+    }
+    Simulator::ScheduleWithContext(1, Seconds(4), &EventProfilerTestCase::EventB, this, 4U);
+    Simulator::Schedule(Seconds(5), &EventProfilerTestCase::EventC);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    // name the event types as the profiler does
+    auto getTypeName = [](EventImpl* event) {
+        std::string name = EventProfiler::GetTypeName(typeid(*event));
+        event->Unref();
+        return name;
+    };
+    std::string a = getTypeName(MakeEvent(&EventProfilerTestCase::EventA, this));
+    std::string b = getTypeName(MakeEvent(&EventProfilerTestCase::EventB, this, 0U));
+    std::string c = getTypeName(MakeEvent(&EventProfilerTestCase::EventC));
+    NS_TEST_EXPECT_MSG_NE(a, b, "Events bound to different functions have the same type");
+    NS_TEST_EXPECT_MSG_EQ(a.find("MakeEvent"), std::string::npos, "Event type not simplified");
+
+    std::map<std::string, uint64_t> expected{{a + ";node 1", 3},
+                                             {b + ";node 2", 3},
+                                             {b + ";node 1", 1},
+                                             {c + ";no context", 1}};
+    std::map<std::string, uint64_t> profile;
+    std::ifstream file(filename);
+    NS_TEST_ASSERT_MSG_EQ(file.is_open(), true, "The event profile was not written");
+    std::string line;
+    while (std::getline(file, line))
+    {
+        auto space = line.rfind(' ');
+        NS_TEST_ASSERT_MSG_NE(space, std::string::npos, "Invalid line: " << line);
+        profile[line.substr(0, space)] = std::stoull(line.substr(space + 1));
+    }
+    NS_TEST_EXPECT_MSG_EQ((profile == expected), true, "Unexpected event profile");
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -730,6 +1201,12 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        AddTestCase(new SchedulerConsistencyTestCase(factory), TestCase::QUICK);
+        AddTestCase(new MultithreadedSimulatorTestCase(), TestCase::QUICK);
+        AddTestCase(new MultithreadedSimulatorStopTestCase(), TestCase::QUICK);
+        AddTestCase(new EventProfilerTestCase(), TestCase::QUICK);
     }
 };
 
@@ -18,6 +18,8 @@
 #include "ns3/test.h"
 #include "ns3/traced-callback.h"
 
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -133,6 +135,136 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * \ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check the order in which the callbacks are invoked.
+ */
+class TracedCallbackOrderTestCase : public TestCase
+{
+  public:
+    TracedCallbackOrderTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record the invocation of a callback.
+     * \param id The identifier of the callback.
+     * \param value The traced value.
+     */
+    void Record(uint32_t id, uint32_t value);
+    /**
+     * Connect the callback with identifier 9 to the traced callback.
+     * \param value The traced value.
+     */
+    void ConnectAnother(uint32_t value);
+    /**
+     * Record the invocation of the callback with the given identifier and
+     * disconnect it from the traced callback.
+     * \param id The identifier of the callback.
+     * \param value The traced value.
+     */
+    void DisconnectSelf(uint32_t id, uint32_t value);
+
+    TracedCallback<uint32_t> m_trace; //!< The traced callback.
+    std::vector<uint32_t> m_calls;    //!< The identifiers of the invoked callbacks.
+};
+
+TracedCallbackOrderTestCase::TracedCallbackOrderTestCase()
+    : TestCase("Check the order in which the TracedCallback callbacks are invoked")
+{
+}
+
+void
+TracedCallbackOrderTestCase::Record(uint32_t id, uint32_t /* value */)
+{
+    m_calls.push_back(id);
+}
+
+void
+TracedCallbackOrderTestCase::ConnectAnother(uint32_t /* value */)
+{
+    m_trace.ConnectWithoutContext(MakeCallback(&TracedCallbackOrderTestCase::Record, this).Bind(9));
+}
+
+void
+TracedCallbackOrderTestCase::DisconnectSelf(uint32_t id, uint32_t /* value */)
+{
+    m_calls.push_back(id);
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&TracedCallbackOrderTestCase::DisconnectSelf, this).Bind(id));
+}
+
+void
+TracedCallbackOrderTestCase::DoRun()
+{
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "TracedCallback not empty");
+    m_trace(0);
+
+    std::vector<Callback<void, uint32_t>> callbacks;
+    for (uint32_t id = 0; id < 4; id++)
+    {
+        callbacks.push_back(MakeCallback(&TracedCallbackOrderTestCase::Record, this).Bind(id));
+        m_trace.ConnectWithoutContext(callbacks.back());
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), false, "TracedCallback empty");
+    m_trace(0);
+    NS_TEST_EXPECT_MSG_EQ((m_calls == std::vector<uint32_t>{0, 1, 2, 3}),
+                          true,
+                          "Callbacks not invoked in the order they were connected");
+
+    // disconnecting the first callback makes the second one the first
+    m_calls.clear();
+    m_trace.DisconnectWithoutContext(callbacks[0]);
+    m_trace.DisconnectWithoutContext(callbacks[2]);
+    m_trace(0);
+    NS_TEST_EXPECT_MSG_EQ((m_calls == std::vector<uint32_t>{1, 3}),
+                          true,
+                          "Unexpected callbacks invoked after disconnection");
+
+    // a callback connected by an invoked callback is invoked, too
+    m_calls.clear();
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&TracedCallbackOrderTestCase::ConnectAnother, this));
+    m_trace(0);
+    NS_TEST_EXPECT_MSG_EQ((m_calls == std::vector<uint32_t>{1, 3, 9}),
+                          true,
+                          "Callback connected during the invocation not invoked");
+
+    m_trace.DisconnectWithoutContext(callbacks[1]);
+    m_trace.DisconnectWithoutContext(callbacks[3]);
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&TracedCallbackOrderTestCase::ConnectAnother, this));
+    m_calls.clear();
+    m_trace(0);
+    NS_TEST_EXPECT_MSG_EQ((m_calls == std::vector<uint32_t>{9}),
+                          true,
+                          "Unexpected callbacks invoked after disconnection");
+
+    // callbacks disconnecting themselves while being invoked (both the first callback
+    // and a following one) do not prevent the next callbacks from being invoked
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&TracedCallbackOrderTestCase::Record, this).Bind(9));
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "TracedCallback not empty");
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&TracedCallbackOrderTestCase::DisconnectSelf, this).Bind(10));
+    m_trace.ConnectWithoutContext(callbacks[1]);
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&TracedCallbackOrderTestCase::DisconnectSelf, this).Bind(11));
+    m_trace.ConnectWithoutContext(callbacks[2]);
+    m_calls.clear();
+    m_trace(0);
+    NS_TEST_EXPECT_MSG_EQ((m_calls == std::vector<uint32_t>{10, 1, 11, 2}),
+                          true,
+                          "Callbacks skipped after a callback disconnected itself");
+    m_calls.clear();
+    m_trace(0);
+    NS_TEST_EXPECT_MSG_EQ((m_calls == std::vector<uint32_t>{1, 2}),
+                          true,
+                          "Callbacks that disconnected themselves invoked again");
+}
+
 /**
  * \ingroup tracedcallback-tests
  *
@@ -148,6 +280,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::QUICK);
+    AddTestCase(new TracedCallbackOrderTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite
@@ -627,6 +627,12 @@ DistributedSimulatorImpl::GetContext() const
     return m_currentContext;
 }
 
+void
+DistributedSimulatorImpl::SetContext(uint32_t context)
+{
+    m_currentContext = context;
+}
+
 uint64_t
 DistributedSimulatorImpl::GetEventCount() const
 {
@@ -550,6 +550,12 @@ NullMessageSimulatorImpl::GetContext() const
     return m_currentContext;
 }
 
+void
+NullMessageSimulatorImpl::SetContext(uint32_t context)
+{
+    m_currentContext = context;
+}
+
 uint64_t
 NullMessageSimulatorImpl::GetEventCount() const
 {
@@ -20,6 +20,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/pool-allocator.h"
 
 #define LOG_INTERNAL_STATE(y)                                                                      \
     NS_LOG_LOGIC(y << "start=" << m_start << ", end=" << m_end                                     \
@@ -54,7 +55,7 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
-uint32_t Buffer::g_recommendedStart = 0;
+thread_local uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -63,7 +64,8 @@ uint32_t Buffer::g_recommendedStart = 0;
  *    on-demand when the first buffer is created)
  *  - initialized means that the free list exists and is valid
  *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
+ *    (or the thread_local destructors of the thread) have run so, the free
+ *    list has been cleared from its content
  * The key is that in destroyed state, we are careful not re-create it
  * which is a typical weakness of lazy evaluation schemes which use
  * '0' as a special value to indicate both un-initialized and destroyed.
@@ -79,9 +81,9 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+thread_local uint32_t Buffer::g_maxSize = 0;
+thread_local Buffer::FreeList* Buffer::g_freeList = nullptr;
+thread_local Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor()
 {
@@ -97,12 +99,25 @@ Buffer::LocalStaticDestructor::~LocalStaticDestructor()
     }
 }
 
+void
+Buffer::CreateFreeList()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    g_freeList = new Buffer::FreeList();
+    // make sure that the destructor releasing the free list runs when the thread exits
+    g_localStaticDestructor.used = true;
+}
+
 void
 Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
+    if (IS_UNINITIALIZED(g_freeList))
+    {
+        // the data was created by another thread
+        CreateFreeList();
+    }
     g_maxSize = std::max(g_maxSize, data->m_size);
     /* feed into free list */
     if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
@@ -123,7 +138,7 @@ Buffer::Create(uint32_t dataSize)
     /* try to find a buffer correctly sized. */
     if (IS_UNINITIALIZED(g_freeList))
     {
-        g_freeList = new Buffer::FreeList();
+        CreateFreeList();
     }
     else if (IS_INITIALIZED(g_freeList))
     {
@@ -173,8 +188,10 @@ Buffer::Allocate(uint32_t reqSize)
     NS_ASSERT(reqSize >= 1);
     reqSize += ALLOC_OVER_PROVISION;
     uint32_t size = reqSize - 1 + sizeof(Buffer::Data);
-    auto b = new uint8_t[size];
-    auto data = reinterpret_cast<Buffer::Data*>(b);
+    // the data of the buffers holding only headers and trailers are small
+    // enough to be recycled by the PoolAllocator, while the largest buffers
+    // are kept in the free list above
+    auto data = static_cast<Buffer::Data*>(PoolAllocator::Allocate(size));
     data->m_size = reqSize;
     data->m_count = 1;
     return data;
@@ -185,8 +202,7 @@ Buffer::Deallocate(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    auto buf = reinterpret_cast<uint8_t*>(data);
-    delete[] buf;
+    PoolAllocator::Deallocate(data, data->m_size - 1 + sizeof(Buffer::Data));
 }
 
 Buffer::Buffer()
@@ -407,15 +423,45 @@ Buffer::AddAtEnd(const Buffer& o)
 {
     NS_LOG_FUNCTION(this << &o);
 
-    if (m_data->m_count == 1 && (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
-        m_end == m_data->m_dirtyEnd && o.m_start == o.m_zeroAreaStart &&
-        o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
+    if (GetSize() == 0)
+    {
+        /* nothing to keep from this buffer: share the data of the other one */
+        *this = o;
+        return;
+    }
+
+    if ((m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
+        o.m_start == o.m_zeroAreaStart && o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
     {
         /**
          * This is an optimization which kicks in when
          * we attempt to aggregate two buffers which contain
          * adjacent zero areas.
          */
+        if (m_data->m_count != 1 || m_end != m_data->m_dirtyEnd)
+        {
+            /* The data is shared, e.g., by the fragments of a packet:
+             * copy the bytes of this buffer to private data. Only the
+             * bytes outside of the zero area are copied.
+             */
+            uint32_t internalSize = GetInternalSize();
+            Buffer::Data* newData = Buffer::Create(internalSize);
+            memcpy(newData->m_data, m_data->m_data + m_start, internalSize);
+            m_data->m_count--;
+            if (m_data->m_count == 0)
+            {
+                Buffer::Recycle(m_data);
+            }
+            m_data = newData;
+
+            int32_t delta = -m_start;
+            m_zeroAreaStart += delta;
+            m_zeroAreaEnd += delta;
+            m_end += delta;
+            m_start += delta;
+            m_data->m_dirtyStart = m_start;
+            m_data->m_dirtyEnd = m_end;
+        }
         if (m_zeroAreaStart == m_zeroAreaEnd)
         {
             m_zeroAreaStart = m_end;
@@ -435,7 +481,25 @@ Buffer::AddAtEnd(const Buffer& o)
         return;
     }
 
-    *this = CreateFullCopy();
+    /* A buffer holds a single zero area: keep the largest of the two zero
+     * areas and write the bytes of the other buffer, including its zero
+     * area, next to it.
+     */
+    if (m_data != o.m_data &&
+        o.m_zeroAreaEnd - o.m_zeroAreaStart > m_zeroAreaEnd - m_zeroAreaStart)
+    {
+        Buffer tmp = o;
+        tmp.AddAtStart(GetSize());
+        tmp.Begin().Write(Begin(), End());
+        *this = tmp;
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
+    if (m_data == o.m_data)
+    {
+        *this = CreateFullCopy();
+    }
     AddAtEnd(o.GetSize());
     Buffer::Iterator destStart = End();
     destStart.Prev(o.GetSize());
@@ -838,27 +902,32 @@ Buffer::Iterator::Write(Iterator start, Iterator end)
     NS_ASSERT(m_data != start.m_data);
     uint32_t size = end.m_current - start.m_current;
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    // the destination bytes are either all before or all after the zero area
+    uint8_t* to = &m_data[m_current];
+    if (m_current >= m_zeroEnd)
+    {
+        to -= m_zeroEnd - m_zeroStart;
+    }
+    m_current += size;
     if (start.m_current <= start.m_zeroStart)
     {
         uint32_t toCopy = std::min(size, start.m_zeroStart - start.m_current);
-        memcpy(&m_data[m_current], &start.m_data[start.m_current], toCopy);
+        memcpy(to, &start.m_data[start.m_current], toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     if (start.m_current <= start.m_zeroEnd)
     {
         uint32_t toCopy = std::min(size, start.m_zeroEnd - start.m_current);
-        memset(&m_data[m_current], 0, toCopy);
+        memset(to, 0, toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
     uint8_t* from = &start.m_data[start.m_current - (start.m_zeroEnd - start.m_zeroStart)];
-    uint8_t* to = &m_data[m_current];
     memcpy(to, from, toCopy);
-    m_current += toCopy;
 }
 
 void
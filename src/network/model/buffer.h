@@ -525,7 +525,11 @@ class Buffer
     /**
      * \param o the buffer to append to the end of this buffer.
      *
-     * Add bytes at the end of the Buffer.
+     * Add bytes at the end of the Buffer. The result keeps the
+     * largest of the two zero areas virtual, and merges them when
+     * they are adjacent, e.g., when reassembling the fragments of a
+     * payload, so that the cost of the concatenation does not depend
+     * on the size of the payload.
      * Any call to this method invalidates any Iterator
      * pointing to this Buffer.
      */
@@ -767,9 +771,9 @@ class Buffer
     /**
      * location in a newly-allocated buffer where you should start
      * writing data. i.e., m_start should be initialized to this
-     * value.
+     * value. Every thread has its own value.
      */
-    static uint32_t g_recommendedStart;
+    static thread_local uint32_t g_recommendedStart;
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -796,15 +800,21 @@ class Buffer
     /// Container for buffer data
     typedef std::vector<Buffer::Data*> FreeList;
 
-    /// Local static destructor structure
+    /// Create the free list of the calling thread
+    static void CreateFreeList();
+
+    /// Local static destructor structure, releasing the free list of a thread when it exits
     struct LocalStaticDestructor
     {
         ~LocalStaticDestructor();
+        bool used{false}; //!< Whether the free list of the thread was created
     };
 
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
+    // Every thread has its own free list, so that the threads executing the
+    // partitions of a parallel simulation do not share it
+    static thread_local uint32_t g_maxSize;                            //!< Max observed data size
+    static thread_local FreeList* g_freeList;                          //!< Buffer data container
+    static thread_local LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
 #endif
 };
 
@@ -19,6 +19,7 @@
 #include "byte-tag-list.h"
 
 #include "ns3/log.h"
+#include "ns3/pool-allocator.h"
 
 #include <cstring>
 #include <limits>
@@ -48,30 +49,48 @@ struct ByteTagListData
     uint8_t data[4]; //!< data
 };
 
+/**
+ * \ingroup packet
+ *
+ * \brief Release the memory of a struct ByteTagListData to the PoolAllocator.
+ *
+ * \param [in] data The data to release.
+ */
+static void
+Free(ByteTagListData* data)
+{
+    PoolAllocator::Deallocate(data, data->size + sizeof(ByteTagListData) - 4);
+}
+
 #ifdef USE_FREE_LIST
 /**
  * \ingroup packet
  *
  * \brief Container class for struct ByteTagListData
  *
- * Internal use only.
+ * Internal use only. Every thread has its own free list, which is released
+ * when the thread exits.
  */
-static class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
+static thread_local class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
 {
   public:
     ~ByteTagListDataFreeList();
 } g_freeList; //!< Container for struct ByteTagListData
 
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+static thread_local uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+
+/// Whether the free list of the calling thread was destroyed (i.e., the thread is exiting)
+static thread_local bool g_freeListDestroyed = false;
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList()
 {
     NS_LOG_FUNCTION(this);
     for (auto i = begin(); i != end(); i++)
     {
-        auto buffer = (uint8_t*)(*i);
-        delete[] buffer;
+        Free(*i);
     }
+    clear();
+    g_freeListDestroyed = true;
 }
 #endif /* USE_FREE_LIST */
 
@@ -355,7 +374,7 @@ ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    while (!g_freeList.empty())
+    while (!g_freeListDestroyed && !g_freeList.empty())
     {
         ByteTagListData* data = g_freeList.back();
         g_freeList.pop_back();
@@ -366,11 +385,12 @@ ByteTagList::Allocate(uint32_t size)
             data->dirty = 0;
             return data;
         }
-        auto buffer = (uint8_t*)data;
-        delete[] buffer;
+        Free(data);
     }
-    auto buffer = new uint8_t[std::max(size, g_maxSize) + sizeof(ByteTagListData) - 4];
-    auto data = (ByteTagListData*)buffer;
+    // the size is the capacity of the data, so that the list can grow in place
+    size = std::max(size, g_maxSize);
+    auto data = static_cast<ByteTagListData*>(
+        PoolAllocator::Allocate(size + sizeof(ByteTagListData) - 4));
     data->count = 1;
     data->size = size;
     data->dirty = 0;
@@ -389,10 +409,9 @@ ByteTagList::Deallocate(ByteTagListData* data)
     data->count--;
     if (data->count == 0)
     {
-        if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
+        if (g_freeListDestroyed || g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
         {
-            auto buffer = (uint8_t*)data;
-            delete[] buffer;
+            Free(data);
         }
         else
         {
@@ -407,8 +426,8 @@ ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    uint8_t* buffer = new uint8_t[size + sizeof(ByteTagListData) - 4];
-    ByteTagListData* data = (ByteTagListData*)buffer;
+    auto data = static_cast<ByteTagListData*>(
+        PoolAllocator::Allocate(size + sizeof(ByteTagListData) - 4));
     data->count = 1;
     data->size = size;
     data->dirty = 0;
@@ -419,15 +438,14 @@ void
 ByteTagList::Deallocate(ByteTagListData* data)
 {
     NS_LOG_FUNCTION(this << data);
-    if (data == 0)
+    if (data == nullptr)
     {
         return;
     }
     data->count--;
     if (data->count == 0)
     {
-        uint8_t* buffer = (uint8_t*)data;
-        delete[] buffer;
+        Free(data);
     }
 }
 
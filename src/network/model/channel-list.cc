@@ -247,4 +247,20 @@ ChannelList::GetNChannels()
     return ChannelListPriv::Get()->GetNChannels();
 }
 
+Time
+ChannelList::GetMinimumDelay()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    if (Begin() == End())
+    {
+        return Time(0);
+    }
+    Time minimumDelay = Time::Max();
+    for (auto i = Begin(); i != End(); ++i)
+    {
+        minimumDelay = Min(minimumDelay, (*i)->GetMinimumDelay());
+    }
+    return minimumDelay;
+}
+
 } // namespace ns3
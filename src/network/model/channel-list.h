@@ -18,6 +18,7 @@
 #ifndef CHANNEL_LIST_H
 #define CHANNEL_LIST_H
 
+#include "ns3/nstime.h"
 #include "ns3/ptr.h"
 
 #include <vector>
@@ -68,6 +69,15 @@ class ChannelList
      * \returns the number of channels currently in the list.
      */
     static uint32_t GetNChannels();
+    /**
+     * \returns the smallest minimum delay of the channels currently in the
+     *          list (see Channel::GetMinimumDelay()), or zero if the list is empty.
+     *
+     * This is the lookahead of parallel simulators, such as the
+     * MultithreadedSimulatorImpl, in which every node may be executed by a
+     * different thread.
+     */
+    static Time GetMinimumDelay();
 };
 
 } // namespace ns3
@@ -16,6 +16,7 @@
 #ifndef NS3_CHANNEL_H
 #define NS3_CHANNEL_H
 
+#include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
@@ -75,6 +76,21 @@ class Channel : public Object
      */
     virtual Ptr<NetDevice> GetDevice(std::size_t i) const = 0;
 
+    /**
+     * \returns the minimum delay between the transmission of a packet on this
+     *          channel and the reception of the packet by another NetDevice
+     *          attached to this channel.
+     *
+     * The minimum delay of the channels connecting the nodes is the lookahead
+     * of parallel simulators (see MultithreadedSimulatorImpl). The default
+     * implementation returns zero, i.e., a channel does not declare any
+     * minimum delay unless this method is overridden. A channel must only
+     * declare a minimum delay if the devices attached to it can be executed
+     * by different threads, i.e., if it shares neither packets nor the
+     * reference counts of the receiving devices among them (see SimpleChannel).
+     */
+    virtual Time GetMinimumDelay() const;
+
   private:
     uint32_t m_id; //!< Channel id for this channel
 };
@@ -25,6 +25,7 @@
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/pool-allocator.h"
 
 #include <list>
 #include <utility>
@@ -36,20 +37,9 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
-bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
-uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
-
-PacketMetadata::DataFreeList::~DataFreeList()
-{
-    NS_LOG_FUNCTION(this);
-    for (auto i = begin(); i != end(); i++)
-    {
-        PacketMetadata::Deallocate(*i);
-    }
-    PacketMetadata::m_enable = false;
-}
+std::atomic<bool> PacketMetadata::m_metadataSkipped = false;
+thread_local uint32_t PacketMetadata::m_maxSize = 0;
+std::atomic<uint16_t> PacketMetadata::m_chunkUid = 0;
 
 void
 PacketMetadata::Enable()
@@ -572,19 +562,7 @@ PacketMetadata::Create(uint32_t size)
     {
         m_maxSize = size;
     }
-    while (!m_freeList.empty())
-    {
-        PacketMetadata::Data* data = m_freeList.back();
-        m_freeList.pop_back();
-        if (data->m_size >= size)
-        {
-            NS_LOG_LOGIC("create found size=" << data->m_size);
-            data->m_count = 1;
-            return data;
-        }
-        NS_LOG_LOGIC("create dealloc size=" << data->m_size);
-        PacketMetadata::Deallocate(data);
-    }
+    // the released data are recycled by the PoolAllocator
     NS_LOG_LOGIC("create alloc size=" << m_maxSize);
     return PacketMetadata::Allocate(m_maxSize);
 }
@@ -593,21 +571,9 @@ void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    if (!m_enable)
-    {
-        PacketMetadata::Deallocate(data);
-        return;
-    }
-    NS_LOG_LOGIC("recycle size=" << data->m_size << ", list=" << m_freeList.size());
+    NS_LOG_LOGIC("recycle size=" << data->m_size);
     NS_ASSERT(data->m_count == 0);
-    if (m_freeList.size() > 1000 || data->m_size < m_maxSize)
-    {
-        PacketMetadata::Deallocate(data);
-    }
-    else
-    {
-        m_freeList.push_back(data);
-    }
+    PacketMetadata::Deallocate(data);
 }
 
 PacketMetadata::Data*
@@ -620,8 +586,7 @@ PacketMetadata::Allocate(uint32_t n)
         n = PACKET_METADATA_DATA_M_DATA_SIZE;
     }
     size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-    auto buf = new uint8_t[size];
-    auto data = (PacketMetadata::Data*)buf;
+    auto data = static_cast<PacketMetadata::Data*>(PoolAllocator::Allocate(size));
     data->m_size = n;
     data->m_count = 1;
     data->m_dirtyEnd = 0;
@@ -632,8 +597,8 @@ void
 PacketMetadata::Deallocate(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    auto buf = (uint8_t*)data;
-    delete[] buf;
+    PoolAllocator::Deallocate(data,
+                              sizeof(Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE);
 }
 
 PacketMetadata
@@ -661,7 +626,7 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
     NS_LOG_FUNCTION(this << uid << size);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
 
@@ -670,8 +635,7 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
     item.prev = 0xffff;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = m_chunkUid.fetch_add(1, std::memory_order_relaxed);
     uint16_t written = AddSmall(&item);
     UpdateHead(written);
 }
@@ -683,7 +647,7 @@ PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
     NS_LOG_FUNCTION(this << &header << size);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     PacketMetadata::SmallItem item;
@@ -728,7 +692,7 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
     NS_LOG_FUNCTION(this << &trailer << size);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     PacketMetadata::SmallItem item;
@@ -736,8 +700,7 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
     item.prev = m_tail;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = m_chunkUid.fetch_add(1, std::memory_order_relaxed);
     uint16_t written = AddSmall(&item);
     UpdateTail(written);
     NS_ASSERT(IsStateOk());
@@ -750,7 +713,7 @@ PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
     NS_LOG_FUNCTION(this << &trailer << size);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     PacketMetadata::SmallItem item;
@@ -794,7 +757,7 @@ PacketMetadata::AddAtEnd(const PacketMetadata& o)
     NS_LOG_FUNCTION(this << &o);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     if (m_tail == 0xffff)
@@ -870,7 +833,7 @@ PacketMetadata::AddPaddingAtEnd(uint32_t end)
     NS_LOG_FUNCTION(this << end);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
 }
@@ -881,7 +844,7 @@ PacketMetadata::RemoveAtStart(uint32_t start)
     NS_LOG_FUNCTION(this << start);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     NS_ASSERT(m_data != nullptr);
@@ -942,7 +905,7 @@ PacketMetadata::RemoveAtEnd(uint32_t end)
     NS_LOG_FUNCTION(this << end);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     NS_ASSERT(m_data != nullptr);
@@ -29,6 +29,7 @@
 
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/pool-allocator.h"
 
 #include <cstring>
 
@@ -44,14 +45,22 @@ PacketTagList::CreateTagData(size_t dataSize)
                   "Requested TagData size " << dataSize << " exceeds maximum "
                                             << std::numeric_limits<decltype(TagData::size)>::max());
 
-    void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
+    void* p = PoolAllocator::Allocate(sizeof(TagData) + dataSize - 1);
+    // The matching frees are in RemoveAll and RemoveWriter, through FreeTagData
 
     auto tag = new (p) TagData;
     tag->size = dataSize;
     return tag;
 }
 
+void
+PacketTagList::FreeTagData(TagData* tag)
+{
+    std::size_t size = sizeof(TagData) + tag->size - 1;
+    tag->~TagData();
+    PoolAllocator::Deallocate(tag, size);
+}
+
 bool
 PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 {
@@ -195,8 +204,7 @@ PacketTagList::RemoveWriter(Tag& tag,
     if (preMerge)
     {
         // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
+        FreeTagData(cur);
     }
     else
     {
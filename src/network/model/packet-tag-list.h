@@ -253,6 +253,13 @@ class PacketTagList
      */
     static TagData* CreateTagData(size_t dataSize);
 
+    /**
+     * Destruct and free a TagData struct allocated by CreateTagData().
+     *
+     * \param [in] tag The TagData object.
+     */
+    static void FreeTagData(TagData* tag);
+
     /**
      * Typedef of method function pointer for copy-on-write operations
      *
@@ -365,15 +372,13 @@ PacketTagList::RemoveAll()
         }
         if (prev != nullptr)
         {
-            prev->~TagData();
-            std::free(prev);
+            FreeTagData(prev);
         }
         prev = cur;
     }
     if (prev != nullptr)
     {
-        prev->~TagData();
-        std::free(prev);
+        FreeTagData(prev);
     }
     m_next = nullptr;
 }
@@ -24,13 +24,41 @@
 
 #include <cstdarg>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+std::atomic<uint32_t> Packet::m_globalUid = 0;
+
+namespace
+{
+
+/// Number of packet uids reserved at once by a thread
+constexpr uint32_t UID_BLOCK_SIZE = 1024;
+
+/// Next packet uid of the block reserved by the calling thread
+thread_local uint32_t g_nextUid = 0;
+
+/// End of the block of packet uids reserved by the calling thread
+thread_local uint32_t g_uidBlockEnd = 0;
+
+} // namespace
+
+uint32_t
+Packet::AllocateUid()
+{
+    if (g_nextUid == g_uidBlockEnd)
+    {
+        // the uids are unique among the threads creating packets, and the same as with a
+        // single counter if a single thread creates packets
+        g_nextUid = m_globalUid.fetch_add(UID_BLOCK_SIZE, std::memory_order_relaxed);
+        g_uidBlockEnd = g_nextUid + UID_BLOCK_SIZE;
+    }
+    return g_nextUid++;
+}
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -136,6 +164,16 @@ Packet::Copy() const
     return Ptr<Packet>(new Packet(*this), false);
 }
 
+Ptr<Packet>
+Packet::CreateFullCopy() const
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<uint8_t> buffer(GetSerializedSize());
+    [[maybe_unused]] uint32_t serialized = Serialize(buffer.data(), buffer.size());
+    NS_ASSERT(serialized);
+    return Create<Packet>(buffer.data(), buffer.size(), true);
+}
+
 Packet::Packet()
     : m_buffer(),
       m_byteTagList(),
@@ -146,10 +184,9 @@ Packet::Packet()
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | AllocateUid(), 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
@@ -186,10 +223,9 @@ Packet::Packet(uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -213,10 +249,9 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
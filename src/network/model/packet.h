@@ -31,8 +31,10 @@
 #include "ns3/assert.h"
 #include "ns3/callback.h"
 #include "ns3/mac48-address.h"
+#include "ns3/pool-allocator.h"
 #include "ns3/ptr.h"
 
+#include <atomic>
 #include <stdint.h>
 
 namespace ns3
@@ -235,7 +237,7 @@ class PacketTagIterator
  * The performance aspects copy-on-write semantics of the
  * Packet API are discussed in \ref packetperf
  */
-class Packet : public SimpleRefCount<Packet>
+class Packet : public SimpleRefCount<Packet>, public PoolAllocated
 {
   public:
     /**
@@ -459,6 +461,18 @@ class Packet : public SimpleRefCount<Packet>
      */
     Ptr<Packet> Copy() const;
 
+    /**
+     * \brief performs a full copy of the packet.
+     *
+     * \returns a copy of the packet (including its tags and metadata) that
+     * shares no dataset with the original packet.
+     *
+     * Unlike the copies returned by Copy(), which share reference-counted
+     * datasets, the full copy can be handed over to another thread, e.g., to
+     * a node executed by another partition of a MultithreadedSimulatorImpl.
+     */
+    Ptr<Packet> CreateFullCopy() const;
+
     /**
      * \brief Returns the packet's Uid.
      *
@@ -795,7 +809,12 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-    static uint32_t m_globalUid; //!< Global counter of packets Uid
+    /**
+     * \returns a new packet Uid.
+     */
+    static uint32_t AllocateUid();
+
+    static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
 };
 
 /**
@@ -846,6 +865,12 @@ std::ostream& operator<<(std::ostream& os, const Packet& packet);
  * dirty operations have been optimized for common use-cases which
  * means that most of the time, these operations will not trigger
  * data copies and will thus be still very fast.
+ *
+ * The Packet objects, as well as the storage of their byte buffer, tags
+ * and metadata, are allocated through the ns3::PoolAllocator, so that the
+ * packets created and destroyed at a high rate reuse the memory released
+ * by the previous packets of the same thread instead of hitting the
+ * global heap.
  */
 
 } // namespace ns3
@@ -22,6 +22,9 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/test.h"
 
+#include <algorithm>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -393,6 +396,93 @@ BufferTest::DoRun()
     val2 <<= 8;
     val2 |= i.ReadU8();
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
+
+    // Concatenating buffers keeps their zero area virtual: only the bytes
+    // outside of the zero area are serialized.
+    buffer = Buffer(10000);
+    buffer.AddAtStart(2);
+    i = buffer.Begin();
+    i.WriteU8(0x1);
+    i.WriteU8(0x2);
+    frag0 = buffer.CreateFragment(0, 5000);
+    frag1 = buffer.CreateFragment(5000, 5002);
+    frag0.AddAtEnd(frag1);
+    NS_TEST_EXPECT_MSG_EQ(frag0.GetSize(), 10002, "Bad size of the reassembled fragments");
+    NS_TEST_EXPECT_MSG_LT(frag0.GetSerializedSize(),
+                          100,
+                          "The zero area of the reassembled fragments is not virtual");
+    Buffer header;
+    header.AddAtStart(2);
+    i = header.Begin();
+    i.WriteU8(0x3);
+    i.WriteU8(0x4);
+    header.AddAtEnd(frag0);
+    NS_TEST_EXPECT_MSG_LT(header.GetSerializedSize(),
+                          100,
+                          "The zero area of the appended buffer is not virtual");
+    std::vector<uint8_t> data(header.GetSize(), 0xff);
+    header.CopyData(data.data(), data.size());
+    NS_TEST_EXPECT_MSG_EQ(data[0], 0x3, "Bad first byte");
+    NS_TEST_EXPECT_MSG_EQ(data[1], 0x4, "Bad second byte");
+    NS_TEST_EXPECT_MSG_EQ(data[2], 0x1, "Bad third byte");
+    NS_TEST_EXPECT_MSG_EQ(data[3], 0x2, "Bad fourth byte");
+    NS_TEST_EXPECT_MSG_EQ(std::count(data.begin(), data.end(), 0),
+                          10000,
+                          "Bad bytes in the zero area");
+
+    buffer = Buffer(100);
+    buffer.AddAtEnd(1);
+    i = buffer.End();
+    i.Prev(1);
+    i.WriteU8(0x5);
+    other = Buffer(1000);
+    other.AddAtStart(1);
+    other.Begin().WriteU8(0x6);
+    buffer.AddAtEnd(other);
+    NS_TEST_EXPECT_MSG_EQ(buffer.GetSize(), 1102, "Bad size of the concatenated buffers");
+    NS_TEST_EXPECT_MSG_LT(buffer.GetSerializedSize(),
+                          200,
+                          "The largest zero area of the concatenated buffers is not virtual");
+    data.assign(buffer.GetSize(), 0xff);
+    buffer.CopyData(data.data(), data.size());
+    NS_TEST_EXPECT_MSG_EQ(data[100], 0x5, "Bad byte after the first zero area");
+    NS_TEST_EXPECT_MSG_EQ(data[101], 0x6, "Bad byte before the second zero area");
+    NS_TEST_EXPECT_MSG_EQ(std::count(data.begin(), data.end(), 0),
+                          1100,
+                          "Bad bytes in the zero areas");
+
+    // The bytes of the other buffer are written after the zero area of this
+    // buffer, which has a trailer.
+    buffer = Buffer(1000);
+    buffer.AddAtEnd(2);
+    i = buffer.End();
+    i.Prev(2);
+    i.WriteU8(0x7);
+    i.WriteU8(0x8);
+    other = Buffer(10);
+    other.AddAtStart(1);
+    other.Begin().WriteU8(0x9);
+    other.AddAtEnd(1);
+    i = other.End();
+    i.Prev(1);
+    i.WriteU8(0xa);
+    buffer.AddAtEnd(other);
+    NS_TEST_EXPECT_MSG_EQ(buffer.GetSize(), 1014, "Bad size of the concatenated buffers");
+    NS_TEST_EXPECT_MSG_LT(buffer.GetSerializedSize(),
+                          100,
+                          "The zero area of the buffer with a trailer is not virtual");
+    data.assign(buffer.GetSize(), 0xff);
+    buffer.CopyData(data.data(), data.size());
+    NS_TEST_EXPECT_MSG_EQ(std::count(data.begin(), data.begin() + 1000, 0),
+                          1000,
+                          "Bad bytes in the zero area");
+    NS_TEST_EXPECT_MSG_EQ(data[1000], 0x7, "Bad first byte of the trailer");
+    NS_TEST_EXPECT_MSG_EQ(data[1001], 0x8, "Bad second byte of the trailer");
+    NS_TEST_EXPECT_MSG_EQ(data[1002], 0x9, "Bad first byte of the other buffer");
+    NS_TEST_EXPECT_MSG_EQ(std::count(data.begin() + 1003, data.begin() + 1013, 0),
+                          10,
+                          "Bad bytes in the zero area of the other buffer");
+    NS_TEST_EXPECT_MSG_EQ(data[1013], 0xa, "Bad last byte of the other buffer");
 }
 
 /**
@@ -18,6 +18,7 @@
  */
 #include "ns3/packet-tag-list.h"
 #include "ns3/packet.h"
+#include "ns3/pool-allocator.h"
 #include "ns3/test.h"
 
 #include <cstdarg>
@@ -26,6 +27,7 @@
 #include <iostream>
 #include <limits> // std:numeric_limits
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -1268,6 +1270,120 @@ PacketTagListTest::DoRun()
     } // Timing
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Packet allocation test: check that the packets, with their buffer,
+ * tags and metadata, reuse the memory released by the previous packets.
+ */
+class PacketPoolTest : public TestCase
+{
+  public:
+    PacketPoolTest();
+
+  private:
+    void DoRun() override;
+
+    /** Create, copy and release a packet with headers and tags. */
+    void CreatePacket();
+};
+
+PacketPoolTest::PacketPoolTest()
+    : TestCase("Check that the packets reuse the memory of the released packets")
+{
+}
+
+void
+PacketPoolTest::CreatePacket()
+{
+    ATestTag<1> tag;
+    Ptr<Packet> p = Create<Packet>(1000);
+    p->AddHeader(ATestHeader<10>());
+    p->AddPacketTag(tag);
+    p->AddByteTag(ATestTag<2>());
+    Ptr<Packet> copy = p->Copy();
+    copy->AddHeader(ATestHeader<4>());
+    copy->RemovePacketTag(tag);
+}
+
+void
+PacketPoolTest::DoRun()
+{
+    // let the sizes of the buffers and of the metadata settle
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        CreatePacket();
+    }
+
+    PoolAllocator::Stats before = PoolAllocator::GetStats();
+    CreatePacket();
+    PoolAllocator::Stats after = PoolAllocator::GetStats();
+
+    uint64_t allocations = after.allocations - before.allocations;
+    NS_TEST_EXPECT_MSG_GT(allocations, 0, "The packets are not allocated by the PoolAllocator");
+    NS_TEST_EXPECT_MSG_EQ(after.recycled - before.recycled,
+                          allocations,
+                          "The memory of the released packets was not reused");
+    NS_TEST_EXPECT_MSG_EQ(after.deallocations - before.deallocations,
+                          allocations,
+                          "The memory of the packets was not released");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Packet full copy test: check that the full copy of a packet has the
+ * same data, tags and uid as the packet.
+ */
+class PacketFullCopyTest : public TestCase
+{
+  public:
+    PacketFullCopyTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketFullCopyTest::PacketFullCopyTest()
+    : TestCase("Check the full copy of a packet")
+{
+}
+
+void
+PacketFullCopyTest::DoRun()
+{
+    Ptr<Packet> p = Create<Packet>(1000);
+    p->AddHeader(ATestHeader<10>());
+    p->AddPacketTag(ATestTag<1>(5));
+    p->AddByteTag(ATestTag<2>());
+
+    Ptr<Packet> copy = p->CreateFullCopy();
+    NS_TEST_EXPECT_MSG_EQ(copy->GetSize(), p->GetSize(), "Unexpected size of the full copy");
+    NS_TEST_EXPECT_MSG_EQ(copy->GetUid(), p->GetUid(), "Unexpected uid of the full copy");
+    std::vector<uint8_t> data(p->GetSize());
+    std::vector<uint8_t> copyData(copy->GetSize());
+    p->CopyData(data.data(), data.size());
+    copy->CopyData(copyData.data(), copyData.size());
+    NS_TEST_EXPECT_MSG_EQ((data == copyData), true, "Unexpected data of the full copy");
+    ATestTag<1> tag;
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekPacketTag(tag), true, "Missing packet tag");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetData(), 5, "Unexpected packet tag");
+    ByteTagIterator i = copy->GetByteTagIterator();
+    NS_TEST_ASSERT_MSG_EQ(i.HasNext(), true, "Missing byte tag");
+    ByteTagIterator::Item item = i.Next();
+    NS_TEST_EXPECT_MSG_EQ(item.GetTypeId(), ATestTag<2>::GetTypeId(), "Unexpected byte tag");
+    NS_TEST_EXPECT_MSG_EQ(item.GetEnd() - item.GetStart(), 1010, "Unexpected byte tag range");
+
+    // the packets are independent
+    ATestHeader<10> header;
+    copy->RemoveHeader(header);
+    copy->RemoveAllPacketTags();
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 1010, "The full copy shares the buffer of the packet");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(tag), true, "The full copy shares the packet tags");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1285,6 +1401,8 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::QUICK);
+    AddTestCase(new PacketPoolTest, TestCase::QUICK);
+    AddTestCase(new PacketFullCopyTest, TestCase::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
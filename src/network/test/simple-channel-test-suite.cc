@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/channel-list.h"
+#include "ns3/mac48-address.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the nodes attached to a SimpleChannel receive the same
+ * packets when executed in parallel by the MultithreadedSimulatorImpl as
+ * when executed by the DefaultSimulatorImpl.
+ *
+ * Every node periodically broadcasts packets, and forwards some of the
+ * received packets after appending bytes to them. The packets received by
+ * every node (time, sender, sequence number, size and content) are compared.
+ */
+class SimpleChannelParallelTest : public TestCase
+{
+  public:
+    SimpleChannelParallelTest();
+
+  private:
+    void DoRun() override;
+
+    /// A received packet: receive timestamp, sender, sequence number, size and checksum
+    using Reception = std::tuple<int64_t, uint32_t, uint32_t, uint32_t, uint32_t>;
+
+    /**
+     * Run the simulation with the given simulator implementation.
+     *
+     * \param simulatorType The simulator implementation type.
+     * \param threads The number of threads of the MultithreadedSimulatorImpl.
+     * \return The packets received by every node, sorted.
+     */
+    std::vector<std::vector<Reception>> RunSimulation(const std::string& simulatorType,
+                                                      uint32_t threads);
+    /**
+     * Broadcast a packet.
+     *
+     * \param node The index of the sending node.
+     * \param seq The sequence number of the packet.
+     */
+    void Send(uint32_t node, uint32_t seq);
+    /**
+     * Receive a packet.
+     *
+     * \param device The receiving device.
+     * \param packet The received packet.
+     * \param protocol The protocol number.
+     * \param from The sender address.
+     * \return true
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    /// Number of nodes
+    static constexpr uint32_t N_NODES = 8;
+    /// Number of packets sent by every node
+    static constexpr uint32_t N_PACKETS = 50;
+    /// Protocol number of the packets
+    static constexpr uint16_t PROTOCOL = 0x88b5;
+
+    Time m_delay;                                   //!< The delay of the channel.
+    NetDeviceContainer m_devices;                   //!< The devices.
+    std::vector<std::vector<Reception>> m_received; //!< Packets received, per node.
+};
+
+SimpleChannelParallelTest::SimpleChannelParallelTest()
+    : TestCase("Check that the nodes attached to a SimpleChannel can be executed in parallel"),
+      m_delay(MicroSeconds(10))
+{
+}
+
+void
+SimpleChannelParallelTest::Send(uint32_t node, uint32_t seq)
+{
+    // the payload is made of the sender, the sequence number and a virtual zero area
+    uint8_t header[] = {static_cast<uint8_t>(node), static_cast<uint8_t>(seq)};
+    Ptr<Packet> packet = Create<Packet>(header, sizeof(header));
+    packet->AddAtEnd(Create<Packet>(100 + 10 * node));
+    m_devices.Get(node)->Send(packet, Mac48Address::GetBroadcast(), PROTOCOL);
+}
+
+bool
+SimpleChannelParallelTest::Receive(Ptr<NetDevice> device,
+                                   Ptr<const Packet> packet,
+                                   uint16_t protocol,
+                                   const Address& from)
+{
+    uint32_t node = Simulator::GetContext();
+    std::vector<uint8_t> data(packet->GetSize());
+    packet->CopyData(data.data(), data.size());
+    uint32_t checksum = 0;
+    for (auto byte : data)
+    {
+        checksum = checksum * 31 + byte;
+    }
+    uint32_t sender = data[0];
+    uint32_t seq = data[1];
+    // every forwarding node appends a byte
+    uint32_t hops = data.size() - 2 - (100 + 10 * sender);
+    m_received[node].emplace_back(Simulator::Now().GetTimeStep(),
+                                  sender,
+                                  seq,
+                                  data.size(),
+                                  checksum);
+
+    if (hops == 0 && seq % 4 == node % 4)
+    {
+        // forward the packet with an additional byte
+        Ptr<Packet> copy = packet->Copy();
+        uint8_t trailer = static_cast<uint8_t>(node);
+        copy->AddAtEnd(Create<Packet>(&trailer, 1));
+        device->Send(copy, Mac48Address::GetBroadcast(), PROTOCOL);
+    }
+    return true;
+}
+
+std::vector<std::vector<SimpleChannelParallelTest::Reception>>
+SimpleChannelParallelTest::RunSimulation(const std::string& simulatorType, uint32_t threads)
+{
+    ObjectFactory factory(simulatorType);
+    if (threads > 0)
+    {
+        factory.Set("ThreadCount", UintegerValue(threads));
+    }
+    Simulator::SetImplementation(factory.Create<SimulatorImpl>());
+
+    NodeContainer nodes(N_NODES);
+    SimpleNetDeviceHelper helper;
+    helper.SetChannelAttribute("Delay", TimeValue(m_delay));
+    m_devices = helper.Install(nodes);
+    for (uint32_t i = 0; i < N_NODES; i++)
+    {
+        m_devices.Get(i)->SetReceiveCallback(
+            MakeCallback(&SimpleChannelParallelTest::Receive, this));
+    }
+
+    if (threads > 0)
+    {
+        NS_TEST_EXPECT_MSG_EQ(ChannelList::GetMinimumDelay(),
+                              m_delay,
+                              "The minimum delay should be the delay of the channel");
+        Simulator::GetImplementation()->SetAttribute("Lookahead",
+                                                     TimeValue(ChannelList::GetMinimumDelay()));
+    }
+
+    m_received.assign(N_NODES, {});
+    for (uint32_t node = 0; node < N_NODES; node++)
+    {
+        for (uint32_t seq = 0; seq < N_PACKETS; seq++)
+        {
+            Simulator::ScheduleWithContext(nodes.Get(node)->GetId(),
+                                           MicroSeconds(3 * seq) + NanoSeconds(node * 100),
+                                           &SimpleChannelParallelTest::Send,
+                                           this,
+                                           node,
+                                           seq);
+        }
+    }
+    Simulator::Run();
+    if (threads > 0)
+    {
+        auto impl = DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+        NS_TEST_EXPECT_MSG_EQ(impl->GetNPartitions(), threads, "Unexpected number of partitions");
+    }
+    m_devices = NetDeviceContainer();
+    Simulator::Destroy();
+
+    for (auto& received : m_received)
+    {
+        std::sort(received.begin(), received.end());
+    }
+    return m_received;
+}
+
+void
+SimpleChannelParallelTest::DoRun()
+{
+    auto expected = RunSimulation("ns3::DefaultSimulatorImpl", 0);
+    uint32_t forwarded = 0;
+    for (uint32_t node = 0; node < N_NODES; node++)
+    {
+        // the packets of the other nodes and the forwarded packets
+        NS_TEST_ASSERT_MSG_GT(expected[node].size(),
+                              (N_NODES - 1) * N_PACKETS,
+                              "Unexpected number of packets received by node " << node);
+        forwarded += expected[node].size() - (N_NODES - 1) * N_PACKETS;
+    }
+    NS_TEST_ASSERT_MSG_GT(forwarded, 0, "No packet was forwarded");
+
+    for (uint32_t threads : {1, 2, 4})
+    {
+        auto received = RunSimulation("ns3::MultithreadedSimulatorImpl", threads);
+        for (uint32_t node = 0; node < N_NODES; node++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(received[node].size(),
+                                  expected[node].size(),
+                                  "Unexpected number of packets received by node "
+                                      << node << " with " << threads << " threads");
+            NS_TEST_EXPECT_MSG_EQ((received[node] == expected[node]),
+                                  true,
+                                  "Unexpected packets received by node "
+                                      << node << " with " << threads << " threads");
+        }
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief SimpleChannel TestSuite
+ */
+class SimpleChannelTestSuite : public TestSuite
+{
+  public:
+    SimpleChannelTestSuite()
+        : TestSuite("simple-channel", UNIT)
+    {
+        AddTestCase(new SimpleChannelParallelTest, TestCase::QUICK);
+    }
+};
+
+static SimpleChannelTestSuite g_simpleChannelTestSuite; //!< Static variable for test initialization
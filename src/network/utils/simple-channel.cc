@@ -21,6 +21,7 @@
 #include "simple-net-device.h"
 
 #include "ns3/log.h"
+#include "ns3/multithreaded-simulator-impl.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -62,9 +63,13 @@ SimpleChannel::Send(Ptr<Packet> p,
                     Ptr<SimpleNetDevice> sender)
 {
     NS_LOG_FUNCTION(this << p << protocol << to << from << sender);
-    for (auto i = m_devices.begin(); i != m_devices.end(); ++i)
+    // the receivers may be executed by other threads (see MultithreadedSimulatorImpl): neither
+    // the reference counts of the receiving devices and nodes nor the datasets of the packet
+    // may be shared with them
+    const bool parallel = MultithreadedSimulatorImpl::IsParallel();
+    for (std::size_t i = 0; i < m_devices.size(); ++i)
     {
-        Ptr<SimpleNetDevice> tmp = *i;
+        const Ptr<SimpleNetDevice>& tmp = m_devices[i];
         if (tmp == sender)
         {
             continue;
@@ -77,11 +82,15 @@ SimpleChannel::Send(Ptr<Packet> p,
                 continue;
             }
         }
-        Simulator::ScheduleWithContext(tmp->GetNode()->GetId(),
+        if (m_contexts[i] == Simulator::NO_CONTEXT)
+        {
+            m_contexts[i] = tmp->GetNode()->GetId();
+        }
+        Simulator::ScheduleWithContext(m_contexts[i],
                                        m_delay,
                                        &SimpleNetDevice::Receive,
-                                       tmp,
-                                       p->Copy(),
+                                       PeekPointer(tmp),
+                                       parallel ? p->CreateFullCopy() : p->Copy(),
                                        protocol,
                                        to,
                                        from);
@@ -93,6 +102,7 @@ SimpleChannel::Add(Ptr<SimpleNetDevice> device)
 {
     NS_LOG_FUNCTION(this << device);
     m_devices.push_back(device);
+    m_contexts.push_back(device->GetNode() ? device->GetNode()->GetId() : Simulator::NO_CONTEXT);
 }
 
 std::size_t
@@ -109,6 +119,13 @@ SimpleChannel::GetDevice(std::size_t i) const
     return m_devices[i];
 }
 
+Time
+SimpleChannel::GetMinimumDelay() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_delay;
+}
+
 void
 SimpleChannel::BlackList(Ptr<SimpleNetDevice> from, Ptr<SimpleNetDevice> to)
 {
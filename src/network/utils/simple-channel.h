@@ -44,6 +44,11 @@ class Packet;
  * are using 48-bit MAC addresses.
  *
  * This channel is meant to be used by ns3::SimpleNetDevices.
+ *
+ * The delay of the channel is its minimum delay (see Channel::GetMinimumDelay()):
+ * the nodes attached to it can be executed in parallel by the
+ * MultithreadedSimulatorImpl, as long as the devices are attached to their node
+ * before being attached to the channel (as done by SimpleNetDeviceHelper).
  */
 class SimpleChannel : public Channel
 {
@@ -101,10 +106,12 @@ class SimpleChannel : public Channel
     // inherited from ns3::Channel
     std::size_t GetNDevices() const override;
     Ptr<NetDevice> GetDevice(std::size_t i) const override;
+    Time GetMinimumDelay() const override;
 
   private:
     Time m_delay; //!< The assigned speed-of-light delay of the channel
     std::vector<Ptr<SimpleNetDevice>> m_devices; //!< devices connected by the channel
+    std::vector<uint32_t> m_contexts; //!< IDs of the nodes of the devices connected by the channel
     std::map<Ptr<SimpleNetDevice>, std::vector<Ptr<SimpleNetDevice>>>
         m_blackListedDevices; //!< devices blocked on a device
 };
@@ -30,6 +30,7 @@
 #include <cmath>
 #include <map>
 #include <sstream>
+#include <tuple>
 
 namespace ns3
 {
@@ -68,6 +69,50 @@ operator<(const WifiSpectrumModelId& a, const WifiSpectrumModelId& b)
 static std::map<WifiSpectrumModelId, Ptr<SpectrumModel>>
     g_wifiSpectrumModelMap; ///< static initializer for the class
 
+/**
+ * Identifier of an HE OFDM transmit PSD template: center frequency (MHz), channel width
+ * (MHz), guard band width (MHz), minimum relative power in the inner band (dBr), minimum
+ * relative power in the outer band (dBr), lowest point (dBr) and punctured subchannels
+ */
+using HeOfdmTxPsdId =
+    std::tuple<uint32_t, uint16_t, uint16_t, double, double, double, std::vector<bool>>;
+
+/**
+ * Identifier of an HE MU OFDM transmit PSD template: center frequency (MHz), channel width
+ * (MHz), guard band width (MHz) and RU band
+ */
+using HeMuOfdmTxPsdId = std::tuple<uint32_t, uint16_t, uint16_t, uint32_t, uint32_t>;
+
+/**
+ * The transmit PSD templates are kept per thread, so that simulations running in
+ * different threads neither share nor synchronize them; the templates of a thread are
+ * released when the thread exits.
+ */
+static thread_local std::map<HeOfdmTxPsdId, Ptr<const SpectrumValue>>
+    g_heOfdmTxPsdCache; ///< HE OFDM transmit PSD templates (normalized to 1 W)
+static thread_local std::map<HeMuOfdmTxPsdId, Ptr<const SpectrumValue>>
+    g_heMuOfdmTxPsdCache; ///< HE MU OFDM transmit PSD templates (normalized to 1 W)
+static thread_local WifiSpectrumValueHelper::TxPsdCacheStats
+    g_txPsdCacheStats; ///< statistics about the cache of transmit PSD templates
+
+/**
+ * Create a transmit PSD by scaling the given template. Transmit PSDs are always derived
+ * from a template, so that the PSD returned when the template is built is identical to
+ * the PSDs returned afterwards for the same parameters.
+ *
+ * \param psdTemplate the template normalized to 1 W
+ * \param txPowerW the transmit power (W)
+ * \return the transmit PSD
+ */
+static Ptr<SpectrumValue>
+CreateFromTxPsdTemplate(Ptr<const SpectrumValue> psdTemplate, double txPowerW)
+{
+    // the template is shared, scale a copy of it
+    auto psd = Copy(psdTemplate);
+    *psd *= txPowerW;
+    return psd;
+}
+
 Ptr<SpectrumModel>
 WifiSpectrumValueHelper::GetSpectrumModel(uint32_t centerFrequency,
                                           uint16_t channelWidth,
@@ -375,6 +420,24 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr
                                     << minOuterBandDbr << lowestPointDbr);
+    const HeOfdmTxPsdId psdId{centerFrequency,
+                              channelWidth,
+                              guardBandwidth,
+                              minInnerBandDbr,
+                              minOuterBandDbr,
+                              lowestPointDbr,
+                              puncturedSubchannels};
+    auto& psdTemplate = g_heOfdmTxPsdCache[psdId];
+    if (psdTemplate)
+    {
+        NS_LOG_LOGIC("HE OFDM transmit PSD created from cached template");
+        g_txPsdCacheStats.hits++;
+        return CreateFromTxPsdTemplate(psdTemplate, txPowerW);
+    }
+    g_txPsdCacheStats.misses++;
+
+    // build the template for a transmit power of 1 W
+    const double templatePowerW = 1.0;
     uint32_t carrierSpacing = 78125;
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequency, channelWidth, carrierSpacing, guardBandwidth));
@@ -401,7 +464,7 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
     {
     case 20:
         // 242 subcarriers (234 data + 8 pilot)
-        txPowerPerBandW = txPowerW / 242;
+        txPowerPerBandW = templatePowerW / 242;
         innerSlopeWidth =
             static_cast<uint32_t>((5e5 / carrierSpacing) + 0.5); // [-10.25;-9.75] & [9.75;10.25]
         // skip the guard band and 6 subbands, then place power in 121 subbands, then
@@ -416,7 +479,7 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
         break;
     case 40:
         // 484 subcarriers (468 data + 16 pilot)
-        txPowerPerBandW = txPowerW / 484;
+        txPowerPerBandW = templatePowerW / 484;
         // skip the guard band and 12 subbands, then place power in 242 subbands, then
         // skip 5 DC, then place power in 242 subbands, then skip
         // the final 11 subbands and the guard band.
@@ -429,7 +492,7 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
         break;
     case 80:
         // 996 subcarriers (980 data + 16 pilot)
-        txPowerPerBandW = txPowerW / 996;
+        txPowerPerBandW = templatePowerW / 996;
         // skip the guard band and 12 subbands, then place power in 498 subbands, then
         // skip 5 DC, then place power in 498 subbands, then skip
         // the final 11 subbands and the guard band.
@@ -442,7 +505,7 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
         break;
     case 160:
         // 2 x 996 subcarriers (2 x 80 MHZ bands)
-        txPowerPerBandW = txPowerW / (2 * 996);
+        txPowerPerBandW = templatePowerW / (2 * 996);
         start1 = (nGuardBands / 2) + 12;
         stop1 = start1 + 498 - 1;
         start2 = stop1 + 6;
@@ -491,9 +554,10 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
                               lowestPointDbr,
                               puncturedBands,
                               puncturedSlopeWidth);
-    NormalizeSpectrumMask(c, txPowerW);
-    NS_ASSERT_MSG(std::abs(txPowerW - Integral(*c)) < 1e-6, "Power allocation failed");
-    return c;
+    NormalizeSpectrumMask(c, templatePowerW);
+    NS_ASSERT_MSG(std::abs(templatePowerW - Integral(*c)) < 1e-6, "Power allocation failed");
+    psdTemplate = c;
+    return CreateFromTxPsdTemplate(psdTemplate, txPowerW);
 }
 
 Ptr<SpectrumValue>
@@ -505,6 +569,18 @@ WifiSpectrumValueHelper::CreateHeMuOfdmTxPowerSpectralDensity(uint32_t centerFre
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPowerW << guardBandwidth << ru.first
                                     << ru.second);
+    const HeMuOfdmTxPsdId psdId{centerFrequency, channelWidth, guardBandwidth, ru.first, ru.second};
+    auto& psdTemplate = g_heMuOfdmTxPsdCache[psdId];
+    if (psdTemplate)
+    {
+        NS_LOG_LOGIC("HE MU OFDM transmit PSD created from cached template");
+        g_txPsdCacheStats.hits++;
+        return CreateFromTxPsdTemplate(psdTemplate, txPowerW);
+    }
+    g_txPsdCacheStats.misses++;
+
+    // build the template for a transmit power of 1 W
+    const double templatePowerW = 1.0;
     uint32_t carrierSpacing = 78125;
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequency, channelWidth, carrierSpacing, guardBandwidth));
@@ -512,7 +588,8 @@ WifiSpectrumValueHelper::CreateHeMuOfdmTxPowerSpectralDensity(uint32_t centerFre
     // Build spectrum mask
     auto vit = c->ValuesBegin();
     auto bit = c->ConstBandsBegin();
-    double txPowerPerBandW = (txPowerW / (ru.second - ru.first + 1)); // FIXME: null subcarriers
+    double txPowerPerBandW =
+        (templatePowerW / (ru.second - ru.first + 1)); // FIXME: null subcarriers
     uint32_t numBands = c->GetSpectrumModel()->GetNumBands();
     for (size_t i = 0; i < numBands; i++, vit++, bit++)
     {
@@ -526,7 +603,23 @@ WifiSpectrumValueHelper::CreateHeMuOfdmTxPowerSpectralDensity(uint32_t centerFre
         }
     }
 
-    return c;
+    psdTemplate = c;
+    return CreateFromTxPsdTemplate(psdTemplate, txPowerW);
+}
+
+WifiSpectrumValueHelper::TxPsdCacheStats
+WifiSpectrumValueHelper::GetTxPsdCacheStats()
+{
+    return g_txPsdCacheStats;
+}
+
+void
+WifiSpectrumValueHelper::ClearTxPsdCache()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    g_heOfdmTxPsdCache.clear();
+    g_heMuOfdmTxPsdCache.clear();
+    g_txPsdCacheStats = TxPsdCacheStats{};
 }
 
 Ptr<SpectrumValue>
@@ -802,6 +895,37 @@ WifiSpectrumValueHelper::GetBandPowerW(Ptr<SpectrumValue> psd, const WifiSpectru
     return powerWattPerHertz * (bandIt->fh - bandIt->fl);
 }
 
+std::vector<double>
+WifiSpectrumValueHelper::GetCumulativePsd(Ptr<const SpectrumValue> psd)
+{
+    std::vector<double> cumulativePsd;
+    cumulativePsd.reserve(psd->GetValuesN() + 1);
+    double sum = 0.0;
+    double compensation = 0.0; // low-order bits lost by the previous additions
+    cumulativePsd.push_back(sum);
+    for (auto valueIt = psd->ConstValuesBegin(); valueIt != psd->ConstValuesEnd(); ++valueIt)
+    {
+        const double value = *valueIt - compensation;
+        const double newSum = sum + value;
+        compensation = (newSum - sum) - value;
+        sum = newSum;
+        cumulativePsd.push_back(sum);
+    }
+    return cumulativePsd;
+}
+
+double
+WifiSpectrumValueHelper::GetBandPowerW(Ptr<const SpectrumValue> psd,
+                                       const std::vector<double>& cumulativePsd,
+                                       const WifiSpectrumBandIndices& band)
+{
+    NS_ASSERT(band.first <= band.second);
+    NS_ASSERT(band.second + 1 < cumulativePsd.size());
+    double powerWattPerHertz = cumulativePsd[band.second + 1] - cumulativePsd[band.first];
+    auto bandIt = psd->ConstBandsBegin() + band.first;
+    return powerWattPerHertz * (bandIt->fh - bandIt->fl);
+}
+
 bool
 operator<(const FrequencyRange& left, const FrequencyRange& right)
 {
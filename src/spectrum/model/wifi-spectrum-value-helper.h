@@ -24,6 +24,8 @@
 
 #include "spectrum-value.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -38,6 +40,13 @@ using WifiSpectrumBandIndices = std::pair<uint32_t, uint32_t>;
  *  This class defines all functions to create a spectrum model for
  *  Wi-Fi based on a a spectral model aligned with an OFDM subcarrier
  *  spacing of 312.5 KHz (model also reused for DSSS modulations)
+ *
+ *  The transmit PSDs of HE PPDUs are built from templates that are cached
+ *  per combination of center frequency, channel width, guard band, spectral
+ *  mask parameters and punctured subchannels (or RU, for the OFDMA part of
+ *  HE TB PPDUs). A template is normalized to a transmit power of 1 W, hence
+ *  a PSD is obtained by scaling a copy of the template by the transmit power.
+ *  Every thread has its own cache, so that the cache needs no synchronization.
  */
 class WifiSpectrumValueHelper
 {
@@ -47,6 +56,15 @@ class WifiSpectrumValueHelper
      */
     virtual ~WifiSpectrumValueHelper() = default;
 
+    /**
+     * Statistics about the cache of transmit PSD templates
+     */
+    struct TxPsdCacheStats
+    {
+        uint64_t hits{0};   //!< number of PSDs obtained from a cached template
+        uint64_t misses{0}; //!< number of PSDs that required to build a template
+    };
+
     /**
      * Return a SpectrumModel instance corresponding to the center frequency
      * and channel width.  The spectrum model spans the channel width
@@ -205,6 +223,17 @@ class WifiSpectrumValueHelper
         uint16_t guardBandwidth,
         const WifiSpectrumBandIndices& ru);
 
+    /**
+     * \return the statistics about the cache of transmit PSD templates of the calling thread
+     */
+    static TxPsdCacheStats GetTxPsdCacheStats();
+
+    /**
+     * Remove the transmit PSD templates cached by the calling thread and reset its cache
+     * statistics.
+     */
+    static void ClearTxPsdCache();
+
     /**
      * Create a power spectral density corresponding to the noise
      *
@@ -323,6 +352,35 @@ class WifiSpectrumValueHelper
      * \return band power in W
      */
     static double GetBandPowerW(Ptr<SpectrumValue> psd, const WifiSpectrumBandIndices& band);
+
+    /**
+     * Compute the cumulative sums of the values of the given PSD, i.e., the i-th element
+     * of the returned vector is the sum of the first i values of the PSD. The returned
+     * vector can then be passed to GetBandPowerW() to compute the power of any number
+     * of bands of the same PSD in constant time per band. The sums are accumulated with
+     * Kahan compensated summation, so that the power of a narrow band is not lost in the
+     * rounding error of the sum of the preceding values.
+     *
+     * \param psd received Power Spectral Density in W/Hz
+     *
+     * \return the cumulative sums of the values of the given PSD (one more than the
+     *         number of values of the PSD)
+     */
+    static std::vector<double> GetCumulativePsd(Ptr<const SpectrumValue> psd);
+
+    /**
+     * Calculate the power of the specified band composed of uniformly-sized sub-bands,
+     * by using the cumulative sums of the values of the PSD.
+     *
+     * \param psd received Power Spectral Density in W/Hz
+     * \param cumulativePsd the cumulative sums returned by GetCumulativePsd() for the given PSD
+     * \param band a pair of start and stop indexes that defines the band
+     *
+     * \return band power in W
+     */
+    static double GetBandPowerW(Ptr<const SpectrumValue> psd,
+                                const std::vector<double>& cumulativePsd,
+                                const WifiSpectrumBandIndices& band);
 };
 
 /**
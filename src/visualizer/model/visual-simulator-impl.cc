@@ -215,6 +215,12 @@ VisualSimulatorImpl::GetContext() const
     return m_simulator->GetContext();
 }
 
+void
+VisualSimulatorImpl::SetContext(uint32_t context)
+{
+    m_simulator->SetContext(context);
+}
+
 uint64_t
 VisualSimulatorImpl::GetEventCount() const
 {
@@ -71,6 +71,7 @@ class VisualSimulatorImpl : public SimulatorImpl
     void SetScheduler(ObjectFactory schedulerFactory) override;
     uint32_t GetSystemId() const override;
     uint32_t GetContext() const override;
+    void SetContext(uint32_t context) override;
     uint64_t GetEventCount() const override;
 
     /// calls Run() in the wrapped simulator
@@ -34,6 +34,7 @@
 #include "wifi-net-device.h"
 #include "wifi-phy.h"
 
+#include "ns3/abort.h"
 #include "ns3/eht-configuration.h"
 #include "ns3/eht-frame-exchange-manager.h"
 #include "ns3/he-configuration.h"
@@ -53,6 +54,66 @@ NS_LOG_COMPONENT_DEFINE("ApWifiMac");
 
 NS_OBJECT_ENSURE_REGISTERED(ApWifiMac);
 
+namespace
+{
+
+/**
+ * \ingroup wifi
+ *
+ * Header used to add a cached Beacon frame body to a packet. The Timestamp field
+ * is written upon serialization, while all the subsequent fields are copied from
+ * the cache. This header has the TypeId of MgtBeaconHeader, so that the packet
+ * metadata allow to print and remove the added header as a MgtBeaconHeader.
+ */
+class CachedBeaconHeader : public Header
+{
+  public:
+    /// Size in bytes of the Timestamp field
+    static constexpr uint32_t TIMESTAMP_SIZE = 8;
+
+    /**
+     * Constructor
+     *
+     * \param body the serialized Beacon frame body, except for the Timestamp field
+     */
+    explicit CachedBeaconHeader(const std::vector<uint8_t>& body)
+        : m_body(body)
+    {
+    }
+
+    TypeId GetInstanceTypeId() const override
+    {
+        return MgtBeaconHeader::GetTypeId();
+    }
+
+    void Print(std::ostream& os) const override
+    {
+        os << "cached beacon body of " << m_body.size() << " bytes";
+    }
+
+    uint32_t GetSerializedSize() const override
+    {
+        return TIMESTAMP_SIZE + m_body.size();
+    }
+
+    void Serialize(Buffer::Iterator start) const override
+    {
+        start.WriteHtolsbU64(Simulator::Now().GetMicroSeconds());
+        start.Write(m_body.data(), m_body.size());
+    }
+
+    uint32_t Deserialize(Buffer::Iterator start) override
+    {
+        NS_ABORT_MSG("A cached Beacon frame body must be deserialized as a MgtBeaconHeader");
+        return 0;
+    }
+
+  private:
+    const std::vector<uint8_t>& m_body; //!< the cached Beacon frame body
+};
+
+} // namespace
+
 TypeId
 ApWifiMac::GetTypeId()
 {
@@ -74,6 +135,15 @@ ApWifiMac::GetTypeId()
                           StringValue("ns3::UniformRandomVariable"),
                           MakePointerAccessor(&ApWifiMac::m_beaconJitter),
                           MakePointerChecker<UniformRandomVariable>())
+            .AddAttribute("CacheBeacons",
+                          "Whether to cache the serialized body of the Beacon frames. The "
+                          "cached body is rebuilt when stations associate or disassociate, "
+                          "a channel switch occurs or the SSID or the beacon interval change; "
+                          "disable caching if other parameters advertised in Beacon frames "
+                          "(e.g., EDCA parameters) are modified while beacons are generated.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&ApWifiMac::m_cacheBeacons),
+                          MakeBooleanChecker())
             .AddAttribute("EnableBeaconJitter",
                           "If beacons are enabled, whether to jitter the initial send event.",
                           BooleanValue(true),
@@ -108,7 +178,8 @@ ApWifiMac::GetTypeId()
 }
 
 ApWifiMac::ApWifiMac()
-    : m_enableBeaconGeneration(false)
+    : m_enableBeaconGeneration(false),
+      m_cacheBeacons(true)
 {
     NS_LOG_FUNCTION(this);
     m_beaconTxop = CreateObject<Txop>(CreateObject<WifiMacQueue>(AC_BEACON));
@@ -195,6 +266,16 @@ ApWifiMac::SetBeaconGeneration(bool enable)
     m_enableBeaconGeneration = enable;
 }
 
+void
+ApWifiMac::NotifyChannelSwitching(uint8_t linkId)
+{
+    NS_LOG_FUNCTION(this << +linkId);
+    WifiMac::NotifyChannelSwitching(linkId);
+    // the operating channel is advertised in the Beacon frames sent on this link and,
+    // in case of AP MLD, in the Reduced Neighbor Report of the other links
+    ResetBeaconCache();
+}
+
 Time
 ApWifiMac::GetBeaconInterval() const
 {
@@ -229,6 +310,7 @@ ApWifiMac::SetBeaconInterval(Time interval)
             "beacon interval should be smaller then or equal to 65535 * 1024us (802.11 time unit)");
     }
     m_beaconInterval = interval;
+    ResetBeaconCache();
 }
 
 int64_t
@@ -1279,6 +1361,7 @@ ApWifiMac::SetAid(MgtAssocResponseHeader& assoc, const LinkIdStaAddrMap& linkIdS
             }
         }
     }
+    ResetBeaconCache();
 
     // set the AID in all the Association Responses. NOTE that the Association
     // Responses included in the Per-STA Profile Subelements of the Multi-Link
@@ -1369,6 +1452,58 @@ ApWifiMac::SendOneBeacon(uint8_t linkId)
     hdr.SetDsNotFrom();
     hdr.SetDsNotTo();
     Ptr<Packet> packet = Create<Packet>();
+    GetWifiRemoteStationManager(linkId)->SetShortPreambleEnabled(link.shortPreambleEnabled);
+    GetWifiRemoteStationManager(linkId)->SetShortSlotTimeEnabled(link.shortSlotTimeEnabled);
+    if (!m_cacheBeacons)
+    {
+        packet->AddHeader(GetBeaconHeader(linkId));
+    }
+    else
+    {
+        if (link.beaconBody.empty() || !link.beaconSsid.IsEqual(GetSsid()))
+        {
+            NS_LOG_DEBUG("Building the Beacon frame body for link " << +linkId);
+            auto beacon = GetBeaconHeader(linkId);
+            Buffer buffer;
+            buffer.AddAtStart(beacon.GetSerializedSize());
+            beacon.Serialize(buffer.Begin());
+            // all the fields but the Timestamp field are cached
+            auto i = buffer.Begin();
+            i.Next(CachedBeaconHeader::TIMESTAMP_SIZE);
+            link.beaconBody.resize(buffer.GetSize() - CachedBeaconHeader::TIMESTAMP_SIZE);
+            i.Read(link.beaconBody.data(), link.beaconBody.size());
+            link.beaconSsid = GetSsid();
+        }
+        packet->AddHeader(CachedBeaconHeader(link.beaconBody));
+    }
+
+    // The beacon has it's own special queue, so we load it in there
+    m_beaconTxop->Queue(packet, hdr);
+    link.beaconEvent =
+        Simulator::Schedule(GetBeaconInterval(), &ApWifiMac::SendOneBeacon, this, linkId);
+
+    // If a STA that does not support Short Slot Time associates,
+    // the AP shall use long slot time beginning at the first Beacon
+    // subsequent to the association of the long slot time STA.
+    if (GetErpSupported(linkId))
+    {
+        if (link.shortSlotTimeEnabled)
+        {
+            // Enable short slot time
+            GetWifiPhy(linkId)->SetSlot(MicroSeconds(9));
+        }
+        else
+        {
+            // Disable short slot time
+            GetWifiPhy(linkId)->SetSlot(MicroSeconds(20));
+        }
+    }
+}
+
+MgtBeaconHeader
+ApWifiMac::GetBeaconHeader(uint8_t linkId)
+{
+    NS_LOG_FUNCTION(this << +linkId);
     MgtBeaconHeader beacon;
     beacon.Get<Ssid>() = GetSsid();
     auto supportedRates = GetSupportedRates(linkId);
@@ -1376,8 +1511,6 @@ ApWifiMac::SendOneBeacon(uint8_t linkId)
     beacon.Get<ExtendedSupportedRatesIE>() = supportedRates.extendedRates;
     beacon.SetBeaconIntervalUs(GetBeaconInterval().GetMicroSeconds());
     beacon.Capabilities() = GetCapabilities(linkId);
-    GetWifiRemoteStationManager(linkId)->SetShortPreambleEnabled(link.shortPreambleEnabled);
-    GetWifiRemoteStationManager(linkId)->SetShortSlotTimeEnabled(link.shortSlotTimeEnabled);
     if (GetDsssSupported(linkId))
     {
         beacon.Get<DsssParameterSet>() = GetDsssParameterSet(linkId);
@@ -1439,28 +1572,16 @@ ApWifiMac::SendOneBeacon(uint8_t linkId)
             beacon.Get<MultiLinkElement>() = GetMultiLinkElement(linkId, WIFI_MAC_MGT_BEACON);
         }
     }
-    packet->AddHeader(beacon);
-
-    // The beacon has it's own special queue, so we load it in there
-    m_beaconTxop->Queue(packet, hdr);
-    link.beaconEvent =
-        Simulator::Schedule(GetBeaconInterval(), &ApWifiMac::SendOneBeacon, this, linkId);
+    return beacon;
+}
 
-    // If a STA that does not support Short Slot Time associates,
-    // the AP shall use long slot time beginning at the first Beacon
-    // subsequent to the association of the long slot time STA.
-    if (GetErpSupported(linkId))
+void
+ApWifiMac::ResetBeaconCache()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto linkId : GetLinkIds())
     {
-        if (link.shortSlotTimeEnabled)
-        {
-            // Enable short slot time
-            GetWifiPhy(linkId)->SetSlot(MicroSeconds(9));
-        }
-        else
-        {
-            // Disable short slot time
-            GetWifiPhy(linkId)->SetSlot(MicroSeconds(20));
-        }
+        GetLink(linkId).beaconBody.clear();
     }
 }
 
@@ -1821,6 +1942,7 @@ ApWifiMac::Receive(Ptr<const WifiMpdu> mpdu, uint8_t linkId)
                         }
                         UpdateShortSlotTimeEnabled(linkId);
                         UpdateShortPreambleEnabled(linkId);
+                        ResetBeaconCache();
                         StaSwitchingToActiveModeOrDeassociated(from, linkId);
                         break;
                     }
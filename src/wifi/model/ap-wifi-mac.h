@@ -27,6 +27,7 @@
 
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 namespace ns3
 {
@@ -48,6 +49,7 @@ class UniformRandomVariable;
 class MgtAssocRequestHeader;
 class MgtReassocRequestHeader;
 class MgtAssocResponseHeader;
+class MgtBeaconHeader;
 class MgtEmlOmn;
 
 /// variant holding a  reference to a (Re)Association Request
@@ -80,6 +82,7 @@ class ApWifiMac : public WifiMac
     bool SupportsSendFrom() const override;
     Ptr<WifiMacQueue> GetTxopQueue(AcIndex ac) const override;
     void ConfigureStandard(WifiStandard standard) override;
+    void NotifyChannelSwitching(uint8_t linkId) override;
 
     /**
      * \param interval the interval between two beacon transmissions.
@@ -191,6 +194,9 @@ class ApWifiMac : public WifiMac
         bool shortSlotTimeEnabled{
             false}; //!< Flag whether short slot time is enabled within the BSS
         bool shortPreambleEnabled{false}; //!< Flag whether short preamble is enabled in the BSS
+        std::vector<uint8_t> beaconBody;  //!< Serialized body (except for the Timestamp field)
+                                          //!< of the Beacon frame (empty if not cached)
+        Ssid beaconSsid;                  //!< SSID included in the cached Beacon frame body
     };
 
     /**
@@ -354,6 +360,19 @@ class ApWifiMac : public WifiMac
      * \param linkId the ID of the given link
      */
     void SendOneBeacon(uint8_t linkId);
+    /**
+     * Get the body of the Beacon frame to transmit on the given link.
+     *
+     * \param linkId the ID of the given link
+     * \return the body of the Beacon frame
+     */
+    MgtBeaconHeader GetBeaconHeader(uint8_t linkId);
+    /**
+     * Discard the cached Beacon frame bodies of all the links, so that they are rebuilt
+     * before the next Beacon frame is transmitted. This function has to be called when
+     * the BSS configuration advertised in Beacon frames changes.
+     */
+    void ResetBeaconCache();
 
     /**
      * Process the Power Management bit in the Frame Control field of an MPDU
@@ -519,6 +538,7 @@ class ApWifiMac : public WifiMac
     Ptr<Txop> m_beaconTxop;        //!< Dedicated Txop for beacons
     bool m_enableBeaconGeneration; //!< Flag whether beacons are being generated
     Time m_beaconInterval;         //!< Beacon interval
+    bool m_cacheBeacons;           //!< Flag whether the Beacon frame bodies are cached
     Ptr<UniformRandomVariable>
         m_beaconJitter; //!< UniformRandomVariable used to randomize the time of the first beacon
     bool m_enableBeaconJitter; //!< Flag whether the first beacon should be generated at random time
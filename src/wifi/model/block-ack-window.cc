@@ -23,13 +23,20 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <bit>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("BlockAckWindow");
 
+/// number of elements stored in a word of the bitmap
+static constexpr std::size_t BITS_PER_WORD = 64;
+
 BlockAckWindow::BlockAckWindow()
     : m_winStart(0),
+      m_winSize(0),
       m_head(0)
 {
 }
@@ -39,14 +46,15 @@ BlockAckWindow::Init(uint16_t winStart, uint16_t winSize)
 {
     NS_LOG_FUNCTION(this << winStart << winSize);
     m_winStart = winStart;
-    m_window.assign(winSize, false);
+    m_winSize = winSize;
+    m_window.assign((winSize + BITS_PER_WORD - 1) / BITS_PER_WORD, 0);
     m_head = 0;
 }
 
 void
 BlockAckWindow::Reset(uint16_t winStart)
 {
-    Init(winStart, m_window.size());
+    Init(winStart, m_winSize);
 }
 
 uint16_t
@@ -58,29 +66,104 @@ BlockAckWindow::GetWinStart() const
 uint16_t
 BlockAckWindow::GetWinEnd() const
 {
-    return (m_winStart + m_window.size() - 1) % SEQNO_SPACE_SIZE;
+    return (m_winStart + m_winSize - 1) % SEQNO_SPACE_SIZE;
 }
 
 std::size_t
 BlockAckWindow::GetWinSize() const
 {
-    return m_window.size();
+    return m_winSize;
 }
 
-std::vector<bool>::reference
-BlockAckWindow::At(std::size_t distance)
+bool
+BlockAckWindow::At(std::size_t distance) const
 {
-    NS_ASSERT(distance < m_window.size());
+    NS_ASSERT(distance < m_winSize);
 
-    return m_window.at((m_head + distance) % m_window.size());
+    std::size_t index = (m_head + distance) % m_winSize;
+    return (m_window[index / BITS_PER_WORD] >> (index % BITS_PER_WORD)) & 1;
 }
 
-std::vector<bool>::const_reference
-BlockAckWindow::At(std::size_t distance) const
+void
+BlockAckWindow::Set(std::size_t distance)
+{
+    NS_ASSERT(distance < m_winSize);
+
+    std::size_t index = (m_head + distance) % m_winSize;
+    m_window[index / BITS_PER_WORD] |= uint64_t(1) << (index % BITS_PER_WORD);
+}
+
+std::size_t
+BlockAckWindow::Find(std::size_t begin, std::size_t end, bool value) const
 {
-    NS_ASSERT(distance < m_window.size());
+    while (begin < end)
+    {
+        uint64_t word = value ? m_window[begin / BITS_PER_WORD] : ~m_window[begin / BITS_PER_WORD];
+        // ignore the elements preceding begin in this word
+        word &= ~uint64_t(0) << (begin % BITS_PER_WORD);
+
+        if (word != 0)
+        {
+            // the bits beyond the window size in the last word are never set, hence
+            // they may only be found when searching for unset elements
+            return std::min(begin - begin % BITS_PER_WORD + std::countr_zero(word), end);
+        }
+        begin += BITS_PER_WORD - begin % BITS_PER_WORD;
+    }
+    return end;
+}
+
+std::size_t
+BlockAckWindow::FindNext(std::size_t distance, bool value) const
+{
+    if (distance >= m_winSize)
+    {
+        return m_winSize;
+    }
+
+    std::size_t index = (m_head + distance) % m_winSize;
 
-    return m_window.at((m_head + distance) % m_window.size());
+    if (index >= m_head)
+    {
+        // search between the given element and the end of the bitmap
+        if (auto found = Find(index, m_winSize, value); found < m_winSize)
+        {
+            return found - m_head;
+        }
+        index = 0;
+    }
+    // search between the given element (or the beginning of the bitmap) and the head
+    if (auto found = Find(index, m_head, value); found < m_head)
+    {
+        return m_winSize - m_head + found;
+    }
+    return m_winSize;
+}
+
+std::size_t
+BlockAckWindow::FindNextSet(std::size_t distance) const
+{
+    return FindNext(distance, true);
+}
+
+std::size_t
+BlockAckWindow::FindNextUnset(std::size_t distance) const
+{
+    return FindNext(distance, false);
+}
+
+void
+BlockAckWindow::Clear(std::size_t begin, std::size_t end)
+{
+    while (begin < end)
+    {
+        std::size_t offset = begin % BITS_PER_WORD;
+        std::size_t count = std::min(BITS_PER_WORD - offset, end - begin);
+        uint64_t mask = (count == BITS_PER_WORD ? ~uint64_t(0) : ((uint64_t(1) << count) - 1))
+                        << offset;
+        m_window[begin / BITS_PER_WORD] &= ~mask;
+        begin += count;
+    }
 }
 
 void
@@ -88,17 +171,20 @@ BlockAckWindow::Advance(std::size_t count)
 {
     NS_LOG_FUNCTION(this << count);
 
-    if (count >= m_window.size())
+    if (count >= m_winSize)
     {
         Reset((m_winStart + count) % SEQNO_SPACE_SIZE);
         return;
     }
 
-    for (std::size_t i = 0; i < count; i++)
+    // clear the elements between the head and the new head, which become the tail
+    std::size_t newHead = m_head + count;
+    Clear(m_head, std::min(newHead, m_winSize));
+    if (newHead > m_winSize)
     {
-        m_window[m_head] = false;
-        m_head = (m_head + 1) % m_window.size();
+        Clear(0, newHead - m_winSize);
     }
+    m_head = newHead % m_winSize;
     m_winStart = (m_winStart + count) % SEQNO_SPACE_SIZE;
 }
 
@@ -27,6 +27,7 @@
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 
+#include <optional>
 #include <sstream>
 
 #undef NS_LOG_APPEND_CONTEXT
@@ -495,12 +496,13 @@ ChannelAccessManager::DoGrantDcfAccess()
     NS_LOG_FUNCTION(this);
     uint32_t k = 0;
     Time now = Simulator::Now();
+    Time accessGrantStart = GetAccessGrantStart();
     for (auto i = m_txops.begin(); i != m_txops.end(); k++)
     {
         Ptr<Txop> txop = *i;
         if (txop->GetAccessStatus(m_linkId) == Txop::REQUESTED &&
             (!txop->IsQosTxop() || !StaticCast<QosTxop>(txop)->EdcaDisabled(m_linkId)) &&
-            GetBackoffEndFor(txop) <= now)
+            GetBackoffEndFor(txop, accessGrantStart) <= now)
         {
             /**
              * This is the first Txop we find with an expired backoff and which
@@ -515,7 +517,7 @@ ChannelAccessManager::DoGrantDcfAccess()
             {
                 Ptr<Txop> otherTxop = *j;
                 if (otherTxop->GetAccessStatus(m_linkId) == Txop::REQUESTED &&
-                    GetBackoffEndFor(otherTxop) <= now)
+                    GetBackoffEndFor(otherTxop, accessGrantStart) <= now)
                 {
                     NS_LOG_DEBUG(
                         "dcf " << k << " needs access. backoff expired. internal collision. slots="
@@ -562,6 +564,8 @@ ChannelAccessManager::DoGrantDcfAccess()
                 // but did not transmit anything
                 i--;
                 k = std::distance(m_txops.begin(), i);
+                // the attempt to start a transmission may have changed our state
+                accessGrantStart = GetAccessGrantStart();
             }
         }
         i++;
@@ -634,10 +638,16 @@ ChannelAccessManager::GetAccessGrantStart(bool ignoreNav) const
 Time
 ChannelAccessManager::GetBackoffStartFor(Ptr<Txop> txop)
 {
-    NS_LOG_FUNCTION(this << txop);
+    return GetBackoffStartFor(txop, GetAccessGrantStart());
+}
+
+Time
+ChannelAccessManager::GetBackoffStartFor(Ptr<Txop> txop, const Time& accessGrantStart)
+{
+    NS_LOG_FUNCTION(this << txop << accessGrantStart);
     Time mostRecentEvent =
         std::max({txop->GetBackoffStart(m_linkId),
-                  GetAccessGrantStart() + (txop->GetAifsn(m_linkId) * GetSlot())});
+                  accessGrantStart + (txop->GetAifsn(m_linkId) * GetSlot())});
     NS_LOG_DEBUG("Backoff start: " << mostRecentEvent.As(Time::US));
 
     return mostRecentEvent;
@@ -646,8 +656,15 @@ ChannelAccessManager::GetBackoffStartFor(Ptr<Txop> txop)
 Time
 ChannelAccessManager::GetBackoffEndFor(Ptr<Txop> txop)
 {
-    NS_LOG_FUNCTION(this << txop);
-    Time backoffEnd = GetBackoffStartFor(txop) + (txop->GetBackoffSlots(m_linkId) * GetSlot());
+    return GetBackoffEndFor(txop, GetAccessGrantStart());
+}
+
+Time
+ChannelAccessManager::GetBackoffEndFor(Ptr<Txop> txop, const Time& accessGrantStart)
+{
+    NS_LOG_FUNCTION(this << txop << accessGrantStart);
+    Time backoffEnd = GetBackoffStartFor(txop, accessGrantStart) +
+                      (txop->GetBackoffSlots(m_linkId) * GetSlot());
     NS_LOG_DEBUG("Backoff end: " << backoffEnd.As(Time::US));
 
     return backoffEnd;
@@ -657,10 +674,22 @@ void
 ChannelAccessManager::UpdateBackoff()
 {
     NS_LOG_FUNCTION(this);
+    // the access grant start only depends on the state of this object, hence it is
+    // computed once for all the Txops
+    const Time accessGrantStart = GetAccessGrantStart();
+    if (accessGrantStart > Simulator::Now())
+    {
+        // the backoff start time of every Txop is later than the access grant start,
+        // hence no backoff can be updated. This is the common case when the PHY
+        // notifies the start of a busy period (e.g., an overheard frame) while the
+        // medium was busy already
+        NS_LOG_DEBUG("Medium not idle since at least a SIFS, no backoff to update");
+        return;
+    }
     uint32_t k = 0;
     for (auto txop : m_txops)
     {
-        Time backoffStart = GetBackoffStartFor(txop);
+        Time backoffStart = GetBackoffStartFor(txop, accessGrantStart);
         if (backoffStart <= Simulator::Now())
         {
             uint32_t nIntSlots = ((Simulator::Now() - backoffStart) / GetSlot()).GetHigh();
@@ -698,11 +727,16 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded()
      */
     bool accessTimeoutNeeded = false;
     Time expectedBackoffEnd = Simulator::GetMaximumSimulationTime();
+    std::optional<Time> accessGrantStart; // computed only if a Txop requested access
     for (auto txop : m_txops)
     {
         if (txop->GetAccessStatus(m_linkId) == Txop::REQUESTED)
         {
-            Time tmp = GetBackoffEndFor(txop);
+            if (!accessGrantStart)
+            {
+                accessGrantStart = GetAccessGrantStart();
+            }
+            Time tmp = GetBackoffEndFor(txop, *accessGrantStart);
             if (tmp > Simulator::Now())
             {
                 accessTimeoutNeeded = true;
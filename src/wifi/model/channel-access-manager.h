@@ -336,6 +336,18 @@ class ChannelAccessManager : public Object
      * \return the time when the backoff procedure started
      */
     Time GetBackoffStartFor(Ptr<Txop> txop);
+    /**
+     * Return the time when the backoff procedure
+     * started for the given Txop, given the time returned by GetAccessGrantStart().
+     * This allows to compute the access grant start once when the backoff of
+     * multiple Txops needs to be evaluated.
+     *
+     * \param txop the Txop
+     * \param accessGrantStart the time returned by GetAccessGrantStart()
+     *
+     * \return the time when the backoff procedure started
+     */
+    Time GetBackoffStartFor(Ptr<Txop> txop, const Time& accessGrantStart);
     /**
      * Return the time when the backoff procedure
      * ended (or will ended) for the given Txop.
@@ -345,6 +357,17 @@ class ChannelAccessManager : public Object
      * \return the time when the backoff procedure ended (or will ended)
      */
     Time GetBackoffEndFor(Ptr<Txop> txop);
+    /**
+     * Return the time when the backoff procedure
+     * ended (or will ended) for the given Txop, given the time returned by
+     * GetAccessGrantStart().
+     *
+     * \param txop the Txop
+     * \param accessGrantStart the time returned by GetAccessGrantStart()
+     *
+     * \return the time when the backoff procedure ended (or will ended)
+     */
+    Time GetBackoffEndFor(Ptr<Txop> txop, const Time& accessGrantStart);
     /**
      * This method determines whether the medium has been idle during a period (of
      * non-null duration) immediately preceding the time this method is called. If
@@ -22,12 +22,81 @@
 #include "ns3/abort.h"
 #include "ns3/assert.h"
 
+#include <algorithm>
+#include <bitset>
 #include <optional>
 #include <tuple>
 
 namespace ns3
 {
 
+/// maximum absolute value of a tone index (160 MHz HE PPDU)
+static constexpr int16_t MAX_TONE_INDEX = 1012;
+
+/// bitmask of the tones (from -MAX_TONE_INDEX to MAX_TONE_INDEX) occupied by an RU
+using HeRuToneMask = std::bitset<2 * MAX_TONE_INDEX + 1>;
+
+/**
+ * Get the bitmask of the tones occupied by the RU having the given index among all
+ * the RUs of the given type (number of tones) available in a HE PPDU of the given
+ * bandwidth. Bitmasks are computed the first time they are requested and then cached.
+ *
+ * \param bw the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
+ * \param ruType the RU type (number of tones)
+ * \param index the index (starting at 1) of the RU, as passed to HeRu::GetSubcarrierGroup()
+ * \return the bitmask of the tones occupied by the RU
+ */
+static const HeRuToneMask&
+GetHeRuToneMask(uint16_t bw, HeRu::RuType ruType, std::size_t index)
+{
+    static std::map<std::tuple<uint16_t, HeRu::RuType, std::size_t>, HeRuToneMask> masks;
+
+    auto [it, inserted] = masks.try_emplace({bw, ruType, index});
+    if (inserted)
+    {
+        for (const auto& [first, last] : HeRu::GetSubcarrierGroup(bw, ruType, index))
+        {
+            for (auto tone = first; tone <= last; ++tone)
+            {
+                it->second.set(tone + MAX_TONE_INDEX);
+            }
+        }
+    }
+    return it->second;
+}
+
+/**
+ * Check whether the two given RUs overlap.
+ *
+ * \param bw the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
+ * \param ru the first RU
+ * \param other the second RU
+ * \return whether the two given RUs overlap
+ */
+static bool
+DoHeRusOverlap(uint16_t bw, const HeRu::RuSpec& ru, const HeRu::RuSpec& other)
+{
+    // A 2x996-tone RU spans 160 MHz, hence it overlaps with any other RU
+    if (bw == 160 && ru.GetRuType() == HeRu::RU_2x996_TONE)
+    {
+        return true;
+    }
+
+    if (ru.GetPrimary80MHz() != other.GetPrimary80MHz())
+    {
+        // the two RUs are located in distinct 80MHz bands
+        return false;
+    }
+
+    // This function may be called by the MAC layer, hence the PHY index may have
+    // not been set yet. Hence, we pass the "MAC" index to GetSubcarrierGroup instead
+    // of the PHY index. This is fine because we compared the primary 80 MHz bands of
+    // the two RUs above.
+    return (GetHeRuToneMask(bw, ru.GetRuType(), ru.GetIndex()) &
+            GetHeRuToneMask(bw, other.GetRuType(), other.GetIndex()))
+        .any();
+}
+
 const HeRu::SubcarrierGroups HeRu::m_heRuSubcarrierGroups = {
     // RUs in a 20 MHz HE PPDU (Table 28-6)
     {{20, HeRu::RU_26_TONE},
@@ -507,16 +576,25 @@ HeRu::GetNRus(uint16_t bw, RuType ruType)
     return (bw == 160 ? 2 : 1) * it->second.size();
 }
 
-std::vector<HeRu::RuSpec>
+const std::vector<HeRu::RuSpec>&
 HeRu::GetRusOfType(uint16_t bw, HeRu::RuType ruType)
 {
+    static std::map<BwTonesPair, std::vector<HeRu::RuSpec>> rusOfType;
+
+    auto [it, inserted] = rusOfType.try_emplace({bw, ruType});
+    auto& ret = it->second;
+    if (!inserted)
+    {
+        return ret;
+    }
+
     if (ruType == HeRu::RU_2x996_TONE)
     {
         NS_ASSERT(bw >= 160);
-        return {{ruType, 1, true}};
+        ret.emplace_back(ruType, 1, true);
+        return ret;
     }
 
-    std::vector<HeRu::RuSpec> ret;
     std::vector<bool> primary80MHzSet{true};
 
     if (bw == 160)
@@ -583,13 +661,23 @@ HeRu::GetCentral26TonesRus(uint16_t bw, HeRu::RuType ruType)
     return ret;
 }
 
-HeRu::SubcarrierGroup
+const HeRu::SubcarrierGroup&
 HeRu::GetSubcarrierGroup(uint16_t bw, RuType ruType, std::size_t phyIndex)
 {
+    static std::map<std::tuple<uint16_t, RuType, std::size_t>, SubcarrierGroup> groups;
+
+    auto [groupIt, inserted] = groups.try_emplace({bw, ruType, phyIndex});
+    auto& group = groupIt->second;
+    if (!inserted)
+    {
+        return group;
+    }
+
     if (ruType == HeRu::RU_2x996_TONE) // handle special case of RU covering 160 MHz channel
     {
         NS_ABORT_MSG_IF(bw != 160, "2x996 tone RU can only be used on 160 MHz band");
-        return {{-1012, -3}, {3, 1012}};
+        group = {{-1012, -3}, {3, 1012}};
+        return group;
     }
 
     // Determine the shift to apply to tone indices for 160 MHz channel (i.e. -1012 to 1012), since
@@ -610,7 +698,7 @@ HeRu::GetSubcarrierGroup(uint16_t bw, RuType ruType, std::size_t phyIndex)
     NS_ABORT_MSG_IF(it == m_heRuSubcarrierGroups.end(), "RU not found");
     NS_ABORT_MSG_IF(indexInLower80MHz > it->second.size(), "RU index not available");
 
-    SubcarrierGroup group = it->second.at(indexInLower80MHz - 1);
+    group = it->second.at(indexInLower80MHz - 1);
     if (bw == 160)
     {
         for (auto& range : group)
@@ -625,52 +713,28 @@ HeRu::GetSubcarrierGroup(uint16_t bw, RuType ruType, std::size_t phyIndex)
 bool
 HeRu::DoesOverlap(uint16_t bw, RuSpec ru, const std::vector<RuSpec>& v)
 {
-    // A 2x996-tone RU spans 160 MHz, hence it overlaps with any other RU
-    if (bw == 160 && ru.GetRuType() == RU_2x996_TONE && !v.empty())
+    return std::any_of(v.cbegin(), v.cend(), [&](const RuSpec& p) {
+        return DoHeRusOverlap(bw, ru, p);
+    });
+}
+
+bool
+HeRu::DoesOverlap(uint16_t bw, RuSpec ru, const SubcarrierGroup& toneRanges, uint8_t p20Index)
+{
+    if (toneRanges.empty())
     {
-        return true;
+        return false;
     }
 
-    // This function may be called by the MAC layer, hence the PHY index may have
-    // not been set yet. Hence, we pass the "MAC" index to GetSubcarrierGroup instead
-    // of the PHY index. This is fine because we compare the primary 80 MHz bands of
-    // the two RUs below.
-    SubcarrierGroup rangesRu = GetSubcarrierGroup(bw, ru.GetRuType(), ru.GetIndex());
-    for (auto& p : v)
+    if (bw == 160 && ru.GetRuType() == RU_2x996_TONE)
     {
-        if (ru.GetPrimary80MHz() != p.GetPrimary80MHz())
-        {
-            // the two RUs are located in distinct 80MHz bands
-            continue;
-        }
-        for (const auto& rangeRu : rangesRu)
-        {
-            SubcarrierGroup rangesP = GetSubcarrierGroup(bw, p.GetRuType(), p.GetIndex());
-            for (auto& rangeP : rangesP)
-            {
-                if (rangeP.second >= rangeRu.first && rangeRu.second >= rangeP.first)
-                {
-                    return true;
-                }
-            }
-        }
+        return true;
     }
-    return false;
-}
 
-bool
-HeRu::DoesOverlap(uint16_t bw, RuSpec ru, const SubcarrierGroup& toneRanges, uint8_t p20Index)
-{
+    const auto& rangesRu = GetSubcarrierGroup(bw, ru.GetRuType(), ru.GetPhyIndex(bw, p20Index));
     for (const auto& range : toneRanges)
     {
-        if (bw == 160 && ru.GetRuType() == RU_2x996_TONE)
-        {
-            return true;
-        }
-
-        SubcarrierGroup rangesRu =
-            GetSubcarrierGroup(bw, ru.GetRuType(), ru.GetPhyIndex(bw, p20Index));
-        for (auto& r : rangesRu)
+        for (const auto& r : rangesRu)
         {
             if (range.second >= r.first && r.second >= range.first)
             {
@@ -707,7 +771,7 @@ HeRu::FindOverlappingRu(uint16_t bw, RuSpec referenceRu, RuType searchedRuType)
              ++indexPer80Mhz, ++index)
         {
             RuSpec searchedRu(searchedRuType, index, primary80MHz);
-            if (DoesOverlap(bw, referenceRu, {searchedRu}))
+            if (DoHeRusOverlap(bw, referenceRu, searchedRu))
             {
                 return searchedRu;
             }
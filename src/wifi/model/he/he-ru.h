@@ -176,11 +176,13 @@ class HeRu
      * Get the set of distinct RUs of the given type (number of tones)
      * available in a HE PPDU of the given bandwidth.
      *
+     * The set is computed the first time it is requested and then cached.
+     *
      * \param bw the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
      * \param ruType the RU type (number of tones)
      * \return the set of distinct RUs available
      */
-    static std::vector<HeRu::RuSpec> GetRusOfType(uint16_t bw, HeRu::RuType ruType);
+    static const std::vector<HeRu::RuSpec>& GetRusOfType(uint16_t bw, HeRu::RuType ruType);
 
     /**
      * Get the set of 26-tone RUs that can be additionally allocated if the given
@@ -199,19 +201,24 @@ class HeRu
      * indicating the lowest frequency index and the highest frequency index.
      * Note that for channel width of 160 MHz the returned range is relative to
      * the 160 MHz channel (i.e. -1012 to 1012). The PHY index parameter is used to
-     * distinguish between lower and higher 80 MHz subchannels.
+     * distinguish between lower and higher 80 MHz subchannels. The subcarrier group
+     * is computed the first time it is requested and then cached.
      *
      * \param bw the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
      * \param ruType the RU type (number of tones)
      * \param phyIndex the PHY index (starting at 1) of the RU
      * \return the subcarrier range of the specified RU
      */
-    static SubcarrierGroup GetSubcarrierGroup(uint16_t bw, RuType ruType, std::size_t phyIndex);
+    static const SubcarrierGroup& GetSubcarrierGroup(uint16_t bw,
+                                                     RuType ruType,
+                                                     std::size_t phyIndex);
 
     /**
      * Check whether the given RU overlaps with the given set of RUs.
      * Note that for channel width of 160 MHz the returned range is relative to
      * the 160 MHz channel (i.e. -1012 to 1012).
+     * The check is performed by intersecting (cached) bitmasks of the tones
+     * occupied by the RUs.
      *
      * \param bw the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
      * \param ru the given RU allocation
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "heap-multi-user-scheduler.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("HeapMultiUserScheduler");
+
+/**
+ * The common offset is folded into the credits of the stations when it exceeds
+ * this value, so as to preserve the precision of the stored credits.
+ */
+static constexpr double CREDIT_OFFSET_REBASE_THRESHOLD = 1e9;
+
+StationCreditQueue::StationCreditQueue()
+    : m_offset(0),
+      m_maxCredits(std::numeric_limits<double>::max()),
+      m_nextSeq(0)
+{
+}
+
+void
+StationCreditQueue::SetMaxCredits(double maxCredits)
+{
+    m_maxCredits = maxCredits;
+}
+
+bool
+StationCreditQueue::Add(uint16_t aid, Mac48Address address)
+{
+    if (m_aidToEntry.find(aid) != m_aidToEntry.end())
+    {
+        return false;
+    }
+    auto it = m_entries.insert(Entry{aid, address, -m_offset, m_nextSeq++}).first;
+    m_aidToEntry.emplace(aid, it);
+    return true;
+}
+
+bool
+StationCreditQueue::Remove(uint16_t aid)
+{
+    auto mapIt = m_aidToEntry.find(aid);
+    if (mapIt == m_aidToEntry.end())
+    {
+        return false;
+    }
+    m_entries.erase(mapIt->second);
+    m_aidToEntry.erase(mapIt);
+    return true;
+}
+
+void
+StationCreditQueue::Clear()
+{
+    m_entries.clear();
+    m_aidToEntry.clear();
+    m_offset = 0;
+}
+
+std::size_t
+StationCreditQueue::GetSize() const
+{
+    return m_entries.size();
+}
+
+bool
+StationCreditQueue::IsEmpty() const
+{
+    return m_entries.empty();
+}
+
+void
+StationCreditQueue::AddCreditsToAll(double credits)
+{
+    // Capping every station after each grant is equivalent to capping the sum of
+    // all the grants when the credits are read, because grants are non-negative
+    NS_ASSERT(credits >= 0);
+    m_offset += credits;
+
+    if (m_offset > CREDIT_OFFSET_REBASE_THRESHOLD)
+    {
+        Rebase();
+    }
+}
+
+void
+StationCreditQueue::Debit(uint16_t aid, double debits)
+{
+    auto mapIt = m_aidToEntry.find(aid);
+    NS_ASSERT_MSG(mapIt != m_aidToEntry.end(), "AID " << aid << " not found");
+
+    auto node = m_entries.extract(mapIt->second);
+    auto& credits = node.value().credits;
+    credits = std::min(credits + m_offset, m_maxCredits) - debits - m_offset;
+    mapIt->second = m_entries.insert(std::move(node)).position;
+}
+
+double
+StationCreditQueue::GetCredits(uint16_t aid) const
+{
+    auto mapIt = m_aidToEntry.find(aid);
+    NS_ASSERT_MSG(mapIt != m_aidToEntry.end(), "AID " << aid << " not found");
+    return GetCredits(mapIt->second);
+}
+
+double
+StationCreditQueue::GetCredits(ConstIterator it) const
+{
+    return std::min(it->credits + m_offset, m_maxCredits);
+}
+
+StationCreditQueue::ConstIterator
+StationCreditQueue::begin() const
+{
+    return m_entries.begin();
+}
+
+StationCreditQueue::ConstIterator
+StationCreditQueue::end() const
+{
+    return m_entries.end();
+}
+
+void
+StationCreditQueue::Rebase()
+{
+    Container entries;
+    for (const auto& entry : m_entries)
+    {
+        auto it = entries.insert(entries.end(),
+                                 Entry{entry.aid,
+                                       entry.address,
+                                       std::min(entry.credits + m_offset, m_maxCredits),
+                                       entry.seq});
+        m_aidToEntry[entry.aid] = it;
+    }
+    m_entries.swap(entries);
+    m_offset = 0;
+}
+
+NS_OBJECT_ENSURE_REGISTERED(HeapMultiUserScheduler);
+
+TypeId
+HeapMultiUserScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::HeapMultiUserScheduler")
+                            .SetParent<RrMultiUserScheduler>()
+                            .SetGroupName("Wifi")
+                            .AddConstructor<HeapMultiUserScheduler>();
+    return tid;
+}
+
+HeapMultiUserScheduler::HeapMultiUserScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+HeapMultiUserScheduler::~HeapMultiUserScheduler()
+{
+    NS_LOG_FUNCTION_NOARGS();
+}
+
+void
+HeapMultiUserScheduler::DoInitialize()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& ac : wifiAcList)
+    {
+        m_staQueueDl.insert({ac.first, {}});
+    }
+    RrMultiUserScheduler::DoInitialize();
+}
+
+void
+HeapMultiUserScheduler::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_staQueueDl.clear();
+    m_staQueueUl.Clear();
+    RrMultiUserScheduler::DoDispose();
+}
+
+StationCreditQueue&
+HeapMultiUserScheduler::GetStaQueue(StaListId list)
+{
+    return list ? m_staQueueDl[*list] : m_staQueueUl;
+}
+
+void
+HeapMultiUserScheduler::AddStation(uint16_t aid, Mac48Address address)
+{
+    NS_LOG_FUNCTION(this << aid << address);
+
+    // if this is not the first STA of a non-AP MLD to be notified, an entry
+    // for this non-AP MLD already exists and is left unchanged
+    for (auto& staQueue : m_staQueueDl)
+    {
+        staQueue.second.Add(aid, address);
+    }
+    m_staQueueUl.Add(aid, address);
+}
+
+void
+HeapMultiUserScheduler::RemoveStation(uint16_t aid)
+{
+    NS_LOG_FUNCTION(this << aid);
+
+    for (auto& staQueue : m_staQueueDl)
+    {
+        staQueue.second.Remove(aid);
+    }
+    m_staQueueUl.Remove(aid);
+}
+
+std::size_t
+HeapMultiUserScheduler::GetNStations(StaListId list) const
+{
+    if (!list)
+    {
+        return m_staQueueUl.GetSize();
+    }
+    auto it = m_staQueueDl.find(*list);
+    return it != m_staQueueDl.cend() ? it->second.GetSize() : 0;
+}
+
+void
+HeapMultiUserScheduler::VisitStations(StaListId list, const StaVisitor& visitor)
+{
+    // visit the stations in decreasing order of credits, stopping as soon as
+    // enough stations have been found
+    for (const auto& entry : GetStaQueue(list))
+    {
+        if (!visitor(entry.aid, entry.address))
+        {
+            break;
+        }
+    }
+}
+
+void
+HeapMultiUserScheduler::ChargeStations(StaListId list,
+                                       double creditsPerSta,
+                                       double maxCredits,
+                                       const std::map<uint16_t, double>& debits)
+{
+    auto& staQueue = GetStaQueue(list);
+    staQueue.SetMaxCredits(maxCredits);
+    staQueue.AddCreditsToAll(creditsPerSta);
+    for (const auto& [aid, amount] : debits)
+    {
+        staQueue.Debit(aid, amount);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef HEAP_MULTI_USER_SCHEDULER_H
+#define HEAP_MULTI_USER_SCHEDULER_H
+
+#include "rr-multi-user-scheduler.h"
+
+#include <map>
+#include <set>
+#include <unordered_map>
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ *
+ * StationCreditQueue keeps a set of stations ordered by decreasing amount of
+ * credits. Credits granted to all the stations are accumulated in a common
+ * offset, hence crediting all the stations takes constant time, while debiting
+ * a station takes logarithmic time. Stations are visited in decreasing order
+ * of credits by iterating over the queue.
+ */
+class StationCreditQueue
+{
+  public:
+    /**
+     * Information stored for every station
+     */
+    struct Entry
+    {
+        uint16_t aid;         //!< station's AID
+        Mac48Address address; //!< station's MAC Address
+        double credits;       //!< credits, not including the common offset
+        uint64_t seq;         //!< insertion order, used to break ties
+    };
+
+    /**
+     * Functor ordering entries by decreasing amount of credits
+     */
+    struct Compare
+    {
+        /**
+         * \param a the first entry
+         * \param b the second entry
+         * \return whether a precedes b
+         */
+        bool operator()(const Entry& a, const Entry& b) const
+        {
+            return a.credits > b.credits || (a.credits == b.credits && a.seq < b.seq);
+        }
+    };
+
+    /// Container of the entries
+    using Container = std::set<Entry, Compare>;
+    /// Const iterator over the entries
+    using ConstIterator = Container::const_iterator;
+
+    StationCreditQueue();
+
+    /**
+     * Set the maximum amount of credits a station can have.
+     *
+     * \param maxCredits the maximum amount of credits
+     */
+    void SetMaxCredits(double maxCredits);
+
+    /**
+     * Add a station with no credits, if not already present.
+     *
+     * \param aid the AID of the station
+     * \param address the MAC address of the station
+     * \return true if the station has been added
+     */
+    bool Add(uint16_t aid, Mac48Address address);
+    /**
+     * Remove a station, if present.
+     *
+     * \param aid the AID of the station
+     * \return true if the station has been removed
+     */
+    bool Remove(uint16_t aid);
+    /**
+     * Remove all the stations.
+     */
+    void Clear();
+
+    /**
+     * \return the number of stations
+     */
+    std::size_t GetSize() const;
+    /**
+     * \return whether the queue contains no station
+     */
+    bool IsEmpty() const;
+
+    /**
+     * Grant the given amount of credits to all the stations. The amount of credits of
+     * each station is capped to the maximum amount of credits.
+     *
+     * \param credits the amount of credits to grant
+     */
+    void AddCreditsToAll(double credits);
+    /**
+     * Subtract the given amount of credits from the given station.
+     *
+     * \param aid the AID of the station
+     * \param debits the amount of credits to subtract
+     */
+    void Debit(uint16_t aid, double debits);
+
+    /**
+     * \param aid the AID of the station
+     * \return the amount of credits of the given station
+     */
+    double GetCredits(uint16_t aid) const;
+    /**
+     * \param it an iterator to a station in the queue
+     * \return the amount of credits of the station
+     */
+    double GetCredits(ConstIterator it) const;
+
+    /**
+     * \return an iterator to the station having the largest amount of credits
+     */
+    ConstIterator begin() const;
+    /**
+     * \return the past-the-end iterator
+     */
+    ConstIterator end() const;
+
+  private:
+    /**
+     * Fold the common offset into the credits of every station, so that the offset
+     * does not grow unboundedly.
+     */
+    void Rebase();
+
+    Container m_entries;                                       //!< the stations
+    std::unordered_map<uint16_t, ConstIterator> m_aidToEntry; //!< AID-indexed entries
+    double m_offset;                                           //!< credits granted to all
+    double m_maxCredits;                                       //!< max amount of credits
+    uint64_t m_nextSeq;                                        //!< next insertion order
+};
+
+/**
+ * \ingroup wifi
+ *
+ * HeapMultiUserScheduler implements the same policy as RrMultiUserScheduler, i.e.,
+ * it assigns RUs of equal size to the stations having the largest amount of credits,
+ * but it is meant to scale to a large number of associated stations. Per-AC and UL
+ * stations are kept in a StationCreditQueue, hence granting credits after a transmission
+ * does not require to walk all the stations and re-sort them, and the candidate stations
+ * are found by visiting the stations in decreasing order of credits until enough stations
+ * are found.
+ *
+ * Stations are granted and charged credits as in RrMultiUserScheduler, but stations that
+ * reached the maximum amount of credits may be served in a different order.
+ */
+class HeapMultiUserScheduler : public RrMultiUserScheduler
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    HeapMultiUserScheduler();
+    ~HeapMultiUserScheduler() override;
+
+  protected:
+    void DoDispose() override;
+    void DoInitialize() override;
+
+    void AddStation(uint16_t aid, Mac48Address address) override;
+    void RemoveStation(uint16_t aid) override;
+    std::size_t GetNStations(StaListId list) const override;
+    void VisitStations(StaListId list, const StaVisitor& visitor) override;
+    void ChargeStations(StaListId list,
+                        double creditsPerSta,
+                        double maxCredits,
+                        const std::map<uint16_t, double>& debits) override;
+
+  private:
+    /**
+     * \param list the list of stations
+     * \return the queue holding the given list of stations
+     */
+    StationCreditQueue& GetStaQueue(StaListId list);
+
+    std::map<AcIndex, StationCreditQueue> m_staQueueDl; //!< Per-AC queue of stations for DL
+    StationCreditQueue m_staQueueUl;                    //!< Queue of stations to serve for UL
+};
+
+} // namespace ns3
+
+#endif /* HEAP_MULTI_USER_SCHEDULER_H */
@@ -0,0 +1,746 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pf-multi-user-scheduler.h"
+
+#include "he-configuration.h"
+#include "he-frame-exchange-manager.h"
+#include "mu-snr-tag.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-psdu.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <tuple>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PfMultiUserScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(PfMultiUserScheduler);
+
+/**
+ * A set of adjacent 20 MHz subchannels occupied by either a single RU spanning all
+ * of them or, if the block includes a single subchannel, by all the RUs of the given
+ * type in the subchannel.
+ */
+struct RuBlock
+{
+    std::size_t firstSubchannel; //!< index of the first 20 MHz subchannel
+    std::size_t nSubchannels;    //!< number of 20 MHz subchannels
+    HeRu::RuType ruType;         //!< type of the RUs in the block
+};
+
+/**
+ * \param ruType the RU type
+ * \return the number of tones of the given RU type
+ */
+static std::size_t
+GetNTones(HeRu::RuType ruType)
+{
+    switch (ruType)
+    {
+    case HeRu::RU_26_TONE:
+        return 26;
+    case HeRu::RU_52_TONE:
+        return 52;
+    case HeRu::RU_106_TONE:
+        return 106;
+    case HeRu::RU_242_TONE:
+        return 242;
+    case HeRu::RU_484_TONE:
+        return 484;
+    case HeRu::RU_996_TONE:
+        return 996;
+    case HeRu::RU_2x996_TONE:
+        return 2 * 996;
+    default:
+        NS_ABORT_MSG("Unknown RU type");
+    }
+    return 0;
+}
+
+/**
+ * Get a bitmask of the 20 MHz subchannels spanned by the given RU. Bitmasks are
+ * computed the first time and cached afterwards.
+ *
+ * \param bw the channel width in MHz
+ * \param ru the RU
+ * \return a bitmask of the 20 MHz subchannels (least significant bit is the lowest
+ *         subchannel) spanned by the given RU
+ */
+static uint8_t
+GetSubchannelMask(uint16_t bw, const HeRu::RuSpec& ru)
+{
+    static std::map<std::tuple<uint16_t, HeRu::RuType, std::size_t, bool>, uint8_t> masks;
+
+    auto [it, inserted] =
+        masks.try_emplace({bw, ru.GetRuType(), ru.GetIndex(), ru.GetPrimary80MHz()}, 0);
+    if (inserted)
+    {
+        const auto& rus242 = HeRu::GetRusOfType(bw, HeRu::RU_242_TONE);
+        for (std::size_t i = 0; i < rus242.size(); ++i)
+        {
+            if (HeRu::DoesOverlap(bw, ru, {rus242[i]}))
+            {
+                it->second |= (1 << i);
+            }
+        }
+    }
+    return it->second;
+}
+
+/**
+ * \param bw the channel width in MHz
+ * \param block a block of RUs
+ * \return the RUs included in the given block
+ */
+static std::vector<HeRu::RuSpec>
+GetBlockRus(uint16_t bw, const RuBlock& block)
+{
+    std::vector<HeRu::RuSpec> rus;
+    for (const auto& ru : HeRu::GetRusOfType(bw, block.ruType))
+    {
+        if (GetSubchannelMask(bw, ru) & (1 << block.firstSubchannel))
+        {
+            rus.push_back(ru);
+        }
+    }
+    NS_ASSERT(!rus.empty());
+    return rus;
+}
+
+/**
+ * \param block a block of RUs
+ * \return the blocks the given block is split into (empty if the given block cannot be split)
+ */
+static std::vector<RuBlock>
+SplitBlock(const RuBlock& block)
+{
+    if (block.nSubchannels > 1)
+    {
+        auto half = block.nSubchannels / 2;
+        auto ruType = HeRu::GetRuType(20 * half);
+        return {{block.firstSubchannel, half, ruType},
+                {block.firstSubchannel + half, half, ruType}};
+    }
+    switch (block.ruType)
+    {
+    case HeRu::RU_242_TONE:
+        return {{block.firstSubchannel, 1, HeRu::RU_106_TONE}};
+    case HeRu::RU_106_TONE:
+        return {{block.firstSubchannel, 1, HeRu::RU_52_TONE}};
+    case HeRu::RU_52_TONE:
+        return {{block.firstSubchannel, 1, HeRu::RU_26_TONE}};
+    default:
+        return {};
+    }
+}
+
+TypeId
+PfMultiUserScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::PfMultiUserScheduler")
+            .SetParent<HeapMultiUserScheduler>()
+            .SetGroupName("Wifi")
+            .AddConstructor<PfMultiUserScheduler>()
+            .AddAttribute("SnrSmoothingFactor",
+                          "The weight given to a new SNR sample when averaging the log2(1 + SNR) "
+                          "values measured on a 20 MHz subchannel for a station.",
+                          DoubleValue(0.2),
+                          MakeDoubleAccessor(&PfMultiUserScheduler::m_snrSmoothing),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("RateSmoothingFactor",
+                          "The weight given to the rate served in the last DL MU PPDU when "
+                          "averaging the rate served to a station.",
+                          DoubleValue(0.05),
+                          MakeDoubleAccessor(&PfMultiUserScheduler::m_rateSmoothing),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("NCandidates",
+                          "The maximum number of stations with buffered frames (visited in "
+                          "decreasing order of credits) among which the stations served by a "
+                          "DL MU PPDU are selected.",
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&PfMultiUserScheduler::m_nCandidates),
+                          MakeUintegerChecker<uint16_t>(1));
+    return tid;
+}
+
+PfMultiUserScheduler::PfMultiUserScheduler()
+    : m_ulWidth(0),
+      m_nDlMuPpdus(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PfMultiUserScheduler::~PfMultiUserScheduler()
+{
+    NS_LOG_FUNCTION_NOARGS();
+}
+
+void
+PfMultiUserScheduler::DoInitialize()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_apMac);
+    for (const auto linkId : m_apMac->GetLinkIds())
+    {
+        auto phy = m_apMac->GetWifiPhy(linkId);
+        phy->TraceConnectWithoutContext(
+            "PhyTxPsduBegin",
+            MakeCallback(&PfMultiUserScheduler::NotifyTxPsduBegin, this));
+        m_phys.push_back(phy);
+    }
+    HeapMultiUserScheduler::DoInitialize();
+}
+
+void
+PfMultiUserScheduler::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    // the links of the AP may have been already removed when the scheduler is disposed
+    for (const auto& phy : m_phys)
+    {
+        phy->TraceDisconnectWithoutContext(
+            "PhyTxPsduBegin",
+            MakeCallback(&PfMultiUserScheduler::NotifyTxPsduBegin, this));
+    }
+    m_phys.clear();
+    m_staInfo.clear();
+    m_ulRus.clear();
+    m_dlRates.clear();
+    HeapMultiUserScheduler::DoDispose();
+}
+
+std::vector<std::size_t>
+PfMultiUserScheduler::GetMaxWeightMatching(const std::vector<std::vector<double>>& weights)
+{
+    // Hungarian algorithm (Kuhn-Munkres) applied to the costs -weights, using
+    // 1-based indices for rows and columns and the dummy column 0
+    const auto nRows = weights.size();
+    if (nRows == 0)
+    {
+        return {};
+    }
+    const auto nCols = weights[0].size();
+    NS_ASSERT_MSG(nRows <= nCols, "The number of rows cannot exceed the number of columns");
+    const auto inf = std::numeric_limits<double>::infinity();
+
+    std::vector<double> u(nRows + 1, 0);
+    std::vector<double> v(nCols + 1, 0);
+    std::vector<std::size_t> p(nCols + 1, 0); // row assigned to every column
+    std::vector<std::size_t> way(nCols + 1, 0);
+
+    for (std::size_t i = 1; i <= nRows; ++i)
+    {
+        p[0] = i;
+        std::size_t j0 = 0;
+        std::vector<double> minv(nCols + 1, inf);
+        std::vector<bool> used(nCols + 1, false);
+        do
+        {
+            used[j0] = true;
+            auto i0 = p[j0];
+            auto delta = inf;
+            std::size_t j1 = 0;
+            for (std::size_t j = 1; j <= nCols; ++j)
+            {
+                if (!used[j])
+                {
+                    auto cur = -weights[i0 - 1][j - 1] - u[i0] - v[j];
+                    if (cur < minv[j])
+                    {
+                        minv[j] = cur;
+                        way[j] = j0;
+                    }
+                    if (minv[j] < delta)
+                    {
+                        delta = minv[j];
+                        j1 = j;
+                    }
+                }
+            }
+            for (std::size_t j = 0; j <= nCols; ++j)
+            {
+                if (used[j])
+                {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                }
+                else
+                {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+        do
+        {
+            auto j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+
+    std::vector<std::size_t> assignment(nRows);
+    for (std::size_t j = 1; j <= nCols; ++j)
+    {
+        if (p[j] != 0)
+        {
+            assignment[p[j] - 1] = j - 1;
+        }
+    }
+    return assignment;
+}
+
+PfMultiUserScheduler::RuAssignment
+PfMultiUserScheduler::AssignRus(uint16_t bw,
+                                std::size_t nCandidates,
+                                std::size_t maxRus,
+                                const UtilityFunction& utility)
+{
+    NS_ASSERT(bw == 20 || bw == 40 || bw == 80 || bw == 160);
+    NS_ASSERT(nCandidates > 0 && maxRus > 0);
+    maxRus = std::min(maxRus, nCandidates);
+
+    // Evaluate the given layout. Returns the assignment maximizing the sum of the
+    // utilities and such a sum, or an empty assignment if the layout has too many RUs
+    auto evaluate = [&](const std::vector<RuBlock>& blocks) -> std::pair<RuAssignment, double> {
+        std::vector<HeRu::RuSpec> rus;
+        for (const auto& block : blocks)
+        {
+            auto blockRus = GetBlockRus(bw, block);
+            rus.insert(rus.end(), blockRus.cbegin(), blockRus.cend());
+        }
+        if (rus.size() > maxRus)
+        {
+            return {{}, 0};
+        }
+
+        std::vector<std::vector<double>> weights(rus.size(), std::vector<double>(nCandidates));
+        for (std::size_t i = 0; i < rus.size(); ++i)
+        {
+            for (std::size_t j = 0; j < nCandidates; ++j)
+            {
+                weights[i][j] = utility(j, rus[i]);
+            }
+        }
+
+        auto matching = GetMaxWeightMatching(weights);
+        RuAssignment assignment;
+        double sum = 0;
+        for (std::size_t i = 0; i < rus.size(); ++i)
+        {
+            assignment.emplace_back(rus[i], matching[i]);
+            sum += weights[i][matching[i]];
+        }
+        return {assignment, sum};
+    };
+
+    // start with an RU spanning the whole channel and keep on splitting the block
+    // providing the largest increase of the sum of the utilities
+    std::vector<RuBlock> blocks{{0, static_cast<std::size_t>(bw / 20), HeRu::GetRuType(bw)}};
+    auto best = evaluate(blocks);
+
+    while (true)
+    {
+        std::vector<RuBlock> bestBlocks;
+        std::pair<RuAssignment, double> bestSplit{{}, best.second};
+
+        for (std::size_t i = 0; i < blocks.size(); ++i)
+        {
+            auto split = SplitBlock(blocks[i]);
+            if (split.empty())
+            {
+                continue;
+            }
+            auto newBlocks = blocks;
+            newBlocks.erase(newBlocks.begin() + i);
+            newBlocks.insert(newBlocks.begin() + i, split.cbegin(), split.cend());
+
+            auto value = evaluate(newBlocks);
+            if (!value.first.empty() && value.second > bestSplit.second * (1 + 1e-9))
+            {
+                bestSplit = std::move(value);
+                bestBlocks = std::move(newBlocks);
+            }
+        }
+
+        if (bestBlocks.empty())
+        {
+            break;
+        }
+        blocks = std::move(bestBlocks);
+        best = std::move(bestSplit);
+    }
+
+    return best.first;
+}
+
+PfMultiUserScheduler::StaInfo&
+PfMultiUserScheduler::GetStaInfo(uint16_t aid, Mac48Address address)
+{
+    auto [it, inserted] = m_staInfo.try_emplace(aid);
+    if (inserted || it->second.address != address)
+    {
+        // the AID may have been assigned to another station
+        it->second = StaInfo{};
+        it->second.address = address;
+        it->second.lastUpdate = m_nDlMuPpdus;
+    }
+    return it->second;
+}
+
+double
+PfMultiUserScheduler::GetAvgRate(const StaInfo& info) const
+{
+    // the average is aged lazily, so that only served stations need to be updated
+    return info.avgRate * std::pow(1 - m_rateSmoothing, m_nDlMuPpdus - info.lastUpdate);
+}
+
+double
+PfMultiUserScheduler::GetChannelQuality(const StaInfo& info, const HeRu::RuSpec& ru) const
+{
+    if (info.snrWidth != m_allowedWidth)
+    {
+        return 1;
+    }
+
+    double sum = 0;
+    std::size_t count = 0;
+    for (const auto se : info.subchannelSe)
+    {
+        if (se >= 0)
+        {
+            sum += se;
+            count++;
+        }
+    }
+    if (count == 0 || sum <= 0)
+    {
+        return 1;
+    }
+    const auto mean = sum / count;
+
+    const auto mask = GetSubchannelMask(m_allowedWidth, ru);
+    double quality = 0;
+    std::size_t nSubchannels = 0;
+    for (std::size_t i = 0; i < info.subchannelSe.size(); ++i)
+    {
+        if (mask & (1 << i))
+        {
+            quality += (info.subchannelSe[i] >= 0 ? info.subchannelSe[i] / mean : 1);
+            nSubchannels++;
+        }
+    }
+    return (nSubchannels > 0 ? quality / nSubchannels : 1);
+}
+
+void
+PfMultiUserScheduler::NotifyTxPsduBegin(WifiConstPsduMap psduMap,
+                                        WifiTxVector txVector,
+                                        double txPowerW)
+{
+    if (m_ulRus.empty())
+    {
+        return;
+    }
+
+    for (const auto& [staId, psdu] : psduMap)
+    {
+        MuSnrTag tag;
+        if (psdu->GetNMpdus() != 1 || !psdu->GetHeader(0).IsBlockAck() ||
+            !psdu->GetPayload(0)->PeekPacketTag(tag))
+        {
+            continue;
+        }
+
+        NS_LOG_FUNCTION(this << psdu << txVector << txPowerW);
+
+        for (const auto& [aid, ru] : m_ulRus)
+        {
+            auto address = m_apMac->GetMldOrLinkAddressByAid(aid);
+            if (!tag.IsPresent(aid) || !address)
+            {
+                continue;
+            }
+            auto& info = GetStaInfo(aid, *address);
+            if (info.snrWidth != m_ulWidth)
+            {
+                info.subchannelSe.assign(m_ulWidth / 20, -1);
+                info.snrWidth = m_ulWidth;
+            }
+            const auto se = std::log2(1 + tag.Get(aid));
+            const auto mask = GetSubchannelMask(m_ulWidth, ru);
+            for (std::size_t i = 0; i < info.subchannelSe.size(); ++i)
+            {
+                if (mask & (1 << i))
+                {
+                    auto& avg = info.subchannelSe[i];
+                    avg = (avg < 0 ? se : (1 - m_snrSmoothing) * avg + m_snrSmoothing * se);
+                }
+            }
+            NS_LOG_DEBUG("STA " << aid << " measured log2(1+SNR)=" << se << " on RU " << ru);
+        }
+        m_ulRus.clear();
+        return;
+    }
+}
+
+MultiUserScheduler::TxFormat
+PfMultiUserScheduler::TrySendingDlMuPpdu()
+{
+    NS_LOG_FUNCTION(this);
+
+    AcIndex primaryAc = m_edca->GetAccessCategory();
+
+    if (GetNStations(primaryAc) == 0)
+    {
+        NS_LOG_DEBUG("No HE stations associated: return SU_TX");
+        return TxFormat::SU_TX;
+    }
+
+    const auto tids = GetDlMuTids(primaryAc);
+
+    Ptr<HeConfiguration> heConfiguration = m_apMac->GetHeConfiguration();
+    NS_ASSERT(heConfiguration);
+    const auto guardInterval = heConfiguration->GetGuardInterval().GetNanoSeconds();
+
+    /**
+     * Information about the candidate stations
+     */
+    struct Candidate
+    {
+        CandidateInfo info; //!< the station and the MPDU to send
+        uint8_t mcs;        //!< the MCS selected by the remote station manager
+        uint8_t nss;        //!< the number of spatial streams
+        double efficiency;  //!< the rate per 20 MHz of the selected MCS, in Mbps
+        double weight;      //!< the inverse of the average served rate
+        uint32_t backlog;   //!< the bytes buffered for the station and the TID of the MPDU
+    };
+
+    std::vector<Candidate> candidates;
+    bool ehtMu = false;
+
+    // visit the associated stations in decreasing order of credits until enough
+    // stations with buffered frames are found
+    VisitStations(primaryAc, [&](uint16_t aid, Mac48Address address) {
+        if (candidates.size() >= m_nCandidates)
+        {
+            return false;
+        }
+
+        if (ehtMu && !m_apMac->GetEhtSupported(address))
+        {
+            NS_LOG_DEBUG("Skipping non-EHT STA because this DL MU PPDU is sent to EHT STAs only");
+            return true;
+        }
+
+        for (uint8_t tid : tids)
+        {
+            // check that a BA agreement is established with the receiver for the
+            // considered TID, since ack sequences for DL MU PPDUs require block ack
+            if (!m_apMac->GetBaAgreementEstablishedAsOriginator(address, tid))
+            {
+                continue;
+            }
+            auto mpdu =
+                m_apMac->GetQosTxop(QosUtilsMapTidToAc(tid))->PeekNextMpdu(m_linkId, tid, address);
+            if (!mpdu)
+            {
+                NS_LOG_DEBUG("No frames to send to " << address << " with TID=" << +tid);
+                continue;
+            }
+
+            const auto backlog = m_apMac->GetQosTxop(QosUtilsMapTidToAc(tid))
+                                     ->GetWifiMacQueue()
+                                     ->GetNBytes(WifiMacQueueContainer::GetQueueId(mpdu));
+            mpdu = GetHeFem(m_linkId)->CreateAliasIfNeeded(mpdu);
+            WifiTxVector suTxVector =
+                GetWifiRemoteStationManager(m_linkId)->GetDataTxVector(mpdu->GetHeader(),
+                                                                       m_allowedWidth);
+            // the first candidate STA determines the preamble type for the DL MU PPDU
+            if (candidates.empty() && suTxVector.GetPreambleType() == WIFI_PREAMBLE_EHT_MU)
+            {
+                ehtMu = true;
+            }
+
+            const auto& info = GetStaInfo(aid, address);
+            candidates.push_back(
+                {{aid, address, mpdu},
+                 suTxVector.GetMode().GetMcsValue(),
+                 suTxVector.GetNss(),
+                 suTxVector.GetMode().GetDataRate(20, guardInterval, suTxVector.GetNss()) / 1e6,
+                 1 / std::max(GetAvgRate(info), 1e-6),
+                 backlog});
+            NS_LOG_DEBUG("Candidate STA (MAC=" << address << ", AID=" << aid << ") TID=" << +tid);
+            break;
+        }
+        return true;
+    });
+
+    // The TXOP limit can be exceeded by the TXOP holder if it does not transmit more
+    // than one Data or Management frame in the TXOP and the frame is not in an A-MPDU
+    // consisting of more than one MPDU (Sec. 10.22.2.8 of 802.11-2016).
+    // For the moment, we are considering just one MPDU per receiver.
+    Time actualAvailableTime = (m_initialFrame ? Time::Min() : m_availableTime);
+
+    // the duration of the DL MU PPDU is limited by the max PPDU duration and by the
+    // remaining TXOP duration, if any
+    auto maxDuration = GetPpduMaxTime(ehtMu ? WIFI_PREAMBLE_EHT_MU : WIFI_PREAMBLE_HE_MU);
+    if (m_availableTime != Time::Min())
+    {
+        maxDuration = std::min(maxDuration, m_availableTime);
+    }
+    const auto maxDurationUs = static_cast<double>(maxDuration.GetMicroSeconds());
+
+    m_candidates.clear();
+    m_dlRates.clear();
+
+    while (!candidates.empty())
+    {
+        // the rate (in Mbps) a candidate is expected to be served with on an RU, i.e., the
+        // rate achievable on the RU, unless the buffered bytes can be sent at a lower rate
+        auto rate = [&](std::size_t i, const HeRu::RuSpec& ru) {
+            const auto& info = m_staInfo.at(candidates[i].info.aid);
+            const auto ruRate = GetNTones(ru.GetRuType()) / 242.0 *
+                                GetChannelQuality(info, ru) * candidates[i].efficiency;
+            return std::min(ruRate, candidates[i].backlog * 8 / maxDurationUs);
+        };
+        auto assignment =
+            AssignRus(m_allowedWidth,
+                      candidates.size(),
+                      m_nStations,
+                      [&](std::size_t i, const HeRu::RuSpec& ru) {
+                          return candidates[i].weight * rate(i, ru);
+                      });
+
+        m_txParams.Clear();
+        m_txParams.m_txVector.SetPreambleType(ehtMu ? WIFI_PREAMBLE_EHT_MU : WIFI_PREAMBLE_HE_MU);
+        if (ehtMu)
+        {
+            m_txParams.m_txVector.SetEhtPpduType(0); // indicates DL OFDMA transmission
+        }
+        m_txParams.m_txVector.SetChannelWidth(m_allowedWidth);
+        m_txParams.m_txVector.SetGuardInterval(guardInterval);
+        m_txParams.m_txVector.SetBssColor(heConfiguration->GetBssColor());
+
+        std::optional<std::size_t> rejected;
+        for (const auto& [ru, i] : assignment)
+        {
+            const auto& candidate = candidates[i];
+            m_txParams.m_txVector.SetHeMuUserInfo(candidate.info.aid,
+                                                  {ru, candidate.mcs, candidate.nss});
+            if (!GetHeFem(m_linkId)->TryAddMpdu(candidate.info.mpdu,
+                                                m_txParams,
+                                                actualAvailableTime))
+            {
+                NS_LOG_DEBUG("Sending a frame to " << candidate.info.address << " on RU " << ru
+                                                   << " violates the time constraints");
+                rejected = i;
+                break;
+            }
+        }
+
+        if (!rejected)
+        {
+            for (const auto& [ru, i] : assignment)
+            {
+                NS_LOG_DEBUG("Assigning RU " << ru << " to STA " << candidates[i].info.aid);
+                m_candidates.push_back(candidates[i].info);
+                m_dlRates[candidates[i].info.aid] = rate(i, ru);
+            }
+            break;
+        }
+        candidates.erase(candidates.begin() + *rejected);
+    }
+
+    if (m_candidates.empty())
+    {
+        m_txParams.Clear();
+        if (m_forceDlOfdma)
+        {
+            NS_LOG_DEBUG("The AP does not have suitable frames to transmit: return NO_TX");
+            return NO_TX;
+        }
+        NS_LOG_DEBUG("The AP does not have suitable frames to transmit: return SU_TX");
+        return SU_TX;
+    }
+
+    return TxFormat::DL_MU_TX;
+}
+
+void
+PfMultiUserScheduler::FinalizeDlMuTxVector(WifiTxVector& txVector)
+{
+    // RUs have been already assigned by TrySendingDlMuPpdu
+    NS_LOG_FUNCTION(this << txVector);
+    NS_ASSERT(txVector.GetHeMuUserInfoMap().size() == m_candidates.size());
+}
+
+MultiUserScheduler::DlMuInfo
+PfMultiUserScheduler::ComputeDlMuInfo()
+{
+    NS_LOG_FUNCTION(this);
+
+    auto dlMuInfo = HeapMultiUserScheduler::ComputeDlMuInfo();
+
+    if (!dlMuInfo.psduMap.empty())
+    {
+        m_nDlMuPpdus++;
+        for (const auto& [aid, rate] : m_dlRates)
+        {
+            auto& info = m_staInfo.at(aid);
+            info.avgRate = GetAvgRate(info) + m_rateSmoothing * rate;
+            info.lastUpdate = m_nDlMuPpdus;
+        }
+    }
+    m_dlRates.clear();
+
+    return dlMuInfo;
+}
+
+MultiUserScheduler::UlMuInfo
+PfMultiUserScheduler::ComputeUlMuInfo()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_ulRus.clear();
+    if (m_trigger.IsBasic())
+    {
+        // store the RUs assigned to stations, which are needed to map the SNR values
+        // carried by the MuSnrTag to 20 MHz subchannels
+        m_ulWidth = m_trigger.GetUlBandwidth();
+        for (const auto& userInfo : m_trigger)
+        {
+            m_ulRus.emplace(userInfo.GetAid12(), userInfo.GetRuAllocation());
+        }
+    }
+
+    return HeapMultiUserScheduler::ComputeUlMuInfo();
+}
+
+} // namespace ns3
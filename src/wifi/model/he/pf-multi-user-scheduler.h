@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PF_MULTI_USER_SCHEDULER_H
+#define PF_MULTI_USER_SCHEDULER_H
+
+#include "heap-multi-user-scheduler.h"
+
+#include "ns3/wifi-ppdu.h"
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class WifiPhy;
+
+/**
+ * \ingroup wifi
+ *
+ * PfMultiUserScheduler is a proportional fair OFDMA scheduler that assigns RUs of
+ * possibly different sizes to the stations of a DL MU PPDU. The utility of assigning
+ * an RU to a station is the rate the station is expected to achieve on the RU divided
+ * by the average rate the station has been served with so far. The expected rate is
+ * the product of the number of tones of the RU and the spectral efficiency of the MCS
+ * selected by the remote station manager, which is weighted for every 20 MHz subchannel
+ * spanned by the RU based on the SNR values (carried by the MuSnrTag attached to the
+ * Multi-STA BlockAck frames) with which the TB PPDUs sent by the station in the
+ * subchannel have been received. The expected rate is capped by the rate at which the
+ * bytes buffered for the station can be sent within the max duration of the DL MU PPDU,
+ * so that an RU carrying more than the station backlog yields no additional utility.
+ *
+ * The RUs are assigned by searching an RU layout that can be signaled in the RU
+ * Allocation subfields of the HE-SIG-B field, i.e., a layout in which all the RUs
+ * within a 20 MHz subchannel have the same size, and, for every layout, finding the
+ * assignment of stations to RUs that maximizes the sum of the utilities (max-weight
+ * matching). Starting from an RU spanning the whole channel, RUs are split as long as
+ * the sum of the utilities increases.
+ *
+ * Candidate stations are the stations with buffered frames that are found first by
+ * visiting stations in decreasing order of credits, as done by HeapMultiUserScheduler,
+ * which is also used to solicit TB PPDUs.
+ */
+class PfMultiUserScheduler : public HeapMultiUserScheduler
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    PfMultiUserScheduler();
+    ~PfMultiUserScheduler() override;
+
+    /// RUs assigned to stations, each identified by its index in the set of candidates
+    using RuAssignment = std::vector<std::pair<HeRu::RuSpec, std::size_t>>;
+    /// Callback returning the utility of assigning the given RU to the given candidate
+    using UtilityFunction = std::function<double(std::size_t, const HeRu::RuSpec&)>;
+
+    /**
+     * Find the assignment of rows to columns that maximizes the sum of the weights
+     * of the selected (row, column) pairs, provided that every row is assigned a
+     * distinct column (the number of rows cannot exceed the number of columns).
+     *
+     * \param weights the weights, indexed by row and then by column
+     * \return the column assigned to every row
+     */
+    static std::vector<std::size_t> GetMaxWeightMatching(
+        const std::vector<std::vector<double>>& weights);
+
+    /**
+     * Assign RUs of possibly different sizes, all of which within a 20 MHz subchannel
+     * having the same size, to at most the given number of candidate stations so as to
+     * maximize the sum of the utilities.
+     *
+     * \param bw the channel width in MHz (20, 40, 80 or 160)
+     * \param nCandidates the number of candidate stations
+     * \param maxRus the maximum number of RUs to assign
+     * \param utility the utility of assigning a given RU to a given candidate station
+     * \return the RUs assigned to the candidate stations
+     */
+    static RuAssignment AssignRus(uint16_t bw,
+                                  std::size_t nCandidates,
+                                  std::size_t maxRus,
+                                  const UtilityFunction& utility);
+
+  protected:
+    void DoDispose() override;
+    void DoInitialize() override;
+
+    TxFormat TrySendingDlMuPpdu() override;
+    DlMuInfo ComputeDlMuInfo() override;
+    UlMuInfo ComputeUlMuInfo() override;
+    void FinalizeDlMuTxVector(WifiTxVector& txVector) override;
+
+  private:
+    /**
+     * Information about a station used to compute utilities
+     */
+    struct StaInfo
+    {
+        Mac48Address address;             //!< the MAC address of the station
+        std::vector<double> subchannelSe; //!< per-20 MHz subchannel log2(1 + SNR) average
+                                          //!< (negative if unknown)
+        uint16_t snrWidth{0};             //!< the channel width the SNR values refer to
+        double avgRate{0};                //!< average served rate
+        uint64_t lastUpdate{0};           //!< the DL MU PPDU count when avgRate was updated
+    };
+
+    /**
+     * Get the information about the given station, which is (re)initialized if the
+     * station is not known or the given MAC address does not match the stored one.
+     *
+     * \param aid the AID of the station
+     * \param address the MAC address of the station
+     * \return the information about the station
+     */
+    StaInfo& GetStaInfo(uint16_t aid, Mac48Address address);
+
+    /**
+     * \param info the information about a station
+     * \return the average served rate of the station, aged up to the current DL MU PPDU
+     */
+    double GetAvgRate(const StaInfo& info) const;
+
+    /**
+     * Get the relative quality of the channel of the given station over the given RU,
+     * i.e., the average over the 20 MHz subchannels spanned by the given RU of the ratio
+     * between log2(1 + SNR) measured on a subchannel and log2(1 + SNR) averaged over all
+     * the subchannels. One is returned if no SNR measurement is available.
+     *
+     * \param info the information about a station
+     * \param ru the RU
+     * \return the relative quality of the channel of the station over the RU
+     */
+    double GetChannelQuality(const StaInfo& info, const HeRu::RuSpec& ru) const;
+
+    /**
+     * Callback connected to the PhyTxPsduBegin trace source of the PHYs of the AP, used
+     * to retrieve the MuSnrTag attached to the Multi-STA BlockAck frames.
+     *
+     * \param psduMap the PSDU map being transmitted
+     * \param txVector the TXVECTOR used to transmit the PSDU map
+     * \param txPowerW the TX power in Watts
+     */
+    void NotifyTxPsduBegin(WifiConstPsduMap psduMap, WifiTxVector txVector, double txPowerW);
+
+    double m_snrSmoothing;  //!< weight of the new log2(1 + SNR) values
+    double m_rateSmoothing; //!< weight of the rate served in the last DL MU PPDU
+    uint16_t m_nCandidates; //!< max number of candidate stations for a DL MU PPDU
+    std::unordered_map<uint16_t, StaInfo> m_staInfo; //!< per-AID information
+    std::map<uint16_t, HeRu::RuSpec> m_ulRus;        //!< RUs assigned in the last Basic TF
+    uint16_t m_ulWidth;                              //!< width of the last Basic TF
+    std::map<uint16_t, double> m_dlRates;            //!< rates expected in the DL MU PPDU
+    uint64_t m_nDlMuPpdus;                           //!< number of DL MU PPDUs
+    std::vector<Ptr<WifiPhy>> m_phys; //!< PHYs whose PhyTxPsduBegin trace source is connected
+};
+
+} // namespace ns3
+
+#endif /* PF_MULTI_USER_SCHEDULER_H */
@@ -188,7 +188,7 @@ RrMultiUserScheduler::GetTxVectorForUlMu(Func canBeSolicited)
     NS_LOG_FUNCTION(this);
 
     // determine RUs to allocate to stations
-    auto count = std::min<std::size_t>(m_nStations, m_staListUl.size());
+    auto count = std::min<std::size_t>(m_nStations, GetNStations(std::nullopt));
     std::size_t nCentral26TonesRus;
     HeRu::GetEqualSizedRusForStations(m_allowedWidth, count, nCentral26TonesRus);
     NS_ASSERT(count >= 1);
@@ -208,29 +208,29 @@ RrMultiUserScheduler::GetTxVectorForUlMu(Func canBeSolicited)
     txVector.SetBssColor(heConfiguration->GetBssColor());
 
     // iterate over the associated stations until an enough number of stations is identified
-    auto staIt = m_staListUl.begin();
     m_candidates.clear();
 
-    while (staIt != m_staListUl.end() &&
-           txVector.GetHeMuUserInfoMap().size() <
-               std::min<std::size_t>(m_nStations, count + nCentral26TonesRus))
-    {
-        NS_LOG_DEBUG("Next candidate STA (MAC=" << staIt->address << ", AID=" << staIt->aid << ")");
+    VisitStations(std::nullopt, [&](uint16_t aid, Mac48Address address) {
+        if (txVector.GetHeMuUserInfoMap().size() >=
+            std::min<std::size_t>(m_nStations, count + nCentral26TonesRus))
+        {
+            return false;
+        }
 
-        if (!canBeSolicited(*staIt))
+        NS_LOG_DEBUG("Next candidate STA (MAC=" << address << ", AID=" << aid << ")");
+
+        if (!canBeSolicited(aid, address))
         {
             NS_LOG_DEBUG("Skipping station based on provided function object");
-            staIt++;
-            continue;
+            return true;
         }
 
         if (txVector.GetPreambleType() == WIFI_PREAMBLE_EHT_TB &&
-            !m_apMac->GetEhtSupported(staIt->address))
+            !m_apMac->GetEhtSupported(address))
         {
             NS_LOG_DEBUG(
                 "Skipping non-EHT STA because this Trigger Frame is only soliciting EHT STAs");
-            staIt++;
-            continue;
+            return true;
         }
 
         uint8_t tid = 0;
@@ -238,7 +238,7 @@ RrMultiUserScheduler::GetTxVectorForUlMu(Func canBeSolicited)
         {
             // check that a BA agreement is established with the receiver for the
             // considered TID, since ack sequences for UL MU require block ack
-            if (m_apMac->GetBaAgreementEstablishedAsRecipient(staIt->address, tid))
+            if (m_apMac->GetBaAgreementEstablishedAsRecipient(address, tid))
             {
                 break;
             }
@@ -246,15 +246,14 @@ RrMultiUserScheduler::GetTxVectorForUlMu(Func canBeSolicited)
         }
         if (tid == 8)
         {
-            NS_LOG_DEBUG("No Block Ack agreement established with " << staIt->address);
-            staIt++;
-            continue;
+            NS_LOG_DEBUG("No Block Ack agreement established with " << address);
+            return true;
         }
 
         // if the first candidate STA is an EHT STA, we switch to soliciting EHT TB PPDUs
         if (txVector.GetHeMuUserInfoMap().empty())
         {
-            if (m_apMac->GetEhtSupported() && m_apMac->GetEhtSupported(staIt->address))
+            if (m_apMac->GetEhtSupported() && m_apMac->GetEhtSupported(address))
             {
                 txVector.SetPreambleType(WIFI_PREAMBLE_EHT_TB);
                 txVector.SetEhtPpduType(0);
@@ -265,21 +264,21 @@ RrMultiUserScheduler::GetTxVectorForUlMu(Func canBeSolicited)
         // prepare the MAC header of a frame that would be sent to the candidate station,
         // just for the purpose of retrieving the TXVECTOR used to transmit to that station
         WifiMacHeader hdr(WIFI_MAC_QOSDATA);
-        hdr.SetAddr1(GetWifiRemoteStationManager(m_linkId)
-                         ->GetAffiliatedStaAddress(staIt->address)
-                         .value_or(staIt->address));
+        hdr.SetAddr1(
+            GetWifiRemoteStationManager(m_linkId)->GetAffiliatedStaAddress(address).value_or(
+                address));
         hdr.SetAddr2(m_apMac->GetFrameExchangeManager(m_linkId)->GetAddress());
         WifiTxVector suTxVector =
             GetWifiRemoteStationManager(m_linkId)->GetDataTxVector(hdr, m_allowedWidth);
-        txVector.SetHeMuUserInfo(staIt->aid,
+        txVector.SetHeMuUserInfo(aid,
                                  {HeRu::RuSpec(), // assigned later by FinalizeTxVector
                                   suTxVector.GetMode().GetMcsValue(),
                                   suTxVector.GetNss()});
-        m_candidates.emplace_back(staIt, nullptr);
+        m_candidates.push_back({aid, address, nullptr});
 
         // move to the next station in the list
-        staIt++;
-    }
+        return true;
+    });
 
     if (txVector.GetHeMuUserInfoMap().empty())
     {
@@ -296,16 +295,16 @@ RrMultiUserScheduler::TrySendingBsrpTf()
 {
     NS_LOG_FUNCTION(this);
 
-    if (m_staListUl.empty())
+    if (GetNStations(std::nullopt) == 0)
     {
         NS_LOG_DEBUG("No HE stations associated: return SU_TX");
         return TxFormat::SU_TX;
     }
 
     // only consider stations that have setup the current link
-    WifiTxVector txVector = GetTxVectorForUlMu([this](const MasterInfo& info) {
+    WifiTxVector txVector = GetTxVectorForUlMu([this](uint16_t aid, Mac48Address address) {
         const auto& staList = m_apMac->GetStaList(m_linkId);
-        return staList.find(info.aid) != staList.cend();
+        return staList.find(aid) != staList.cend();
     });
 
     if (txVector.GetHeMuUserInfoMap().empty())
@@ -380,7 +379,7 @@ RrMultiUserScheduler::TrySendingBasicTf()
 {
     NS_LOG_FUNCTION(this);
 
-    if (m_staListUl.empty())
+    if (GetNStations(std::nullopt) == 0)
     {
         NS_LOG_DEBUG("No HE stations associated: return SU_TX");
         return TxFormat::SU_TX;
@@ -391,10 +390,9 @@ RrMultiUserScheduler::TrySendingBasicTf()
 
     // only consider stations that have setup the current link and do not have
     // reported a null queue size
-    WifiTxVector txVector = GetTxVectorForUlMu([this](const MasterInfo& info) {
+    WifiTxVector txVector = GetTxVectorForUlMu([this](uint16_t aid, Mac48Address address) {
         const auto& staList = m_apMac->GetStaList(m_linkId);
-        return staList.find(info.aid) != staList.cend() &&
-               m_apMac->GetMaxBufferStatus(info.address) > 0;
+        return staList.find(aid) != staList.cend() && m_apMac->GetMaxBufferStatus(address) > 0;
     });
 
     if (txVector.GetHeMuUserInfoMap().empty())
@@ -533,7 +531,7 @@ RrMultiUserScheduler::TrySendingBasicTf()
         userInfo.SetBasicTriggerDepUserInfo(0, 0, m_edca->GetAccessCategory());
     }
 
-    UpdateCredits(m_staListUl, maxDuration, txVector);
+    UpdateCredits(std::nullopt, maxDuration, txVector);
 
     return UL_MU_TX;
 }
@@ -551,6 +549,36 @@ RrMultiUserScheduler::NotifyStationAssociated(uint16_t aid, Mac48Address address
     auto mldOrLinkAddress = m_apMac->GetMldOrLinkAddressByAid(aid);
     NS_ASSERT_MSG(mldOrLinkAddress, "AID " << aid << " not found");
 
+    AddStation(aid, *mldOrLinkAddress);
+}
+
+void
+RrMultiUserScheduler::NotifyStationDeassociated(uint16_t aid, Mac48Address address)
+{
+    NS_LOG_FUNCTION(this << aid << address);
+
+    if (!m_apMac->GetHeSupported(address))
+    {
+        return;
+    }
+
+    auto mldOrLinkAddress = m_apMac->GetMldOrLinkAddressByAid(aid);
+    NS_ASSERT_MSG(mldOrLinkAddress, "AID " << aid << " not found");
+
+    if (m_apMac->IsAssociated(*mldOrLinkAddress))
+    {
+        // Another STA of the non-AP MLD is still associated
+        return;
+    }
+
+    RemoveStation(aid);
+}
+
+void
+RrMultiUserScheduler::AddStation(uint16_t aid, Mac48Address address)
+{
+    NS_LOG_FUNCTION(this << aid << address);
+
     for (auto& staList : m_staListDl)
     {
         // if this is not the first STA of a non-AP MLD to be notified, an entry
@@ -560,7 +588,7 @@ RrMultiUserScheduler::NotifyStationAssociated(uint16_t aid, Mac48Address address
                                         [aid](auto&& info) { return info.aid == aid; });
         if (staIt == staList.second.cend())
         {
-            staList.second.push_back(MasterInfo{aid, *mldOrLinkAddress, 0.0});
+            staList.second.push_back(MasterInfo{aid, address, 0.0});
         }
     }
 
@@ -569,34 +597,77 @@ RrMultiUserScheduler::NotifyStationAssociated(uint16_t aid, Mac48Address address
     });
     if (staIt == m_staListUl.cend())
     {
-        m_staListUl.push_back(MasterInfo{aid, *mldOrLinkAddress, 0.0});
+        m_staListUl.push_back(MasterInfo{aid, address, 0.0});
     }
 }
 
 void
-RrMultiUserScheduler::NotifyStationDeassociated(uint16_t aid, Mac48Address address)
+RrMultiUserScheduler::RemoveStation(uint16_t aid)
 {
-    NS_LOG_FUNCTION(this << aid << address);
+    NS_LOG_FUNCTION(this << aid);
 
-    if (!m_apMac->GetHeSupported(address))
+    for (auto& staList : m_staListDl)
     {
-        return;
+        staList.second.remove_if([&aid](const MasterInfo& info) { return info.aid == aid; });
     }
+    m_staListUl.remove_if([&aid](const MasterInfo& info) { return info.aid == aid; });
+}
 
-    auto mldOrLinkAddress = m_apMac->GetMldOrLinkAddressByAid(aid);
-    NS_ASSERT_MSG(mldOrLinkAddress, "AID " << aid << " not found");
+std::list<RrMultiUserScheduler::MasterInfo>&
+RrMultiUserScheduler::GetStaList(StaListId list)
+{
+    return list ? m_staListDl[*list] : m_staListUl;
+}
 
-    if (m_apMac->IsAssociated(*mldOrLinkAddress))
+std::size_t
+RrMultiUserScheduler::GetNStations(StaListId list) const
+{
+    if (!list)
     {
-        // Another STA of the non-AP MLD is still associated
-        return;
+        return m_staListUl.size();
     }
+    auto it = m_staListDl.find(*list);
+    return it != m_staListDl.cend() ? it->second.size() : 0;
+}
 
-    for (auto& staList : m_staListDl)
+void
+RrMultiUserScheduler::VisitStations(StaListId list, const StaVisitor& visitor)
+{
+    for (const auto& sta : GetStaList(list))
     {
-        staList.second.remove_if([&aid](const MasterInfo& info) { return info.aid == aid; });
+        if (!visitor(sta.aid, sta.address))
+        {
+            break;
+        }
     }
-    m_staListUl.remove_if([&aid](const MasterInfo& info) { return info.aid == aid; });
+}
+
+void
+RrMultiUserScheduler::ChargeStations(StaListId list,
+                                     double creditsPerSta,
+                                     double maxCredits,
+                                     const std::map<uint16_t, double>& debits)
+{
+    auto& staList = GetStaList(list);
+
+    // assign credits to all stations
+    for (auto& sta : staList)
+    {
+        sta.credits += creditsPerSta;
+        sta.credits = std::min(sta.credits, maxCredits);
+    }
+
+    // subtract debits to the selected stations
+    for (auto& sta : staList)
+    {
+        if (auto it = debits.find(sta.aid); it != debits.cend())
+        {
+            sta.credits -= it->second;
+        }
+    }
+
+    // sort the list in decreasing order of credits
+    staList.sort([](const MasterInfo& a, const MasterInfo& b) { return a.credits > b.credits; });
 }
 
 MultiUserScheduler::TxFormat
@@ -606,14 +677,13 @@ RrMultiUserScheduler::TrySendingDlMuPpdu()
 
     AcIndex primaryAc = m_edca->GetAccessCategory();
 
-    if (m_staListDl[primaryAc].empty())
+    if (GetNStations(primaryAc) == 0)
     {
         NS_LOG_DEBUG("No HE stations associated: return SU_TX");
         return TxFormat::SU_TX;
     }
 
-    std::size_t count =
-        std::min(static_cast<std::size_t>(m_nStations), m_staListDl[primaryAc].size());
+    std::size_t count = std::min(static_cast<std::size_t>(m_nStations), GetNStations(primaryAc));
     std::size_t nCentral26TonesRus;
     HeRu::RuType ruType =
         HeRu::GetEqualSizedRusForStations(m_allowedWidth, count, nCentral26TonesRus);
@@ -624,31 +694,7 @@ RrMultiUserScheduler::TrySendingDlMuPpdu()
         nCentral26TonesRus = 0;
     }
 
-    uint8_t currTid = wifiAcList.at(primaryAc).GetHighTid();
-
-    Ptr<WifiMpdu> mpdu = m_edca->PeekNextMpdu(m_linkId);
-
-    if (mpdu && mpdu->GetHeader().IsQosData())
-    {
-        currTid = mpdu->GetHeader().GetQosTid();
-    }
-
-    // determine the list of TIDs to check
-    std::vector<uint8_t> tids;
-
-    if (m_enableTxopSharing)
-    {
-        for (auto acIt = wifiAcList.find(primaryAc); acIt != wifiAcList.end(); acIt++)
-        {
-            uint8_t firstTid = (acIt->first == primaryAc ? currTid : acIt->second.GetHighTid());
-            tids.push_back(firstTid);
-            tids.push_back(acIt->second.GetOtherTid(firstTid));
-        }
-    }
-    else
-    {
-        tids.push_back(currTid);
-    }
+    const auto tids = GetDlMuTids(primaryAc);
 
     Ptr<HeConfiguration> heConfiguration = m_apMac->GetHeConfiguration();
     NS_ASSERT(heConfiguration);
@@ -666,7 +712,6 @@ RrMultiUserScheduler::TrySendingDlMuPpdu()
     Time actualAvailableTime = (m_initialFrame ? Time::Min() : m_availableTime);
 
     // iterate over the associated stations until an enough number of stations is identified
-    auto staIt = m_staListDl[primaryAc].begin();
     m_candidates.clear();
 
     std::vector<uint8_t> ruAllocations;
@@ -674,18 +719,20 @@ RrMultiUserScheduler::TrySendingDlMuPpdu()
     ruAllocations.resize(numRuAllocs);
     NS_ASSERT((m_candidates.size() % numRuAllocs) == 0);
 
-    while (staIt != m_staListDl[primaryAc].end() &&
-           m_candidates.size() <
-               std::min(static_cast<std::size_t>(m_nStations), count + nCentral26TonesRus))
-    {
-        NS_LOG_DEBUG("Next candidate STA (MAC=" << staIt->address << ", AID=" << staIt->aid << ")");
+    VisitStations(primaryAc, [&](uint16_t aid, Mac48Address address) {
+        if (m_candidates.size() >=
+            std::min(static_cast<std::size_t>(m_nStations), count + nCentral26TonesRus))
+        {
+            return false;
+        }
+
+        NS_LOG_DEBUG("Next candidate STA (MAC=" << address << ", AID=" << aid << ")");
 
         if (m_txParams.m_txVector.GetPreambleType() == WIFI_PREAMBLE_EHT_MU &&
-            !m_apMac->GetEhtSupported(staIt->address))
+            !m_apMac->GetEhtSupported(address))
         {
             NS_LOG_DEBUG("Skipping non-EHT STA because this DL MU PPDU is sent to EHT STAs only");
-            staIt++;
-            continue;
+            return true;
         }
 
         HeRu::RuType currRuType = (m_candidates.size() < count ? ruType : HeRu::RU_26_TONE);
@@ -697,9 +744,9 @@ RrMultiUserScheduler::TrySendingDlMuPpdu()
             NS_ASSERT(ac >= primaryAc);
             // check that a BA agreement is established with the receiver for the
             // considered TID, since ack sequences for DL MU PPDUs require block ack
-            if (m_apMac->GetBaAgreementEstablishedAsOriginator(staIt->address, tid))
+            if (m_apMac->GetBaAgreementEstablishedAsOriginator(address, tid))
             {
-                mpdu = m_apMac->GetQosTxop(ac)->PeekNextMpdu(m_linkId, tid, staIt->address);
+                auto mpdu = m_apMac->GetQosTxop(ac)->PeekNextMpdu(m_linkId, tid, address);
 
                 // we only check if the first frame of the current TID meets the size
                 // and duration constraints. We do not explore the queues further.
@@ -724,7 +771,7 @@ RrMultiUserScheduler::TrySendingDlMuPpdu()
                         m_txParams.m_txVector.SetEhtPpduType(0); // indicates DL OFDMA transmission
                     }
 
-                    m_txParams.m_txVector.SetHeMuUserInfo(staIt->aid,
+                    m_txParams.m_txVector.SetHeMuUserInfo(aid,
                                                           {{currRuType, 1, true},
                                                            suTxVector.GetMode().GetMcsValue(),
                                                            suTxVector.GetNss()});
@@ -743,23 +790,22 @@ RrMultiUserScheduler::TrySendingDlMuPpdu()
                     else
                     {
                         // the frame meets the constraints
-                        NS_LOG_DEBUG("Adding candidate STA (MAC=" << staIt->address
-                                                                  << ", AID=" << staIt->aid
+                        NS_LOG_DEBUG("Adding candidate STA (MAC=" << address << ", AID=" << aid
                                                                   << ") TID=" << +tid);
-                        m_candidates.emplace_back(staIt, mpdu);
+                        m_candidates.push_back({aid, address, mpdu});
                         break; // terminate the for loop
                     }
                 }
                 else
                 {
-                    NS_LOG_DEBUG("No frames to send to " << staIt->address << " with TID=" << +tid);
+                    NS_LOG_DEBUG("No frames to send to " << address << " with TID=" << +tid);
                 }
             }
         }
 
         // move to the next station in the list
-        staIt++;
-    }
+        return true;
+    });
 
 #if NRC_DEBUG == true
     if (m_candidates.size() > 1)
@@ -782,6 +828,43 @@ RrMultiUserScheduler::TrySendingDlMuPpdu()
     return TxFormat::DL_MU_TX;
 }
 
+std::vector<uint8_t>
+RrMultiUserScheduler::GetDlMuTids(AcIndex primaryAc) const
+{
+    uint8_t currTid = wifiAcList.at(primaryAc).GetHighTid();
+
+    Ptr<WifiMpdu> mpdu = m_edca->PeekNextMpdu(m_linkId);
+
+    if (mpdu && mpdu->GetHeader().IsQosData())
+    {
+        currTid = mpdu->GetHeader().GetQosTid();
+    }
+
+    // determine the list of TIDs to check
+    std::vector<uint8_t> tids;
+
+    if (m_enableTxopSharing)
+    {
+        for (auto acIt = wifiAcList.find(primaryAc); acIt != wifiAcList.end(); acIt++)
+        {
+            uint8_t firstTid = (acIt->first == primaryAc ? currTid : acIt->second.GetHighTid());
+            tids.push_back(firstTid);
+            tids.push_back(acIt->second.GetOtherTid(firstTid));
+        }
+    }
+    else
+    {
+        tids.push_back(currTid);
+    }
+    return tids;
+}
+
+void
+RrMultiUserScheduler::FinalizeDlMuTxVector(WifiTxVector& txVector)
+{
+    FinalizeTxVector(txVector);
+}
+
 void
 RrMultiUserScheduler::FinalizeTxVector(WifiTxVector& txVector)
 {
@@ -812,7 +895,7 @@ RrMultiUserScheduler::FinalizeTxVector(WifiTxVector& txVector)
     WifiTxVector::HeMuUserInfoMap heMuUserInfoMap;
     std::swap(heMuUserInfoMap, txVector.GetHeMuUserInfoMap());
 
-    auto candidateIt = m_candidates.begin(); // iterator over the list of candidate receivers
+    auto candidateIt = m_candidates.begin(); // iterator over the candidate receivers
     auto ruSet = HeRu::GetRusOfType(m_allowedWidth, ruType);
     auto ruSetIt = ruSet.begin();
     auto central26TonesRus = HeRu::GetCentral26TonesRus(m_allowedWidth, ruType);
@@ -821,7 +904,7 @@ RrMultiUserScheduler::FinalizeTxVector(WifiTxVector& txVector)
     for (std::size_t i = 0; i < nRusAssigned + nCentral26TonesRus; i++)
     {
         NS_ASSERT(candidateIt != m_candidates.end());
-        auto mapIt = heMuUserInfoMap.find(candidateIt->first->aid);
+        auto mapIt = heMuUserInfoMap.find(candidateIt->aid);
         NS_ASSERT(mapIt != heMuUserInfoMap.end());
 
         txVector.SetHeMuUserInfo(mapIt->first,
@@ -836,9 +919,7 @@ RrMultiUserScheduler::FinalizeTxVector(WifiTxVector& txVector)
 }
 
 void
-RrMultiUserScheduler::UpdateCredits(std::list<MasterInfo>& staList,
-                                    Time txDuration,
-                                    const WifiTxVector& txVector)
+RrMultiUserScheduler::UpdateCredits(StaListId list, Time txDuration, const WifiTxVector& txVector)
 {
     NS_LOG_FUNCTION(this << txDuration.As(Time::US) << txVector);
 
@@ -851,7 +932,7 @@ RrMultiUserScheduler::UpdateCredits(std::list<MasterInfo>& staList,
 
     // The amount of credits received by each station equals the TX duration (in
     // microseconds) divided by the number of stations.
-    double creditsPerSta = txDuration.ToDouble(Time::US) / staList.size();
+    double creditsPerSta = txDuration.ToDouble(Time::US) / GetNStations(list);
     // Transmitting stations have to pay a number of credits equal to the TX duration
     // (in microseconds) times the allocated bandwidth share.
     double debitsPerMhz =
@@ -860,24 +941,17 @@ RrMultiUserScheduler::UpdateCredits(std::list<MasterInfo>& staList,
             return sum + pair.second * HeRu::GetBandwidth(pair.first);
         });
 
-    // assign credits to all stations
-    for (auto& sta : staList)
-    {
-        sta.credits += creditsPerSta;
-        sta.credits = std::min(sta.credits, m_maxCredits.ToDouble(Time::US));
-    }
-
-    // subtract debits to the selected stations
-    for (auto& candidate : m_candidates)
+    // compute the debits of the selected stations
+    std::map<uint16_t, double> debits;
+    for (const auto& candidate : m_candidates)
     {
-        auto mapIt = txVector.GetHeMuUserInfoMap().find(candidate.first->aid);
+        auto mapIt = txVector.GetHeMuUserInfoMap().find(candidate.aid);
         NS_ASSERT(mapIt != txVector.GetHeMuUserInfoMap().end());
 
-        candidate.first->credits -= debitsPerMhz * HeRu::GetBandwidth(mapIt->second.ru.GetRuType());
+        debits[candidate.aid] = debitsPerMhz * HeRu::GetBandwidth(mapIt->second.ru.GetRuType());
     }
 
-    // sort the list in decreasing order of credits
-    staList.sort([](const MasterInfo& a, const MasterInfo& b) { return a.credits > b.credits; });
+    ChargeStations(list, creditsPerSta, m_maxCredits.ToDouble(Time::US), debits);
 }
 
 MultiUserScheduler::DlMuInfo
@@ -892,7 +966,7 @@ RrMultiUserScheduler::ComputeDlMuInfo()
 
     DlMuInfo dlMuInfo;
     std::swap(dlMuInfo.txParams.m_txVector, m_txParams.m_txVector);
-    FinalizeTxVector(dlMuInfo.txParams.m_txVector);
+    FinalizeDlMuTxVector(dlMuInfo.txParams.m_txVector);
 
     m_txParams.Clear();
 
@@ -903,7 +977,7 @@ RrMultiUserScheduler::ComputeDlMuInfo()
 
     for (const auto& candidate : m_candidates)
     {
-        mpdu = candidate.second;
+        mpdu = candidate.mpdu;
         NS_ASSERT(mpdu);
 
         bool ret [[maybe_unused]] =
@@ -922,9 +996,9 @@ RrMultiUserScheduler::ComputeDlMuInfo()
     {
         for (const auto& candidate : m_candidates)
         {
-            std::cout << candidate.second->GetHeader().GetAddr1() << " is "
+            std::cout << candidate.mpdu->GetHeader().GetAddr1() << " is "
                       << m_apMac->GetFrameExchangeManager(m_linkId)->GetProtectedStas().count(
-                             candidate.second->GetHeader().GetAddr1())
+                             candidate.mpdu->GetHeader().GetAddr1())
                       << std::endl;
         }
 
@@ -941,10 +1015,10 @@ RrMultiUserScheduler::ComputeDlMuInfo()
     for (const auto& candidate : m_candidates)
     {
         // Let us try first A-MSDU aggregation if possible
-        mpdu = candidate.second;
+        mpdu = candidate.mpdu;
         NS_ASSERT(mpdu);
         uint8_t tid = mpdu->GetHeader().GetQosTid();
-        NS_ASSERT_MSG(mpdu->GetOriginal()->GetHeader().GetAddr1() == candidate.first->address,
+        NS_ASSERT_MSG(mpdu->GetOriginal()->GetHeader().GetAddr1() == candidate.address,
                       "RA of the stored MPDU must match the stored address");
 
         NS_ASSERT(mpdu->IsQueued());
@@ -975,13 +1049,13 @@ RrMultiUserScheduler::ComputeDlMuInfo()
         if (mpduList.size() > 1)
         {
             // A-MPDU aggregation succeeded, update psduMap
-            dlMuInfo.psduMap[candidate.first->aid] = Create<WifiPsdu>(std::move(mpduList));
+            dlMuInfo.psduMap[candidate.aid] = Create<WifiPsdu>(std::move(mpduList));
         }
         else
         {
-            Mac48Address receiver = candidate.first->address;
+            Mac48Address receiver = candidate.address;
             dlMuInfo.txParams.SetInfo(receiver, backupTxParams.GetPsduInfo(receiver));
-            dlMuInfo.psduMap[candidate.first->aid] = Create<WifiPsdu>(item, true);
+            dlMuInfo.psduMap[candidate.aid] = Create<WifiPsdu>(item, true);
         }
     }
     std::swap(backupProtection, dlMuInfo.txParams.m_protection);
@@ -991,9 +1065,9 @@ RrMultiUserScheduler::ComputeDlMuInfo()
     {
         for (const auto& candidate : m_candidates)
         {
-            std::cout << candidate.second->GetHeader().GetAddr1() << " is "
+            std::cout << candidate.mpdu->GetHeader().GetAddr1() << " is "
                       << m_apMac->GetFrameExchangeManager(m_linkId)->GetProtectedStas().count(
-                             candidate.second->GetHeader().GetAddr1())
+                             candidate.mpdu->GetHeader().GetAddr1())
                       << std::endl;
         }
 
@@ -1003,11 +1077,12 @@ RrMultiUserScheduler::ComputeDlMuInfo()
 #endif
 
     AcIndex primaryAc = m_edca->GetAccessCategory();
-    UpdateCredits(m_staListDl[primaryAc],
-                  dlMuInfo.txParams.m_txDuration,
-                  dlMuInfo.txParams.m_txVector);
+    UpdateCredits(primaryAc, dlMuInfo.txParams.m_txDuration, dlMuInfo.txParams.m_txVector);
 
-    NS_LOG_DEBUG("Next station to serve has AID=" << m_staListDl[primaryAc].front().aid);
+    VisitStations(primaryAc, [](uint16_t aid, Mac48Address) {
+        NS_LOG_DEBUG("Next station to serve has AID=" << aid);
+        return false;
+    });
 
 #if NRC_DEBUG == true
     WifiConstPsduMap psduMap;
@@ -22,7 +22,9 @@
 
 #include "multi-user-scheduler.h"
 
+#include <functional>
 #include <list>
+#include <optional>
 
 namespace ns3
 {
@@ -37,6 +39,9 @@ namespace ns3
  * channel or higher. The maximum number of stations that can be granted an RU is
  * configurable. Associated stations are served based on their priority. The priority is
  * determined by the credits/debits a station gets when it is selected or not for transmission.
+ * Subclasses can keep the stations ordered by credits in a different data structure by
+ * overriding AddStation(), RemoveStation(), GetNStations(), VisitStations() and
+ * ChargeStations().
  *
  * \todo Take the supported channel width of the stations into account while selecting
  * stations and assigning RUs to them.
@@ -56,9 +61,6 @@ class RrMultiUserScheduler : public MultiUserScheduler
     void DoDispose() override;
     void DoInitialize() override;
 
-  private:
-    friend class TxsMultiUserScheduler;
-    TxFormat SelectTxFormat() override;
     DlMuInfo ComputeDlMuInfo() override;
     UlMuInfo ComputeUlMuInfo() override;
 
@@ -89,13 +91,107 @@ class RrMultiUserScheduler : public MultiUserScheduler
      */
     virtual TxFormat TrySendingDlMuPpdu();
 
+    /**
+     * Assign the RUs to the candidate stations of the DL MU PPDU being prepared. The
+     * default implementation assigns equal-sized RUs by calling FinalizeTxVector.
+     *
+     * \param txVector the TXVECTOR of the DL MU PPDU
+     */
+    virtual void FinalizeDlMuTxVector(WifiTxVector& txVector);
+
+    /**
+     * Get the TIDs whose frames can be included in a DL MU PPDU sent after that the
+     * given AC gained channel access, starting from the TID of the next frame of
+     * the given AC.
+     *
+     * \param primaryAc the AC that gained channel access
+     * \return the TIDs to check, in decreasing order of priority
+     */
+    std::vector<uint8_t> GetDlMuTids(AcIndex primaryAc) const;
+
+    /**
+     * Identifier of a list of stations kept by the scheduler: the AC of the list of
+     * stations to serve in DL or std::nullopt for the list of stations to solicit in UL.
+     */
+    using StaListId = std::optional<AcIndex>;
+
+    /**
+     * Function called for every visited station with the AID and the MAC address of the
+     * station. The visit goes on as long as the function returns true.
+     */
+    using StaVisitor = std::function<bool(uint16_t, Mac48Address)>;
+
+    /**
+     * Add a station with no credits to all the lists of stations, unless it is already
+     * present. The lists of stations determine the order in which stations are considered
+     * for MU transmissions; the default implementation keeps them in std::list containers
+     * that are sorted after every transmission.
+     *
+     * \param aid the AID of the station
+     * \param address the MAC address of the station
+     */
+    virtual void AddStation(uint16_t aid, Mac48Address address);
+    /**
+     * Remove a station from all the lists of stations.
+     *
+     * \param aid the AID of the station
+     */
+    virtual void RemoveStation(uint16_t aid);
+    /**
+     * \param list the list of stations
+     * \return the number of stations in the given list
+     */
+    virtual std::size_t GetNStations(StaListId list) const;
+    /**
+     * Visit the stations in the given list in decreasing order of credits.
+     *
+     * \param list the list of stations
+     * \param visitor the function called for every visited station
+     */
+    virtual void VisitStations(StaListId list, const StaVisitor& visitor);
+    /**
+     * Grant the given amount of credits to all the stations in the given list, capping
+     * the amount of credits of every station to the given maximum, and then subtract
+     * the given debits from the given stations.
+     *
+     * \param list the list of stations
+     * \param creditsPerSta the amount of credits to grant to every station
+     * \param maxCredits the maximum amount of credits a station can have
+     * \param debits the amount of credits to subtract, indexed by station AID
+     */
+    virtual void ChargeStations(StaListId list,
+                                double creditsPerSta,
+                                double maxCredits,
+                                const std::map<uint16_t, double>& debits);
+
+    /**
+     * Information stored for candidate stations
+     */
+    struct CandidateInfo
+    {
+        uint16_t aid;         //!< station's AID
+        Mac48Address address; //!< station's MAC Address
+        Ptr<WifiMpdu> mpdu;   //!< the MPDU to send to the station (DL only)
+    };
+
+    uint8_t m_nStations;                     //!< Number of stations/slots to fill
+    bool m_forceDlOfdma;                     //!< return DL_OFDMA even if no DL MU PPDU was built
+    std::vector<CandidateInfo> m_candidates; //!< Candidate stations for MU TX
+    CtrlTriggerHeader m_trigger;             //!< Trigger Frame to send
+    WifiTxParameters m_txParams;             //!< TX parameters
+
+  private:
+    friend class TxsMultiUserScheduler;
+    TxFormat SelectTxFormat() override;
+
     /**
      * Compute a TXVECTOR that can be used to construct a Trigger Frame to solicit
      * transmissions from suitable stations, i.e., stations that have established a
      * BlockAck agreement with the AP and for which the given predicate returns true.
      *
      * \tparam Func \deduced the type of the given predicate
-     * \param canBeSolicited a predicate returning false for stations that shall not be solicited
+     * \param canBeSolicited a predicate taking the AID and the MAC address of a station
+     *        and returning false for stations that shall not be solicited
      * \return a TXVECTOR that can be used to construct a Trigger Frame to solicit
      *         transmissions from suitable stations
      */
@@ -143,34 +239,28 @@ class RrMultiUserScheduler : public MultiUserScheduler
      * Update credits of the stations in the given list considering that a PPDU having
      * the given duration is being transmitted or solicited by using the given TXVECTOR.
      *
-     * \param staList the list of stations
+     * \param list the list of stations
      * \param txDuration the TX duration of the PPDU being transmitted or solicited
      * \param txVector the TXVECTOR for the PPDU being transmitted or solicited
      */
-    void UpdateCredits(std::list<MasterInfo>& staList,
-                       Time txDuration,
-                       const WifiTxVector& txVector);
+    void UpdateCredits(StaListId list, Time txDuration, const WifiTxVector& txVector);
 
     /**
-     * Information stored for candidate stations
+     * \param list the list of stations
+     * \return a reference to the given list of stations
      */
-    typedef std::pair<std::list<MasterInfo>::iterator, Ptr<WifiMpdu>> CandidateInfo;
+    std::list<MasterInfo>& GetStaList(StaListId list);
 
-    uint8_t m_nStations;         //!< Number of stations/slots to fill
     bool m_enableTxopSharing;    //!< allow A-MPDUs of different TIDs in a DL MU PPDU
-    bool m_forceDlOfdma;         //!< return DL_OFDMA even if no DL MU PPDU was built
     bool m_enableUlOfdma;        //!< enable the scheduler to also return UL_OFDMA
     bool m_enableBsrp;           //!< send a BSRP before an UL MU transmission
     bool m_useCentral26TonesRus; //!< whether to allocate central 26-tone RUs
     uint32_t m_ulPsduSize;       //!< the size in byte of the solicited PSDU
     std::map<AcIndex, std::list<MasterInfo>>
-        m_staListDl;                       //!< Per-AC list of stations (next to serve for DL first)
-    std::list<MasterInfo> m_staListUl;     //!< List of stations to serve for UL
-    std::list<CandidateInfo> m_candidates; //!< Candidate stations for MU TX
-    Time m_maxCredits;                     //!< Max amount of credits a station can have
-    CtrlTriggerHeader m_trigger;           //!< Trigger Frame to send
-    WifiMacHeader m_triggerMacHdr;         //!< MAC header for Trigger Frame
-    WifiTxParameters m_txParams;           //!< TX parameters
+        m_staListDl;                   //!< Per-AC list of stations (next to serve for DL first)
+    std::list<MasterInfo> m_staListUl; //!< List of stations to serve for UL
+    Time m_maxCredits;                 //!< Max amount of credits a station can have
+    WifiMacHeader m_triggerMacHdr;     //!< MAC header for Trigger Frame
 };
 
 } // namespace ns3
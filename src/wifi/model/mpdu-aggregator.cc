@@ -217,12 +217,17 @@ MpduAggregator::GetNextAmpdu(Ptr<WifiMpdu> mpdu,
     Ptr<QosTxop> qosTxop = m_mac->GetQosTxop(tid);
     NS_ASSERT(qosTxop);
 
+    const auto modulation = txParams.m_txVector.GetModulationClass();
+    uint32_t maxAmpduSize = 0;
+
     // Have to make sure that the block ack agreement is established and A-MPDU is enabled
     if (m_mac->GetBaAgreementEstablishedAsOriginator(recipient, tid) &&
-        GetMaxAmpduSize(recipient, tid, txParams.m_txVector.GetModulationClass()) > 0)
+        (maxAmpduSize = GetMaxAmpduSize(recipient, tid, modulation)) > 0)
     {
         /* here is performed MPDU aggregation */
         Ptr<WifiMpdu> nextMpdu = mpdu;
+        // the size limit does not change while the A-MPDU is being built
+        const auto maxSize = std::min(maxAmpduSize, WifiPhy::GetMaxPsduSize(modulation));
 
         while (nextMpdu)
         {
@@ -246,6 +251,21 @@ MpduAggregator::GetNextAmpdu(Ptr<WifiMpdu> mpdu,
                                      qosTxop->GetBaStartingSequence(origRecipient, tid),
                                      qosTxop->GetBaBufferSize(origRecipient, tid)));
 
+                // the size of the A-MPDU being built is tracked by txParams, hence we can
+                // cheaply check whether the peeked MPDU alone (i.e., without A-MSDU
+                // aggregation) would certainly exceed the size limit. In such a case, there is no
+                // need to create an alias and go through the protection and acknowledgment
+                // managers, because the peeked MPDU would be rejected anyway. Note that the
+                // peeked MPDU and its alias (if any) have the same size
+                if (GetSizeIfAggregated(peekedMpdu->GetSize(), txParams.GetSize(recipient)) >
+                    maxSize)
+                {
+                    NS_LOG_DEBUG("Next MPDU (size=" << peekedMpdu->GetSize()
+                                                    << ") exceeds the size limit (" << maxSize
+                                                    << ")");
+                    break;
+                }
+
                 peekedMpdu = m_htFem->CreateAliasIfNeeded(peekedMpdu);
                 // get the next MPDU to aggregate, provided that the constraints on size
                 // and duration limit are met. Note that the returned MPDU differs from
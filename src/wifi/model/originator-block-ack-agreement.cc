@@ -102,10 +102,9 @@ OriginatorBlockAckAgreement::InitTxWindow()
 void
 OriginatorBlockAckAgreement::AdvanceTxWindow()
 {
-    while (m_txWindow.At(0))
-    {
-        m_txWindow.Advance(1); // reset the current head -- ensures loop termination
-    }
+    // advance the window up to the first unacknowledged MPDU (if all the MPDUs in the
+    // window have been acknowledged, the window is advanced by its size)
+    m_txWindow.Advance(m_txWindow.FindNextUnset(0));
 }
 
 void
@@ -149,7 +148,7 @@ OriginatorBlockAckAgreement::NotifyAckedMpdu(Ptr<const WifiMpdu> mpdu)
     // when an MPDU is transmitted, the transmit window is updated such that the
     // transmitted MPDU is in the window, hence we cannot be notified of the
     // acknowledgment of an MPDU which is beyond the transmit window
-    m_txWindow.At(distance) = true;
+    m_txWindow.Set(distance);
 
     // the starting sequence number can be advanced to the sequence number of
     // the nearest unacknowledged MPDU
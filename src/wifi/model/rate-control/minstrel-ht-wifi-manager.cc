@@ -42,6 +42,7 @@
 #include "ns3/wifi-mac.h"
 #include "ns3/wifi-phy.h"
 
+#include <algorithm>
 #include <iomanip>
 
 #define Min(a, b) ((a < b) ? a : b)
@@ -66,7 +67,8 @@ struct MinstrelHtWifiRemoteStation : MinstrelWifiRemoteStation
     uint32_t m_ampduLen;         //!< Number of MPDUs in an A-MPDU.
     uint32_t m_ampduPacketCount; //!< Number of A-MPDUs transmitted.
 
-    McsGroupData m_groupsTable; //!< Table of groups with stats.
+    McsGroupData m_groupsTable;      //!< Table of groups.
+    MinstrelHtRateStats m_rateStats; //!< Statistics of all the rates, indexed by GetIndex().
     bool m_isHt;                //!< If the station is HT capable.
 
     std::ofstream m_statsFile; //!< File where statistics table is written.
@@ -129,6 +131,24 @@ MinstrelHtWifiManager::GetTypeId()
     return tid;
 }
 
+void
+MinstrelHtRateStats::Reset(std::size_t nRates)
+{
+    supported.assign(nRates, 0);
+    txTime.assign(nRates, 0);
+    numRateAttempt.assign(nRates, 0);
+    numRateSuccess.assign(nRates, 0);
+    prevNumRateAttempt.assign(nRates, 0);
+    prevNumRateSuccess.assign(nRates, 0);
+    numSamplesSkipped.assign(nRates, 0);
+    successHist.assign(nRates, 0);
+    attemptHist.assign(nRates, 0);
+    prob.assign(nRates, 0);
+    ewmaProb.assign(nRates, 0);
+    ewmsdProb.assign(nRates, 0);
+    throughput.assign(nRates, 0);
+}
+
 MinstrelHtWifiManager::MinstrelHtWifiManager()
     : m_numGroups(0),
       m_numRates(0),
@@ -626,11 +646,8 @@ MinstrelHtWifiManager::DoReportDataFailed(WifiRemoteStation* st)
     }
     else if (station->m_longRetry < CountRetries(station))
     {
-        uint8_t rateId = GetRateId(station->m_txrate);
-        uint8_t groupId = GetGroupId(station->m_txrate);
-        station->m_groupsTable[groupId]
-            .m_ratesTable[rateId]
-            .numRateAttempt++; // Increment the attempts counter for the rate used.
+        station->m_rateStats
+            .numRateAttempt[station->m_txrate]++; // Increment the attempts counter for the rate used.
         UpdateRate(station);
     }
 }
@@ -681,10 +698,8 @@ MinstrelHtWifiManager::DoReportDataOk(WifiRemoteStation* st,
     }
     else
     {
-        uint8_t rateId = GetRateId(station->m_txrate);
-        uint8_t groupId = GetGroupId(station->m_txrate);
-        station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess++;
-        station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt++;
+        station->m_rateStats.numRateSuccess[station->m_txrate]++;
+        station->m_rateStats.numRateAttempt[station->m_txrate]++;
 
         UpdatePacketCounters(station, 1, 0);
 
@@ -789,11 +804,8 @@ MinstrelHtWifiManager::DoReportAmpduTxStatus(WifiRemoteStation* st,
 
     UpdatePacketCounters(station, nSuccessfulMpdus, nFailedMpdus);
 
-    uint8_t rateId = GetRateId(station->m_txrate);
-    uint8_t groupId = GetGroupId(station->m_txrate);
-    station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess += nSuccessfulMpdus;
-    station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt +=
-        nSuccessfulMpdus + nFailedMpdus;
+    station->m_rateStats.numRateSuccess[station->m_txrate] += nSuccessfulMpdus;
+    station->m_rateStats.numRateAttempt[station->m_txrate] += nSuccessfulMpdus + nFailedMpdus;
 
     if (nSuccessfulMpdus == 0 && station->m_longRetry < CountRetries(station))
     {
@@ -1318,16 +1330,17 @@ MinstrelHtWifiManager::FindRate(MinstrelHtWifiRemoteStation* station)
              * Also do not sample if the probability is already higher than 95%
              * to avoid wasting airtime.
              */
-            MinstrelHtRateInfo sampleRateInfo =
+            const auto& sampleRateInfo =
                 station->m_groupsTable[sampleGroupId].m_ratesTable[sampleRateId];
+            const auto sampleEwmaProb = station->m_rateStats.ewmaProb[sampleIdx];
 
             NS_LOG_DEBUG("Use sample rate? MaxTpRate= "
                          << station->m_maxTpRate << " CurrentRate= " << station->m_txrate
                          << " SampleRate= " << sampleIdx
-                         << " SampleProb= " << sampleRateInfo.ewmaProb);
+                         << " SampleProb= " << sampleEwmaProb);
 
             if (sampleIdx != station->m_maxTpRate && sampleIdx != station->m_maxTpRate2 &&
-                sampleIdx != station->m_maxProbRate && sampleRateInfo.ewmaProb <= 95)
+                sampleIdx != station->m_maxProbRate && sampleEwmaProb <= 95)
             {
                 /**
                  * Make sure that lower rates get sampled only occasionally,
@@ -1371,7 +1384,8 @@ MinstrelHtWifiManager::FindRate(MinstrelHtWifiRemoteStation* station)
                 else
                 {
                     station->m_numSamplesSlow++;
-                    if (sampleRateInfo.numSamplesSkipped >= 20 && station->m_numSamplesSlow <= 2)
+                    if (station->m_rateStats.numSamplesSkipped[sampleIdx] >= 20 &&
+                        station->m_numSamplesSlow <= 2)
                     {
                         /// Set flag that we are currently sampling.
                         station->m_isSampling = true;
@@ -1410,8 +1424,6 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
     station->m_numSamplesSlow = 0;
     station->m_sampleCount = 0;
 
-    double tempProb;
-
     if (station->m_ampduPacketCount > 0)
     {
         uint32_t newLen = station->m_ampduLen / station->m_ampduPacketCount;
@@ -1426,7 +1438,73 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
     station->m_maxTpRate2 = GetLowestIndex(station);
     station->m_maxProbRate = GetLowestIndex(station);
 
-    /// Update throughput and EWMA for each rate inside each group.
+    /// Update throughput and EWMA for each rate.
+    auto& stats = station->m_rateStats;
+    const std::size_t nRates = stats.supported.size();
+    for (std::size_t k = 0; k < nRates; k++)
+    {
+        if (!stats.supported[k])
+        {
+            continue;
+        }
+
+        NS_LOG_DEBUG(+GetRateId(k) << " "
+                                   << GetMcsSupported(station,
+                                                      station->m_groupsTable[GetGroupId(k)]
+                                                          .m_ratesTable[GetRateId(k)]
+                                                          .mcsIndex)
+                                   << "\t attempt=" << stats.numRateAttempt[k]
+                                   << "\t success=" << stats.numRateSuccess[k]);
+
+        /// If we've attempted something.
+        if (stats.numRateAttempt[k] > 0)
+        {
+            stats.numSamplesSkipped[k] = 0;
+            /**
+             * Calculate the probability of success.
+             * Assume probability scales from 0 to 100.
+             */
+            double tempProb = (100 * stats.numRateSuccess[k]) / stats.numRateAttempt[k];
+
+            /// Bookkeeping.
+            stats.prob[k] = tempProb;
+
+            if (stats.successHist[k] == 0)
+            {
+                stats.ewmaProb[k] = tempProb;
+            }
+            else
+            {
+                stats.ewmsdProb[k] =
+                    CalculateEwmsd(stats.ewmsdProb[k], tempProb, stats.ewmaProb[k], m_ewmaLevel);
+                /// EWMA probability
+                tempProb =
+                    (tempProb * (100 - m_ewmaLevel) + stats.ewmaProb[k] * m_ewmaLevel) / 100;
+                stats.ewmaProb[k] = tempProb;
+            }
+
+            stats.throughput[k] =
+                CalculateThroughput(station, GetGroupId(k), GetRateId(k), tempProb);
+
+            stats.successHist[k] += stats.numRateSuccess[k];
+            stats.attemptHist[k] += stats.numRateAttempt[k];
+        }
+        else
+        {
+            stats.numSamplesSkipped[k]++;
+        }
+
+        /// Bookkeeping.
+        stats.prevNumRateSuccess[k] = stats.numRateSuccess[k];
+        stats.prevNumRateAttempt[k] = stats.numRateAttempt[k];
+        stats.numRateSuccess[k] = 0;
+        stats.numRateAttempt[k] = 0;
+    }
+
+    /**
+     * Find the best rates. Rates are visited in increasing order of index, so that
+     * the rates initially selected (the lowest indices) are visited first.
+     */
     for (uint8_t j = 0; j < m_numGroups; j++)
     {
         if (station->m_groupsTable[j].m_supported)
@@ -1444,71 +1522,7 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
                 {
                     station->m_groupsTable[j].m_ratesTable[i].retryUpdated = false;
 
-                    NS_LOG_DEBUG(
-                        +i << " "
-                           << GetMcsSupported(station,
-                                              station->m_groupsTable[j].m_ratesTable[i].mcsIndex)
-                           << "\t attempt="
-                           << station->m_groupsTable[j].m_ratesTable[i].numRateAttempt
-                           << "\t success="
-                           << station->m_groupsTable[j].m_ratesTable[i].numRateSuccess);
-
-                    /// If we've attempted something.
-                    if (station->m_groupsTable[j].m_ratesTable[i].numRateAttempt > 0)
-                    {
-                        station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped = 0;
-                        /**
-                         * Calculate the probability of success.
-                         * Assume probability scales from 0 to 100.
-                         */
-                        tempProb =
-                            (100 * station->m_groupsTable[j].m_ratesTable[i].numRateSuccess) /
-                            station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-
-                        /// Bookkeeping.
-                        station->m_groupsTable[j].m_ratesTable[i].prob = tempProb;
-
-                        if (station->m_groupsTable[j].m_ratesTable[i].successHist == 0)
-                        {
-                            station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
-                        else
-                        {
-                            station->m_groupsTable[j].m_ratesTable[i].ewmsdProb =
-                                CalculateEwmsd(station->m_groupsTable[j].m_ratesTable[i].ewmsdProb,
-                                               tempProb,
-                                               station->m_groupsTable[j].m_ratesTable[i].ewmaProb,
-                                               m_ewmaLevel);
-                            /// EWMA probability
-                            tempProb =
-                                (tempProb * (100 - m_ewmaLevel) +
-                                 station->m_groupsTable[j].m_ratesTable[i].ewmaProb * m_ewmaLevel) /
-                                100;
-                            station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
-
-                        station->m_groupsTable[j].m_ratesTable[i].throughput =
-                            CalculateThroughput(station, j, i, tempProb);
-
-                        station->m_groupsTable[j].m_ratesTable[i].successHist +=
-                            station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                        station->m_groupsTable[j].m_ratesTable[i].attemptHist +=
-                            station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                    }
-                    else
-                    {
-                        station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped++;
-                    }
-
-                    /// Bookkeeping.
-                    station->m_groupsTable[j].m_ratesTable[i].prevNumRateSuccess =
-                        station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                    station->m_groupsTable[j].m_ratesTable[i].prevNumRateAttempt =
-                        station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                    station->m_groupsTable[j].m_ratesTable[i].numRateSuccess = 0;
-                    station->m_groupsTable[j].m_ratesTable[i].numRateAttempt = 0;
-
-                    if (station->m_groupsTable[j].m_ratesTable[i].throughput != 0)
+                    if (stats.throughput[GetIndex(j, i)] != 0)
                     {
                         SetBestStationThRates(station, GetIndex(j, i));
                         SetBestProbabilityRate(station, GetIndex(j, i));
@@ -1555,14 +1569,14 @@ MinstrelHtWifiManager::CalculateThroughput(MinstrelHtWifiRemoteStation* station,
          * For the throughput calculation, limit the probability value to 90% to
          * account for collision related packet error rate fluctuation.
          */
-        Time txTime = station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTime;
+        double txTime = station->m_rateStats.txTime[GetIndex(groupId, rateId)];
         if (ewmaProb > 90)
         {
-            return 90 / txTime.GetSeconds();
+            return 90 / txTime;
         }
         else
         {
-            return ewmaProb / txTime.GetSeconds();
+            return ewmaProb / txTime;
         }
     }
 }
@@ -1570,41 +1584,22 @@ MinstrelHtWifiManager::CalculateThroughput(MinstrelHtWifiRemoteStation* station,
 void
 MinstrelHtWifiManager::SetBestProbabilityRate(MinstrelHtWifiRemoteStation* station, uint16_t index)
 {
-    GroupInfo* group;
-    MinstrelHtRateInfo rate;
-    uint8_t tmpGroupId;
-    uint8_t tmpRateId;
-    double tmpTh;
-    double tmpProb;
-    uint8_t groupId;
-    uint8_t rateId;
-    double currentTh;
-    // maximum group probability (GP) variables
-    uint8_t maxGPGroupId;
-    uint8_t maxGPRateId;
-    double maxGPTh;
-
-    groupId = GetGroupId(index);
-    rateId = GetRateId(index);
-    group = &station->m_groupsTable[groupId];
-    rate = group->m_ratesTable[rateId];
-
-    tmpGroupId = GetGroupId(station->m_maxProbRate);
-    tmpRateId = GetRateId(station->m_maxProbRate);
-    tmpProb = station->m_groupsTable[tmpGroupId].m_ratesTable[tmpRateId].ewmaProb;
-    tmpTh = station->m_groupsTable[tmpGroupId].m_ratesTable[tmpRateId].throughput;
-
-    if (rate.ewmaProb > 75)
-    {
-        currentTh = station->m_groupsTable[groupId].m_ratesTable[rateId].throughput;
+    const auto& stats = station->m_rateStats;
+    GroupInfo* group = &station->m_groupsTable[GetGroupId(index)];
+
+    double tmpProb = stats.ewmaProb[station->m_maxProbRate];
+    double tmpTh = stats.throughput[station->m_maxProbRate];
+
+    if (stats.ewmaProb[index] > 75)
+    {
+        double currentTh = stats.throughput[index];
         if (currentTh > tmpTh)
         {
             station->m_maxProbRate = index;
         }
 
-        maxGPGroupId = GetGroupId(group->m_maxProbRate);
-        maxGPRateId = GetRateId(group->m_maxProbRate);
-        maxGPTh = station->m_groupsTable[maxGPGroupId].m_ratesTable[maxGPRateId].throughput;
+        // maximum group probability (GP) throughput
+        double maxGPTh = stats.throughput[group->m_maxProbRate];
 
         if (currentTh > maxGPTh)
         {
@@ -1613,12 +1608,11 @@ MinstrelHtWifiManager::SetBestProbabilityRate(MinstrelHtWifiRemoteStation* stati
     }
     else
     {
-        if (rate.ewmaProb > tmpProb)
+        if (stats.ewmaProb[index] > tmpProb)
         {
             station->m_maxProbRate = index;
         }
-        maxGPRateId = GetRateId(group->m_maxProbRate);
-        if (rate.ewmaProb > group->m_ratesTable[maxGPRateId].ewmaProb)
+        if (stats.ewmaProb[index] > stats.ewmaProb[group->m_maxProbRate])
         {
             group->m_maxProbRate = index;
         }
@@ -1635,33 +1629,14 @@ MinstrelHtWifiManager::SetBestProbabilityRate(MinstrelHtWifiRemoteStation* stati
 void
 MinstrelHtWifiManager::SetBestStationThRates(MinstrelHtWifiRemoteStation* station, uint16_t index)
 {
-    uint8_t groupId;
-    uint8_t rateId;
-    double th;
-    double prob;
-    uint8_t maxTpGroupId;
-    uint8_t maxTpRateId;
-    uint8_t maxTp2GroupId;
-    uint8_t maxTp2RateId;
-    double maxTpTh;
-    double maxTpProb;
-    double maxTp2Th;
-    double maxTp2Prob;
-
-    groupId = GetGroupId(index);
-    rateId = GetRateId(index);
-    prob = station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb;
-    th = station->m_groupsTable[groupId].m_ratesTable[rateId].throughput;
-
-    maxTpGroupId = GetGroupId(station->m_maxTpRate);
-    maxTpRateId = GetRateId(station->m_maxTpRate);
-    maxTpProb = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].ewmaProb;
-    maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].throughput;
-
-    maxTp2GroupId = GetGroupId(station->m_maxTpRate2);
-    maxTp2RateId = GetRateId(station->m_maxTpRate2);
-    maxTp2Prob = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].ewmaProb;
-    maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].throughput;
+    const auto& stats = station->m_rateStats;
+    double prob = stats.ewmaProb[index];
+    double th = stats.throughput[index];
+
+    double maxTpProb = stats.ewmaProb[station->m_maxTpRate];
+    double maxTpTh = stats.throughput[station->m_maxTpRate];
+    double maxTp2Prob = stats.ewmaProb[station->m_maxTpRate2];
+    double maxTp2Th = stats.throughput[station->m_maxTpRate2];
 
     if (th > maxTpTh || (th == maxTpTh && prob > maxTpProb))
     {
@@ -1675,16 +1650,11 @@ MinstrelHtWifiManager::SetBestStationThRates(MinstrelHtWifiRemoteStation* statio
 
     // Find best rates per group
 
-    GroupInfo* group = &station->m_groupsTable[groupId];
-    maxTpGroupId = GetGroupId(group->m_maxTpRate);
-    maxTpRateId = GetRateId(group->m_maxTpRate);
-    maxTpProb = group->m_ratesTable[maxTpRateId].ewmaProb;
-    maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].throughput;
-
-    maxTp2GroupId = GetGroupId(group->m_maxTpRate2);
-    maxTp2RateId = GetRateId(group->m_maxTpRate2);
-    maxTp2Prob = group->m_ratesTable[maxTp2RateId].ewmaProb;
-    maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].throughput;
+    GroupInfo* group = &station->m_groupsTable[GetGroupId(index)];
+    maxTpProb = stats.ewmaProb[group->m_maxTpRate];
+    maxTpTh = stats.throughput[group->m_maxTpRate];
+    maxTp2Prob = stats.ewmaProb[group->m_maxTpRate2];
+    maxTp2Th = stats.throughput[group->m_maxTpRate2];
 
     if (th > maxTpTh || (th == maxTpTh && prob > maxTpProb))
     {
@@ -1703,6 +1673,7 @@ MinstrelHtWifiManager::RateInit(MinstrelHtWifiRemoteStation* station)
     NS_LOG_FUNCTION(this << station);
 
     station->m_groupsTable = McsGroupData(m_numGroups);
+    station->m_rateStats.Reset(m_numGroups * m_numRates);
 
     /**
      * Initialize groups supported by the receiver.
@@ -1824,18 +1795,12 @@ MinstrelHtWifiManager::RateInit(MinstrelHtWifiRemoteStation* station)
                     station->m_groupsTable[groupId].m_ratesTable[rateId].supported = true;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].mcsIndex =
                         i; /// Mapping between rateId and operationalMcsSet
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].prob = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateAttempt = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateSuccess = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].numSamplesSkipped = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].successHist = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].attemptHist = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].throughput = 0;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTime =
                         GetFirstMpduTxTime(groupId, GetMcsSupported(station, i));
+                    const auto idx = GetIndex(groupId, rateId);
+                    station->m_rateStats.supported[idx] = 1;
+                    station->m_rateStats.txTime[idx] =
+                        station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTime.GetSeconds();
                     station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 0;
                     station->m_groupsTable[groupId].m_ratesTable[rateId].adjustedRetryCount = 0;
                     CalculateRetransmits(station, groupId, rateId);
@@ -1881,7 +1846,7 @@ MinstrelHtWifiManager::CalculateRetransmits(MinstrelHtWifiRemoteStation* station
     Time slotTime = GetPhy()->GetSlot();
     Time ackTime = GetPhy()->GetSifs() + GetPhy()->GetBlockAckTxTime();
 
-    if (station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb < 1)
+    if (station->m_rateStats.ewmaProb[GetIndex(groupId, rateId)] < 1)
     {
         station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 1;
     }
@@ -2067,19 +2032,15 @@ MinstrelHtWifiManager::StatsDump(MinstrelHtWifiRemoteStation* station,
                 GetMcsSupported(station, station->m_groupsTable[groupId].m_ratesTable[i].mcsIndex));
             of << std::setw(6) << txTime.GetMicroSeconds() << "  ";
 
+            const auto& stats = station->m_rateStats;
             of << std::setw(7) << CalculateThroughput(station, groupId, i, 100) / 100 << "   "
-               << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable[i].throughput / 100
-               << "   " << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable[i].ewmaProb
-               << "  " << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable[i].ewmsdProb
-               << "  " << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable[i].prob
-               << "  " << std::setw(2) << station->m_groupsTable[groupId].m_ratesTable[i].retryCount
-               << "   " << std::setw(3)
-               << station->m_groupsTable[groupId].m_ratesTable[i].prevNumRateSuccess << "  "
-               << std::setw(3) << station->m_groupsTable[groupId].m_ratesTable[i].prevNumRateAttempt
-               << "   " << std::setw(9)
-               << station->m_groupsTable[groupId].m_ratesTable[i].successHist << "   "
-               << std::setw(9) << station->m_groupsTable[groupId].m_ratesTable[i].attemptHist
-               << "\n";
+               << std::setw(7) << stats.throughput[idx] / 100 << "   " << std::setw(7)
+               << stats.ewmaProb[idx] << "  " << std::setw(7) << stats.ewmsdProb[idx] << "  "
+               << std::setw(7) << stats.prob[idx] << "  " << std::setw(2)
+               << station->m_groupsTable[groupId].m_ratesTable[i].retryCount << "   "
+               << std::setw(3) << stats.prevNumRateSuccess[idx] << "  " << std::setw(3)
+               << stats.prevNumRateAttempt[idx] << "   " << std::setw(9) << stats.successHist[idx]
+               << "   " << std::setw(9) << stats.attemptHist[idx] << "\n";
         }
     }
 }
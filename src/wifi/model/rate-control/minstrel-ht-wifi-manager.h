@@ -100,7 +100,9 @@ typedef std::vector<McsGroup> MinstrelMcsGroups;
 struct MinstrelHtWifiRemoteStation;
 
 /**
- * A struct to contain all statistics information related to a data rate.
+ * A struct to contain the information related to a data rate that is not updated
+ * at every statistics update. The statistics of the rate are stored in the
+ * MinstrelHtRateStats of the station.
  */
 struct MinstrelHtRateInfo
 {
@@ -113,25 +115,7 @@ struct MinstrelHtRateInfo
     uint8_t mcsIndex;    //!< The index in the operationalMcsSet of the WifiRemoteStationManager.
     uint32_t retryCount; //!< Retry limit.
     uint32_t adjustedRetryCount; //!< Adjust the retry limit for this rate.
-    uint32_t numRateAttempt;     //!< Number of transmission attempts so far.
-    uint32_t numRateSuccess;     //!< Number of successful frames transmitted so far.
-    double prob; //!< Current probability within last time interval. (# frame success )/(# total
-                 //!< frames)
-    bool retryUpdated; //!< If number of retries was updated already.
-    /**
-     * Exponential weighted moving average of probability.
-     * EWMA calculation:
-     * ewma_prob =[prob *(100 - ewma_level) + (ewma_prob_old * ewma_level)]/100
-     */
-    double ewmaProb;
-    double ewmsdProb;            //!< Exponential weighted moving standard deviation of probability.
-    uint32_t prevNumRateAttempt; //!< Number of transmission attempts with previous rate.
-    uint32_t prevNumRateSuccess; //!< Number of successful frames transmitted with previous rate.
-    uint32_t numSamplesSkipped;  //!< Number of times this rate statistics were not updated because
-                                 //!< no attempts have been made.
-    uint64_t successHist;        //!< Aggregate of all transmission successes.
-    uint64_t attemptHist;        //!< Aggregate of all transmission attempts.
-    double throughput;           //!< Throughput of this rate (in packets per second).
+    bool retryUpdated;           //!< If number of retries was updated already.
 };
 
 /**
@@ -163,6 +147,45 @@ struct GroupInfo
  */
 typedef std::vector<GroupInfo> McsGroupData;
 
+/**
+ * Statistics of all the rates of a station, stored as a structure of arrays indexed
+ * by the rate index (i.e., groupId * numRates + rateId), so that the periodic update
+ * of the statistics of all the rates is performed by a loop over contiguous arrays.
+ */
+struct MinstrelHtRateStats
+{
+    /**
+     * Resize the arrays and reset the statistics of all the rates.
+     *
+     * \param nRates the total number of rates
+     */
+    void Reset(std::size_t nRates);
+
+    std::vector<uint8_t> supported; //!< Whether the rate and its group are supported.
+    std::vector<double> txTime;     //!< Perfect transmission time of the rate in seconds.
+    std::vector<uint32_t> numRateAttempt; //!< Number of transmission attempts so far.
+    std::vector<uint32_t> numRateSuccess; //!< Number of successful frames transmitted so far.
+    std::vector<uint32_t> prevNumRateAttempt; //!< Number of transmission attempts with previous
+                                              //!< rate.
+    std::vector<uint32_t> prevNumRateSuccess; //!< Number of successful frames transmitted with
+                                              //!< previous rate.
+    std::vector<uint32_t> numSamplesSkipped;  //!< Number of times the rate statistics were not
+                                              //!< updated because no attempts have been made.
+    std::vector<uint64_t> successHist;        //!< Aggregate of all transmission successes.
+    std::vector<uint64_t> attemptHist;        //!< Aggregate of all transmission attempts.
+    std::vector<double> prob; //!< Current probability within last time interval. (# frame
+                              //!< success )/(# total frames)
+    /**
+     * Exponential weighted moving average of probability.
+     * EWMA calculation:
+     * ewma_prob =[prob *(100 - ewma_level) + (ewma_prob_old * ewma_level)]/100
+     */
+    std::vector<double> ewmaProb;
+    std::vector<double> ewmsdProb;  //!< Exponential weighted moving standard deviation of
+                                    //!< probability.
+    std::vector<double> throughput; //!< Throughput of the rate (in packets per second).
+};
+
 /**
  * Constants for maximum values.
  */
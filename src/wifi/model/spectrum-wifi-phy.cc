@@ -422,6 +422,9 @@ SpectrumWifiPhy::StartRx(Ptr<SpectrumSignalParameters> rxParams,
         interface ? interface->GetBands() : m_currentSpectrumPhyInterface->GetBands();
     double totalRxPowerW = 0;
     RxPowerWattPerChannelBand rxPowerW;
+    // sum the received PSD once, so that the power of every channel band and RU is
+    // obtained in constant time
+    const auto cumulativePsd = WifiSpectrumValueHelper::GetCumulativePsd(receivedSignalPsd);
 
     std::size_t index = 0;
     uint16_t prevBw = 0;
@@ -431,7 +434,7 @@ SpectrumWifiPhy::StartRx(Ptr<SpectrumSignalParameters> rxParams,
         NS_ASSERT(bw <= channelWidth);
         index = ((bw != prevBw) ? 0 : (index + 1));
         double rxPowerPerBandW =
-            WifiSpectrumValueHelper::GetBandPowerW(receivedSignalPsd, band.indices);
+            WifiSpectrumValueHelper::GetBandPowerW(receivedSignalPsd, cumulativePsd, band.indices);
         NS_LOG_DEBUG("Signal power received (watts) before antenna gain for "
                      << bw << " MHz channel band " << index << ": " << band);
         rxPowerPerBandW *= DbToRatio(GetRxGain());
@@ -453,8 +456,9 @@ SpectrumWifiPhy::StartRx(Ptr<SpectrumSignalParameters> rxParams,
         NS_ASSERT(!heRuBands.empty());
         for (const auto& [band, ru] : heRuBands)
         {
-            double rxPowerPerBandW =
-                WifiSpectrumValueHelper::GetBandPowerW(receivedSignalPsd, band.indices);
+            double rxPowerPerBandW = WifiSpectrumValueHelper::GetBandPowerW(receivedSignalPsd,
+                                                                            cumulativePsd,
+                                                                            band.indices);
             NS_LOG_DEBUG("Signal power received (watts) before antenna gain for RU with type "
                          << ru.GetRuType() << " and index " << ru.GetIndex() << " -> ("
                          << band.indices.first << "; " << band.indices.second
@@ -24,6 +24,8 @@
 #include "ns3/address-utils.h"
 #include "ns3/nstime.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -69,7 +71,8 @@ WifiMacHeader::WifiMacHeader()
       m_seqSeq(0),
       m_qosEosp(0),
       m_qosAckPolicy(0), // Normal Ack
-      m_amsduPresent(0)
+      m_amsduPresent(0),
+      m_wireImageSize(0)
 {
 }
 
@@ -86,54 +89,63 @@ WifiMacHeader::~WifiMacHeader()
 void
 WifiMacHeader::SetDsFrom()
 {
+    m_wireImageSize = 0;
     m_ctrlFromDs = 1;
 }
 
 void
 WifiMacHeader::SetDsNotFrom()
 {
+    m_wireImageSize = 0;
     m_ctrlFromDs = 0;
 }
 
 void
 WifiMacHeader::SetDsTo()
 {
+    m_wireImageSize = 0;
     m_ctrlToDs = 1;
 }
 
 void
 WifiMacHeader::SetDsNotTo()
 {
+    m_wireImageSize = 0;
     m_ctrlToDs = 0;
 }
 
 void
 WifiMacHeader::SetAddr1(Mac48Address address)
 {
+    m_wireImageSize = 0;
     m_addr1 = address;
 }
 
 void
 WifiMacHeader::SetAddr2(Mac48Address address)
 {
+    m_wireImageSize = 0;
     m_addr2 = address;
 }
 
 void
 WifiMacHeader::SetAddr3(Mac48Address address)
 {
+    m_wireImageSize = 0;
     m_addr3 = address;
 }
 
 void
 WifiMacHeader::SetAddr4(Mac48Address address)
 {
+    m_wireImageSize = 0;
     m_addr4 = address;
 }
 
 void
 WifiMacHeader::SetType(WifiMacType type, bool resetToDsFromDs)
 {
+    m_wireImageSize = 0;
     switch (type)
     {
     case WIFI_MAC_CTL_TRIGGER:
@@ -301,6 +313,7 @@ WifiMacHeader::SetType(WifiMacType type, bool resetToDsFromDs)
 void
 WifiMacHeader::SetRawDuration(uint16_t duration)
 {
+    m_wireImageSize = 0;
     NS_ASSERT(duration <= 32768);
     m_duration = duration;
 }
@@ -308,6 +321,7 @@ WifiMacHeader::SetRawDuration(uint16_t duration)
 void
 WifiMacHeader::SetDuration(Time duration)
 {
+    m_wireImageSize = 0;
     auto duration_us =
         static_cast<int64_t>(ceil(static_cast<double>(duration.GetNanoSeconds()) / 1000));
     NS_ASSERT(duration_us >= 0 && duration_us <= 0x7fff);
@@ -317,90 +331,105 @@ WifiMacHeader::SetDuration(Time duration)
 void
 WifiMacHeader::SetId(uint16_t id)
 {
+    m_wireImageSize = 0;
     m_duration = id;
 }
 
 void
 WifiMacHeader::SetSequenceNumber(uint16_t seq)
 {
+    m_wireImageSize = 0;
     m_seqSeq = seq;
 }
 
 void
 WifiMacHeader::SetFragmentNumber(uint8_t frag)
 {
+    m_wireImageSize = 0;
     m_seqFrag = frag;
 }
 
 void
 WifiMacHeader::SetNoMoreFragments()
 {
+    m_wireImageSize = 0;
     m_ctrlMoreFrag = 0;
 }
 
 void
 WifiMacHeader::SetMoreFragments()
 {
+    m_wireImageSize = 0;
     m_ctrlMoreFrag = 1;
 }
 
 void
 WifiMacHeader::SetOrder()
 {
+    m_wireImageSize = 0;
     m_ctrlOrder = 1;
 }
 
 void
 WifiMacHeader::SetNoOrder()
 {
+    m_wireImageSize = 0;
     m_ctrlOrder = 0;
 }
 
 void
 WifiMacHeader::SetRetry()
 {
+    m_wireImageSize = 0;
     m_ctrlRetry = 1;
 }
 
 void
 WifiMacHeader::SetNoRetry()
 {
+    m_wireImageSize = 0;
     m_ctrlRetry = 0;
 }
 
 void
 WifiMacHeader::SetQosTid(uint8_t tid)
 {
+    m_wireImageSize = 0;
     m_qosTid = tid;
 }
 
 void
 WifiMacHeader::SetPowerManagement()
 {
+    m_wireImageSize = 0;
     m_ctrlPowerManagement = 1;
 }
 
 void
 WifiMacHeader::SetNoPowerManagement()
 {
+    m_wireImageSize = 0;
     m_ctrlPowerManagement = 0;
 }
 
 void
 WifiMacHeader::SetQosEosp()
 {
+    m_wireImageSize = 0;
     m_qosEosp = 1;
 }
 
 void
 WifiMacHeader::SetQosNoEosp()
 {
+    m_wireImageSize = 0;
     m_qosEosp = 0;
 }
 
 void
 WifiMacHeader::SetQosAckPolicy(QosAckPolicy policy)
 {
+    m_wireImageSize = 0;
     switch (policy)
     {
     case NORMAL_ACK:
@@ -421,24 +450,28 @@ WifiMacHeader::SetQosAckPolicy(QosAckPolicy policy)
 void
 WifiMacHeader::SetQosAmsdu()
 {
+    m_wireImageSize = 0;
     m_amsduPresent = 1;
 }
 
 void
 WifiMacHeader::SetQosNoAmsdu()
 {
+    m_wireImageSize = 0;
     m_amsduPresent = 0;
 }
 
 void
 WifiMacHeader::SetQosTxopLimit(uint8_t txop)
 {
+    m_wireImageSize = 0;
     m_qosStuff = txop;
 }
 
 void
 WifiMacHeader::SetQosQueueSize(uint8_t size)
 {
+    m_wireImageSize = 0;
     m_qosEosp = 1;
     m_qosStuff = size;
 }
@@ -446,6 +479,7 @@ WifiMacHeader::SetQosQueueSize(uint8_t size)
 void
 WifiMacHeader::SetQosMeshControlPresent()
 {
+    m_wireImageSize = 0;
     // Mark bit 0 of this variable instead of bit 8, since m_qosStuff is
     // shifted by one byte when serialized
     m_qosStuff = m_qosStuff | 0x01; // bit 8 of QoS Control Field
@@ -454,6 +488,7 @@ WifiMacHeader::SetQosMeshControlPresent()
 void
 WifiMacHeader::SetQosNoMeshControlPresent()
 {
+    m_wireImageSize = 0;
     // Clear bit 0 of this variable instead of bit 8, since m_qosStuff is
     // shifted by one byte when serialized
     m_qosStuff = m_qosStuff & 0xfe; // bit 8 of QoS Control Field
@@ -967,6 +1002,7 @@ WifiMacHeader::GetQosControl() const
 void
 WifiMacHeader::SetFrameControl(uint16_t ctrl)
 {
+    m_wireImageSize = 0;
     m_ctrlType = (ctrl >> 2) & 0x03;
     m_ctrlSubtype = (ctrl >> 4) & 0x0f;
     m_ctrlToDs = (ctrl >> 8) & 0x01;
@@ -982,6 +1018,7 @@ WifiMacHeader::SetFrameControl(uint16_t ctrl)
 void
 WifiMacHeader::SetSequenceControl(uint16_t seq)
 {
+    m_wireImageSize = 0;
     m_seqFrag = seq & 0x0f;
     m_seqSeq = (seq >> 4) & 0x0fff;
 }
@@ -989,6 +1026,7 @@ WifiMacHeader::SetSequenceControl(uint16_t seq)
 void
 WifiMacHeader::SetQosControl(uint16_t qos)
 {
+    m_wireImageSize = 0;
     m_qosTid = qos & 0x000f;
     m_qosEosp = (qos >> 4) & 0x0001;
     m_qosAckPolicy = (qos >> 5) & 0x0003;
@@ -1233,18 +1271,65 @@ WifiMacHeader::GetSerializedSize() const
     return GetSize();
 }
 
-void
-WifiMacHeader::Serialize(Buffer::Iterator i) const
+namespace
+{
+
+/**
+ * Write a 16-bit value in little endian order at the given position of a buffer.
+ *
+ * \param buffer the position in the buffer
+ * \param value the value to write
+ * \return the position following the written value
+ */
+inline uint8_t*
+WriteU16(uint8_t* buffer, uint16_t value)
 {
-    i.WriteHtolsbU16(GetFrameControl());
-    i.WriteHtolsbU16(m_duration);
-    WriteTo(i, m_addr1);
+    buffer[0] = value & 0xff;
+    buffer[1] = (value >> 8) & 0xff;
+    return buffer + 2;
+}
+
+/**
+ * Write a MAC address at the given position of a buffer.
+ *
+ * \param buffer the position in the buffer
+ * \param address the MAC address to write
+ * \return the position following the written address
+ */
+inline uint8_t*
+WriteAddress(uint8_t* buffer, const Mac48Address& address)
+{
+    address.CopyTo(buffer);
+    return buffer + 6;
+}
+
+/**
+ * Read a 16-bit value in little endian order from the given position of a buffer.
+ *
+ * \param buffer the position in the buffer
+ * \return the value read
+ */
+inline uint16_t
+ReadU16(const uint8_t* buffer)
+{
+    return static_cast<uint16_t>(buffer[0] | (buffer[1] << 8));
+}
+
+} // unnamed namespace
+
+uint32_t
+WifiMacHeader::WriteWireImage(uint8_t* buffer) const
+{
+    uint8_t* i = buffer;
+    i = WriteU16(i, GetFrameControl());
+    i = WriteU16(i, m_duration);
+    i = WriteAddress(i, m_addr1);
     switch (m_ctrlType)
     {
     case TYPE_MGT:
-        WriteTo(i, m_addr2);
-        WriteTo(i, m_addr3);
-        i.WriteHtolsbU16(GetSequenceControl());
+        i = WriteAddress(i, m_addr2);
+        i = WriteAddress(i, m_addr3);
+        i = WriteU16(i, GetSequenceControl());
         break;
     case TYPE_CTL:
         switch (m_ctrlSubtype)
@@ -1256,7 +1341,7 @@ WifiMacHeader::Serialize(Buffer::Iterator i) const
         case SUBTYPE_CTL_BACKRESP:
         case SUBTYPE_CTL_END:
         case SUBTYPE_CTL_END_ACK:
-            WriteTo(i, m_addr2);
+            i = WriteAddress(i, m_addr2);
             break;
         case SUBTYPE_CTL_CTS:
         case SUBTYPE_CTL_ACK:
@@ -1268,16 +1353,16 @@ WifiMacHeader::Serialize(Buffer::Iterator i) const
         }
         break;
     case TYPE_DATA: {
-        WriteTo(i, m_addr2);
-        WriteTo(i, m_addr3);
-        i.WriteHtolsbU16(GetSequenceControl());
+        i = WriteAddress(i, m_addr2);
+        i = WriteAddress(i, m_addr3);
+        i = WriteU16(i, GetSequenceControl());
         if (m_ctrlToDs && m_ctrlFromDs)
         {
-            WriteTo(i, m_addr4);
+            i = WriteAddress(i, m_addr4);
         }
         if (m_ctrlSubtype & 0x08)
         {
-            i.WriteHtolsbU16(GetQosControl());
+            i = WriteU16(i, GetQosControl());
         }
     }
     break;
@@ -1286,22 +1371,24 @@ WifiMacHeader::Serialize(Buffer::Iterator i) const
         NS_ASSERT(false);
         break;
     }
+    return i - buffer;
 }
 
 uint32_t
-WifiMacHeader::Deserialize(Buffer::Iterator start)
+WifiMacHeader::ReadWireImage(const uint8_t* buffer)
 {
-    Buffer::Iterator i = start;
-    uint16_t frame_control = i.ReadLsbtohU16();
-    SetFrameControl(frame_control);
-    m_duration = i.ReadLsbtohU16();
-    ReadFrom(i, m_addr1);
+    const uint8_t* i = buffer;
+    SetFrameControl(ReadU16(i));
+    m_duration = ReadU16(i + 2);
+    m_addr1.CopyFrom(i + 4);
+    i += 10;
     switch (m_ctrlType)
     {
     case TYPE_MGT:
-        ReadFrom(i, m_addr2);
-        ReadFrom(i, m_addr3);
-        SetSequenceControl(i.ReadLsbtohU16());
+        m_addr2.CopyFrom(i);
+        m_addr3.CopyFrom(i + 6);
+        SetSequenceControl(ReadU16(i + 12));
+        i += 14;
         break;
     case TYPE_CTL:
         switch (m_ctrlSubtype)
@@ -1313,7 +1400,8 @@ WifiMacHeader::Deserialize(Buffer::Iterator start)
         case SUBTYPE_CTL_BACKRESP:
         case SUBTYPE_CTL_END:
         case SUBTYPE_CTL_END_ACK:
-            ReadFrom(i, m_addr2);
+            m_addr2.CopyFrom(i);
+            i += 6;
             break;
         case SUBTYPE_CTL_CTS:
         case SUBTYPE_CTL_ACK:
@@ -1321,20 +1409,49 @@ WifiMacHeader::Deserialize(Buffer::Iterator start)
         }
         break;
     case TYPE_DATA:
-        ReadFrom(i, m_addr2);
-        ReadFrom(i, m_addr3);
-        SetSequenceControl(i.ReadLsbtohU16());
+        m_addr2.CopyFrom(i);
+        m_addr3.CopyFrom(i + 6);
+        SetSequenceControl(ReadU16(i + 12));
+        i += 14;
         if (m_ctrlToDs && m_ctrlFromDs)
         {
-            ReadFrom(i, m_addr4);
+            m_addr4.CopyFrom(i);
+            i += 6;
         }
         if (m_ctrlSubtype & 0x08)
         {
-            SetQosControl(i.ReadLsbtohU16());
+            SetQosControl(ReadU16(i));
+            i += 2;
         }
         break;
     }
-    return i.GetDistanceFrom(start);
+    return i - buffer;
+}
+
+void
+WifiMacHeader::Serialize(Buffer::Iterator i) const
+{
+    if (m_wireImageSize == 0)
+    {
+        m_wireImageSize = WriteWireImage(m_wireImage.data());
+    }
+    i.Write(m_wireImage.data(), m_wireImageSize);
+}
+
+uint32_t
+WifiMacHeader::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+    // the Frame Control field determines the size of the header
+    SetFrameControl(i.ReadLsbtohU16());
+    const auto size = std::clamp<uint32_t>(GetSize(), 2 + 2 + 6, m_wireImage.size());
+    i = start;
+    i.Read(m_wireImage.data(), size);
+    const auto readSize = ReadWireImage(m_wireImage.data());
+    // the received header may include bits that are not modelled (e.g., the Protocol
+    // Version), hence the header is serialized again from its fields when needed
+    m_wireImageSize = 0;
+    return readSize;
 }
 
 } // namespace ns3
@@ -25,6 +25,8 @@
 #include "ns3/header.h"
 #include "ns3/mac48-address.h"
 
+#include <array>
+
 namespace ns3
 {
 
@@ -92,7 +94,9 @@ enum WifiMacType
 /**
  * \ingroup wifi
  *
- * Implements the IEEE 802.11 MAC header
+ * Implements the IEEE 802.11 MAC header. The serialized header is cached and
+ * copied as a whole by subsequent serializations (e.g., retransmissions), until
+ * a setter is called. A deserialized header also caches its serialized form.
  */
 class WifiMacHeader : public Header
 {
@@ -698,6 +702,30 @@ class WifiMacHeader : public Header
     uint8_t m_qosAckPolicy; ///< QoS Ack policy
     uint8_t m_amsduPresent; ///< A-MSDU present
     uint8_t m_qosStuff;     ///< QoS stuff
+
+  private:
+    /**
+     * Write the serialized header in the given buffer.
+     *
+     * \param buffer the buffer, which must be at least WIRE_IMAGE_MAX_SIZE bytes long
+     * \return the number of bytes written
+     */
+    uint32_t WriteWireImage(uint8_t* buffer) const;
+    /**
+     * Set the fields of this header by reading the serialized header from the given buffer.
+     *
+     * \param buffer the buffer
+     * \return the number of bytes read
+     */
+    uint32_t ReadWireImage(const uint8_t* buffer);
+
+    /// Maximum size of the serialized header (QoS Data frame with four addresses)
+    static constexpr std::size_t WIRE_IMAGE_MAX_SIZE = 2 + 2 + 6 + 6 + 6 + 2 + 6 + 2;
+
+    mutable std::array<uint8_t, WIRE_IMAGE_MAX_SIZE>
+        m_wireImage;                  ///< the serialized header, reused by subsequent
+                                      ///< serializations as long as no field is modified
+    mutable uint8_t m_wireImageSize; ///< the size of m_wireImage (zero if not up-to-date)
 };
 
 } // namespace ns3
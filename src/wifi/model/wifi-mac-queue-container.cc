@@ -25,6 +25,8 @@
 #include "ns3/mac48-address.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -33,22 +35,23 @@ WifiMacQueueContainer::clear()
 {
     m_queues.clear();
     m_expiredQueue.clear();
-    m_nBytesPerQueue.clear();
+    m_expiryHeap = {};
+    m_pendingQueues.clear();
 }
 
 WifiMacQueueContainer::iterator
 WifiMacQueueContainer::insert(const_iterator pos, Ptr<WifiMpdu> item)
 {
     WifiContainerQueueId queueId = GetQueueId(item);
+    auto& queueInfo = m_queues[queueId];
 
-    NS_ABORT_MSG_UNLESS(pos == m_queues[queueId].cend() || GetQueueId(pos->mpdu) == queueId,
+    NS_ABORT_MSG_UNLESS(pos == queueInfo.queue.cend() || GetQueueId(pos->mpdu) == queueId,
                         "pos iterator does not point to the correct container queue");
     NS_ABORT_MSG_IF(!item->IsOriginal(), "Only the original copy of an MPDU can be inserted");
 
-    auto [it, ret] = m_nBytesPerQueue.insert({queueId, 0});
-    it->second += item->GetSize();
+    queueInfo.nBytes += item->GetSize();
 
-    return m_queues[queueId].emplace(pos, item);
+    return queueInfo.queue.emplace(pos, item);
 }
 
 WifiMacQueueContainer::iterator
@@ -59,13 +62,12 @@ WifiMacQueueContainer::erase(const_iterator pos)
         return m_expiredQueue.erase(pos);
     }
 
-    WifiContainerQueueId queueId = GetQueueId(pos->mpdu);
-    auto it = m_nBytesPerQueue.find(queueId);
-    NS_ASSERT(it != m_nBytesPerQueue.end());
-    NS_ASSERT(it->second >= pos->mpdu->GetSize());
-    it->second -= pos->mpdu->GetSize();
+    auto it = m_queues.find(GetQueueId(pos->mpdu));
+    NS_ASSERT(it != m_queues.end());
+    NS_ASSERT(it->second.nBytes >= pos->mpdu->GetSize());
+    it->second.nBytes -= pos->mpdu->GetSize();
 
-    return m_queues[queueId].erase(pos);
+    return it->second.queue.erase(pos);
 }
 
 Ptr<WifiMpdu>
@@ -100,17 +102,27 @@ WifiMacQueueContainer::GetQueueId(Ptr<const WifiMpdu> mpdu)
 const WifiMacQueueContainer::ContainerQueue&
 WifiMacQueueContainer::GetQueue(const WifiContainerQueueId& queueId) const
 {
-    return m_queues[queueId];
+    return m_queues[queueId].queue;
 }
 
 uint32_t
 WifiMacQueueContainer::GetNBytes(const WifiContainerQueueId& queueId) const
 {
-    if (auto it = m_queues.find(queueId); it == m_queues.end() || it->second.empty())
+    if (auto it = m_queues.find(queueId); it != m_queues.end())
     {
-        return 0;
+        return it->second.nBytes;
+    }
+    return 0;
+}
+
+void
+WifiMacQueueContainer::SetExpiryTime(iterator it, const Time& expiryTime) const
+{
+    it->expiryTime = expiryTime;
+    if (expiryTime != Time::Max())
+    {
+        m_expiryHeap.emplace(expiryTime, GetQueueId(it->mpdu));
     }
-    return m_nBytesPerQueue.at(queueId);
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
@@ -120,8 +132,9 @@ WifiMacQueueContainer::ExtractExpiredMpdus(const WifiContainerQueueId& queueId)
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
-WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
+WifiMacQueueContainer::DoExtractExpiredMpdus(QueueInfo& queueInfo) const
 {
+    auto& queue = queueInfo.queue;
     std::optional<std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>> ret;
     auto firstExpiredIt = queue.begin();
     auto lastExpiredIt = firstExpiredIt;
@@ -151,11 +164,8 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
             lastExpiredIt->ac = AC_UNDEF;
             lastExpiredIt->deleter(lastExpiredIt->mpdu);
 
-            WifiContainerQueueId queueId = GetQueueId(lastExpiredIt->mpdu);
-            auto it = m_nBytesPerQueue.find(queueId);
-            NS_ASSERT(it != m_nBytesPerQueue.end());
-            NS_ASSERT(it->second >= lastExpiredIt->mpdu->GetSize());
-            it->second -= lastExpiredIt->mpdu->GetSize();
+            NS_ASSERT(queueInfo.nBytes >= lastExpiredIt->mpdu->GetSize());
+            queueInfo.nBytes -= lastExpiredIt->mpdu->GetSize();
 
             ++lastExpiredIt;
         }
@@ -176,16 +186,44 @@ std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
 WifiMacQueueContainer::ExtractAllExpiredMpdus() const
 {
     std::optional<WifiMacQueueContainer::iterator> firstExpiredIt;
+    Time now = Simulator::Now();
+
+    // the queues to inspect are those that still held MPDUs with expired lifetime after
+    // the last call and those that hold MPDUs whose lifetime expired since the last call.
+    // Heap entries referring to MPDUs that already left the container are simply discarded
+    std::set<WifiContainerQueueId> queueIds;
+    queueIds.swap(m_pendingQueues);
 
-    for (auto& queue : m_queues)
+    while (!m_expiryHeap.empty() && m_expiryHeap.top().first <= now)
     {
-        auto [firstIt, lastIt] = DoExtractExpiredMpdus(queue.second);
+        queueIds.insert(m_expiryHeap.top().second);
+        m_expiryHeap.pop();
+    }
+
+    for (const auto& queueId : queueIds)
+    {
+        auto queueIt = m_queues.find(queueId);
+        if (queueIt == m_queues.end())
+        {
+            continue;
+        }
+        auto& queue = queueIt->second.queue;
+        auto [firstIt, lastIt] = DoExtractExpiredMpdus(queueIt->second);
 
         if (firstIt != lastIt && !firstExpiredIt)
         {
             // this is the first queue with MPDUs with expired lifetime
             firstExpiredIt = firstIt;
         }
+
+        // MPDUs with expired lifetime may have been left in the queue (e.g., because they
+        // are inflight); their heap entries have been removed, hence keep track of the queue
+        if (std::any_of(queue.cbegin(), queue.cend(), [now](const WifiMacQueueElem& elem) {
+                return elem.expiryTime <= now;
+            }))
+        {
+            m_pendingQueues.insert(queueId);
+        }
     }
     return std::make_pair(firstExpiredIt ? *firstExpiredIt : m_expiredQueue.end(),
                           m_expiredQueue.end());
@@ -207,16 +245,18 @@ std::size_t
 std::hash<ns3::WifiContainerQueueId>::operator()(ns3::WifiContainerQueueId queueId) const
 {
     auto [type, addrType, address, tid] = queueId;
-    const std::size_t size = tid.has_value() ? 8 : 7;
 
-    uint8_t buffer[size];
-    buffer[0] = type;
-    address.CopyTo(buffer + 1);
-    if (tid.has_value())
+    // pack the address (48 bits), the queue type (4 bits) and the TID (8 bits, or 0xff
+    // if not present) in a 64-bit integer, thus avoiding allocations in the hot path
+    uint8_t buffer[6];
+    address.CopyTo(buffer);
+    uint64_t key = 0;
+    for (const auto byte : buffer)
     {
-        buffer[7] = *tid;
+        key = (key << 8) | byte;
     }
+    key |= static_cast<uint64_t>(type & 0x0f) << 48;
+    key |= static_cast<uint64_t>(tid.value_or(0xff)) << 56;
 
-    std::string s(buffer, buffer + size);
-    return std::hash<std::string>{}(s);
+    return std::hash<uint64_t>{}(key);
 }
@@ -23,11 +23,15 @@
 #include "wifi-mac-queue-elem.h"
 
 #include "ns3/mac48-address.h"
+#include "ns3/nstime.h"
 
 #include <list>
 #include <optional>
+#include <queue>
+#include <set>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -109,6 +113,11 @@ namespace ns3
  *
  * This container holds multiple container queues organized in an hash table
  * whose keys are WifiContainerQueueId tuples identifying the container queues.
+ *
+ * The expiry times of the stored MPDUs are kept in a min-heap, so that the
+ * extraction of the MPDUs with expired lifetime from all the container queues
+ * only visits the container queues that actually hold such MPDUs (rather than
+ * all the container queues).
  */
 class WifiMacQueueContainer
 {
@@ -178,6 +187,17 @@ class WifiMacQueueContainer
      */
     uint32_t GetNBytes(const WifiContainerQueueId& queueId) const;
 
+    /**
+     * Set the expiry time of the MPDU pointed to by the given iterator. The expiry
+     * time of an MPDU must be set through this method (rather than by directly
+     * modifying the container element) for the MPDU to be considered by
+     * ExtractAllExpiredMpdus.
+     *
+     * \param it iterator pointing to the MPDU
+     * \param expiryTime the expiry time of the MPDU
+     */
+    void SetExpiryTime(iterator it, const Time& expiryTime) const;
+
     /**
      * Transfer non-inflight MPDUs with expired lifetime in the container queue identified by
      * the given QueueId to the container queue storing MPDUs with expired lifetime.
@@ -205,21 +225,49 @@ class WifiMacQueueContainer
     std::pair<iterator, iterator> GetAllExpiredMpdus() const;
 
   private:
+    /// Information stored for each container queue
+    struct QueueInfo
+    {
+        ContainerQueue queue; //!< the container queue
+        uint32_t nBytes{0};   //!< the size in bytes of the MPDUs in the container queue
+    };
+
     /**
      * Transfer non-inflight MPDUs with expired lifetime in the given container queue to the
      * container queue storing MPDUs with expired lifetime.
      *
-     * \param queue the given container queue
+     * \param queueInfo the information about the given container queue
      * \return the range [first, last) of iterators pointing to the MPDUs transferred
      *         to the container queue storing MPDUs with expired lifetime
      */
-    std::pair<iterator, iterator> DoExtractExpiredMpdus(ContainerQueue& queue) const;
+    std::pair<iterator, iterator> DoExtractExpiredMpdus(QueueInfo& queueInfo) const;
+
+    /// An entry of the heap of expiry times (expiry time of an MPDU, ID of its queue)
+    using ExpiryEntry = std::pair<Time, WifiContainerQueueId>;
+
+    /// Comparator placing the entry with the earliest expiry time on top of the heap
+    struct ExpiryEntryCompare
+    {
+        /**
+         * \param lhs the first entry
+         * \param rhs the second entry
+         * \return true if the first entry expires after the second entry
+         */
+        bool operator()(const ExpiryEntry& lhs, const ExpiryEntry& rhs) const
+        {
+            return lhs.first > rhs.first;
+        }
+    };
 
-    mutable std::unordered_map<WifiContainerQueueId, ContainerQueue>
+    mutable std::unordered_map<WifiContainerQueueId, QueueInfo>
         m_queues;                          //!< the container queues
     mutable ContainerQueue m_expiredQueue; //!< queue storing MPDUs with expired lifetime
-    mutable std::unordered_map<WifiContainerQueueId, uint32_t>
-        m_nBytesPerQueue; //!< size in bytes of the container queues
+    mutable std::priority_queue<ExpiryEntry, std::vector<ExpiryEntry>, ExpiryEntryCompare>
+        m_expiryHeap; //!< expiry times of the MPDUs whose lifetime had not expired
+                      //!< at the time of the last call to ExtractAllExpiredMpdus
+    mutable std::set<WifiContainerQueueId>
+        m_pendingQueues; //!< queues that held MPDUs with expired lifetime (e.g., in-flight)
+                         //!< after the last call to ExtractAllExpiredMpdus
 };
 
 } // namespace ns3
@@ -433,7 +433,7 @@ WifiMacQueue::Replace(Ptr<const WifiMpdu> currentItem, Ptr<WifiMpdu> newItem)
     auto pos = std::next(currentIt);
     DoDequeue({currentIt});
     bool ret = Insert(pos, newItem);
-    GetIt(newItem)->expiryTime = expiryTime;
+    GetContainer().SetExpiryTime(GetIt(newItem), expiryTime);
     // The size of a WifiMacQueue is measured as number of packets. We dequeued
     // one packet, so there is certainly room for inserting one packet
     NS_ABORT_IF(!ret);
@@ -489,7 +489,9 @@ WifiMacQueue::DoEnqueue(ConstIterator pos, Ptr<WifiMpdu> item)
         // set item's information about its position in the queue
         item->SetQueueIt(ret, {});
         ret->ac = m_ac;
-        ret->expiryTime = item->GetHeader().IsCtl() ? Time::Max() : Simulator::Now() + m_maxDelay;
+        GetContainer().SetExpiryTime(
+            ret,
+            item->GetHeader().IsCtl() ? Time::Max() : Simulator::Now() + m_maxDelay);
         WmqIteratorTag tag;
         ret->deleter = [tag](auto mpdu) { mpdu->SetQueueIt(std::nullopt, tag); };
 
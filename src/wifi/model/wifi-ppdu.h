@@ -23,6 +23,7 @@
 #include "wifi-tx-vector.h"
 
 #include "ns3/nstime.h"
+#include "ns3/pool-allocator.h"
 
 #include <list>
 #include <optional>
@@ -52,8 +53,11 @@ typedef std::unordered_map<uint16_t /* STA-ID */, Ptr<const WifiPsdu> /* PSDU */
  *
  * WifiPpdu stores a preamble, a modulation class, PHY headers and a PSDU.
  * This class should be subclassed for each amendment.
+ *
+ * PPDUs are allocated through the PoolAllocator, hence the storage of a PPDU
+ * is recycled once the last receiver is done with it.
  */
-class WifiPpdu : public SimpleRefCount<WifiPpdu>
+class WifiPpdu : public SimpleRefCount<WifiPpdu>, public PoolAllocated
 {
   public:
     /**
@@ -24,6 +24,7 @@
 #include "wifi-mpdu.h"
 
 #include "ns3/nstime.h"
+#include "ns3/pool-allocator.h"
 
 #include <set>
 #include <vector>
@@ -37,9 +38,10 @@ class Packet;
  * \ingroup wifi
  *
  * WifiPsdu stores an MPDU, S-MPDU or A-MPDU, by keeping header(s) and
- * payload(s) separate for each constituent MPDU.
+ * payload(s) separate for each constituent MPDU. PSDUs are allocated through
+ * the PoolAllocator.
  */
-class WifiPsdu : public SimpleRefCount<WifiPsdu>
+class WifiPsdu : public SimpleRefCount<WifiPsdu>, public PoolAllocated
 {
   public:
     /**
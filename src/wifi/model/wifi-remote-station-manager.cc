@@ -566,10 +566,10 @@ WifiRemoteStationManager::SetPsMode(const Mac48Address& address, bool isInPsMode
 std::optional<Mac48Address>
 WifiRemoteStationManager::GetMldAddress(const Mac48Address& address) const
 {
-    if (auto stateIt = m_states.find(address);
-        stateIt != m_states.end() && stateIt->second->m_mleCommonInfo)
+    if (auto index = FindStationIndex(address);
+        index && m_stationEntries[*index].state->m_mleCommonInfo)
     {
-        return stateIt->second->m_mleCommonInfo->m_mldMacAddress;
+        return m_stationEntries[*index].state->m_mleCommonInfo->m_mldMacAddress;
     }
 
     return std::nullopt;
@@ -578,16 +578,17 @@ WifiRemoteStationManager::GetMldAddress(const Mac48Address& address) const
 std::optional<Mac48Address>
 WifiRemoteStationManager::GetAffiliatedStaAddress(const Mac48Address& mldAddress) const
 {
-    auto stateIt = m_states.find(mldAddress);
+    auto index = FindStationIndex(mldAddress);
 
-    if (stateIt == m_states.end() || !stateIt->second->m_mleCommonInfo)
+    if (!index || !m_stationEntries[*index].state->m_mleCommonInfo)
     {
         // MLD address not found
         return std::nullopt;
     }
 
-    NS_ASSERT(stateIt->second->m_mleCommonInfo->m_mldMacAddress == mldAddress);
-    return stateIt->second->m_address;
+    const auto& state = m_stationEntries[*index].state;
+    NS_ASSERT(state->m_mleCommonInfo->m_mldMacAddress == mldAddress);
+    return state->m_address;
 }
 
 WifiTxVector
@@ -1415,12 +1416,37 @@ std::shared_ptr<WifiRemoteStationState>
 WifiRemoteStationManager::LookupState(Mac48Address address) const
 {
     NS_LOG_FUNCTION(this << address);
-    auto stateIt = m_states.find(address);
+    return m_stationEntries[LookupStationIndex(address)].state;
+}
+
+std::optional<std::size_t>
+WifiRemoteStationManager::FindStationIndex(const Mac48Address& address) const
+{
+    if (m_lastLookup && m_lastLookup->first == address)
+    {
+        return m_lastLookup->second;
+    }
+
+    auto indexIt = m_stationIndices.find(address);
 
-    if (stateIt != m_states.end())
+    if (indexIt == m_stationIndices.end())
+    {
+        return std::nullopt;
+    }
+
+    m_lastLookup = *indexIt;
+    return indexIt->second;
+}
+
+std::size_t
+WifiRemoteStationManager::LookupStationIndex(const Mac48Address& address) const
+{
+    NS_LOG_FUNCTION(this << address);
+
+    if (auto index = FindStationIndex(address))
     {
         NS_LOG_DEBUG("WifiRemoteStationManager::LookupState returning existing state");
-        return stateIt->second;
+        return *index;
     }
 
     auto state = std::make_shared<WifiRemoteStationState>();
@@ -1444,27 +1470,38 @@ WifiRemoteStationManager::LookupState(Mac48Address address) const
     state->m_aggregation = false;
     state->m_qosSupported = false;
     state->m_isInPsMode = false;
-    const_cast<WifiRemoteStationManager*>(this)->m_states.insert({address, state});
     NS_LOG_DEBUG("WifiRemoteStationManager::LookupState returning new state");
-    return state;
+    return const_cast<WifiRemoteStationManager*>(this)->AddStationEntry(address, state);
+}
+
+std::size_t
+WifiRemoteStationManager::AddStationEntry(const Mac48Address& address,
+                                          std::shared_ptr<WifiRemoteStationState> state)
+{
+    NS_LOG_FUNCTION(this << address);
+    auto [indexIt, inserted] = m_stationIndices.emplace(address, m_stationEntries.size());
+
+    if (inserted)
+    {
+        m_stationEntries.push_back({std::move(state), nullptr});
+    }
+    return indexIt->second;
 }
 
 WifiRemoteStation*
 WifiRemoteStationManager::Lookup(Mac48Address address) const
 {
     NS_LOG_FUNCTION(this << address);
-    auto stationIt = m_stations.find(address);
+    auto& entry =
+        const_cast<WifiRemoteStationManager*>(this)->m_stationEntries[LookupStationIndex(address)];
 
-    if (stationIt != m_stations.end())
+    if (!entry.station)
     {
-        return stationIt->second;
+        entry.station = DoCreateStation();
+        entry.station->m_state = entry.state.get();
+        entry.station->m_rssiAndUpdateTimePair = std::make_pair(0, Seconds(0));
     }
-
-    WifiRemoteStation* station = DoCreateStation();
-    station->m_state = LookupState(address).get();
-    station->m_rssiAndUpdateTimePair = std::make_pair(0, Seconds(0));
-    const_cast<WifiRemoteStationManager*>(this)->m_stations.insert({address, station});
-    return station;
+    return entry.station;
 }
 
 void
@@ -1621,9 +1658,8 @@ WifiRemoteStationManager::AddStationMleCommonInfo(
     NS_LOG_FUNCTION(this << from);
     auto state = LookupState(from);
     state->m_mleCommonInfo = mleCommonInfo;
-    // insert another entry in m_states indexed by the MLD address and pointing to the same state
-    const_cast<WifiRemoteStationManager*>(this)->m_states.insert(
-        {mleCommonInfo->m_mldMacAddress, state});
+    // add another entry for the MLD address sharing the same state
+    AddStationEntry(mleCommonInfo->m_mldMacAddress, state);
 }
 
 Ptr<const HtCapabilities>
@@ -1735,12 +1771,13 @@ void
 WifiRemoteStationManager::Reset()
 {
     NS_LOG_FUNCTION(this);
-    m_states.clear();
-    for (auto& state : m_stations)
+    for (auto& entry : m_stationEntries)
     {
-        delete (state.second);
+        delete entry.station;
     }
-    m_stations.clear();
+    m_stationEntries.clear();
+    m_stationIndices.clear();
+    m_lastLookup.reset();
     m_bssBasicRateSet.clear();
     m_bssBasicMcsSet.clear();
     m_ssrc.fill(0);
@@ -2171,9 +2208,9 @@ WifiRemoteStationManager::GetEmlsrSupported(const Mac48Address& address) const
 bool
 WifiRemoteStationManager::GetEmlsrEnabled(const Mac48Address& address) const
 {
-    if (auto stateIt = m_states.find(address); stateIt != m_states.cend())
+    if (auto index = FindStationIndex(address))
     {
-        return stateIt->second->m_emlsrEnabled;
+        return m_stationEntries[*index].state->m_emlsrEnabled;
     }
     return false;
 }
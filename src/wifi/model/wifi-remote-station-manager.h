@@ -39,6 +39,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -153,14 +154,19 @@ class WifiRemoteStationManager : public Object
     };
 
     /**
-     * A map of WifiRemoteStations with Mac48Address as key
+     * The state of a known station and the information for that station (which is
+     * created the first time the station is looked up)
      */
-    using Stations = std::unordered_map<Mac48Address, WifiRemoteStation*, WifiAddressHash>;
+    struct StationEntry
+    {
+        std::shared_ptr<WifiRemoteStationState> state; //!< state of the station
+        WifiRemoteStation* station{nullptr};           //!< information for the station
+    };
+
     /**
-     * A map of WifiRemoteStationStates with Mac48Address as key
+     * A map of indices in the vector of station entries with Mac48Address as key
      */
-    using StationStates =
-        std::unordered_map<Mac48Address, std::shared_ptr<WifiRemoteStationState>, WifiAddressHash>;
+    using StationIndices = std::unordered_map<Mac48Address, std::size_t, WifiAddressHash>;
 
     /**
      * Set up PHY associated with this device since it is the object that
@@ -1428,6 +1434,32 @@ class WifiRemoteStationManager : public Object
      * \return WifiRemoteStationState corresponding to the address
      */
     std::shared_ptr<WifiRemoteStationState> LookupState(Mac48Address address) const;
+    /**
+     * Return the index of the entry of the station associated with the given address,
+     * if such an entry exists.
+     *
+     * \param address the address of the station
+     * \return the index of the entry of the station, if any
+     */
+    std::optional<std::size_t> FindStationIndex(const Mac48Address& address) const;
+    /**
+     * Return the index of the entry of the station associated with the given address.
+     * An entry (with a new state) is created if the station is not known yet.
+     *
+     * \param address the address of the station
+     * \return the index of the entry of the station
+     */
+    std::size_t LookupStationIndex(const Mac48Address& address) const;
+    /**
+     * Add an entry for the station associated with the given address, unless such an
+     * entry exists already.
+     *
+     * \param address the address of the station
+     * \param state the state of the station
+     * \return the index of the entry of the station
+     */
+    std::size_t AddStationEntry(const Mac48Address& address,
+                                std::shared_ptr<WifiRemoteStationState> state);
     /**
      * Return the station associated with the given address.
      *
@@ -1488,8 +1520,18 @@ class WifiRemoteStationManager : public Object
     WifiModeList m_bssBasicRateSet; //!< basic rate set
     WifiModeList m_bssBasicMcsSet;  //!< basic MCS set
 
-    StationStates m_states; //!< States of known stations
-    Stations m_stations;    //!< Information for each known stations
+    /**
+     * The entries of the known stations are stored in a vector and never removed
+     * (until Reset() is called), hence an entry can be accessed by index. Each address
+     * of a known station (i.e., the link address and, for MLDs, the MLD address) is
+     * mapped to the index of an entry. Entries for distinct addresses of the same
+     * MLD share the same state.
+     */
+    std::vector<StationEntry> m_stationEntries; //!< entries of the known stations
+    StationIndices m_stationIndices;            //!< index of the entry of each known address
+    /// the address and the index of the entry of the last looked up station (the same
+    /// station is usually looked up several times in a row during a frame exchange)
+    mutable std::optional<std::pair<Mac48Address, std::size_t>> m_lastLookup;
 
     WifiMode m_defaultTxMode; //!< The default transmission mode
     WifiMode m_defaultTxMcs;  //!< The default transmission modulation-coding scheme (MCS)
@@ -21,6 +21,7 @@
 #ifndef WIFI_SPECTRUM_SIGNAL_PARAMETERS_H
 #define WIFI_SPECTRUM_SIGNAL_PARAMETERS_H
 
+#include "ns3/pool-allocator.h"
 #include "ns3/spectrum-signal-parameters.h"
 
 namespace ns3
@@ -31,9 +32,10 @@ class WifiPpdu;
 /**
  * \ingroup wifi
  *
- * Signal parameters for wifi
+ * Signal parameters for wifi. Since the spectrum channel makes a copy of the
+ * signal parameters for every receiver, they are allocated through the PoolAllocator.
  */
-struct WifiSpectrumSignalParameters : public SpectrumSignalParameters
+struct WifiSpectrumSignalParameters : public SpectrumSignalParameters, public PoolAllocated
 {
     Ptr<SpectrumSignalParameters> Copy() const override;
 
@@ -49,7 +49,6 @@ WifiTxVector::WifiTxVector()
       m_triggerResponding(false),
       m_modeInitialized(false),
       m_inactiveSubchannels(),
-      m_ruAllocation(),
       m_center26ToneRuIndication(std::nullopt),
       m_ehtPpduType(1) // SU transmission by default
 {
@@ -85,7 +84,6 @@ WifiTxVector::WifiTxVector(WifiMode mode,
       m_triggerResponding(triggerResponding),
       m_modeInitialized(true),
       m_inactiveSubchannels(),
-      m_ruAllocation(),
       m_center26ToneRuIndication(std::nullopt),
       m_ehtPpduType(1) // SU transmission by default
 {
@@ -107,25 +105,17 @@ WifiTxVector::WifiTxVector(const WifiTxVector& txVector)
       m_length(txVector.m_length),
       m_triggerResponding(txVector.m_triggerResponding),
       m_modeInitialized(txVector.m_modeInitialized),
+      m_muUserInfos(txVector.m_muUserInfos),
       m_inactiveSubchannels(txVector.m_inactiveSubchannels),
       m_sigBMcs(txVector.m_sigBMcs),
       m_ruAllocation(txVector.m_ruAllocation),
       m_center26ToneRuIndication(txVector.m_center26ToneRuIndication),
       m_ehtPpduType(txVector.m_ehtPpduType)
 {
-    m_muUserInfos.clear();
-    if (!txVector.m_muUserInfos.empty()) // avoids crashing for loop
-    {
-        for (auto& info : txVector.m_muUserInfos)
-        {
-            m_muUserInfos.insert(std::make_pair(info.first, info.second));
-        }
-    }
 }
 
 WifiTxVector::~WifiTxVector()
 {
-    m_muUserInfos.clear();
 }
 
 bool
@@ -146,8 +136,8 @@ WifiTxVector::GetMode(uint16_t staId) const
         return m_mode;
     }
     NS_ABORT_MSG_IF(staId > 2048, "STA-ID should be correctly set for MU (" << staId << ")");
-    const auto userInfoIt = m_muUserInfos.find(staId);
-    NS_ASSERT(userInfoIt != m_muUserInfos.cend());
+    const auto userInfoIt = GetMuUserInfos().find(staId);
+    NS_ASSERT(userInfoIt != GetMuUserInfos().cend());
     switch (GetModulationClassForPreamble(m_preamble))
     {
     case WIFI_MOD_CLASS_EHT:
@@ -167,7 +157,7 @@ WifiTxVector::GetModulationClass() const
 
     if (IsMu())
     {
-        NS_ASSERT(!m_muUserInfos.empty());
+        NS_ASSERT(!GetMuUserInfos().empty());
         // all the modes belong to the same modulation class
         return GetModulationClassForPreamble(m_preamble);
     }
@@ -210,8 +200,8 @@ WifiTxVector::GetNss(uint16_t staId) const
     if (IsMu())
     {
         NS_ABORT_MSG_IF(staId > 2048, "STA-ID should be correctly set for MU (" << staId << ")");
-        NS_ASSERT(m_muUserInfos.find(staId) != m_muUserInfos.end());
-        return m_muUserInfos.at(staId).nss;
+        NS_ASSERT(GetMuUserInfos().find(staId) != GetMuUserInfos().end());
+        return GetMuUserInfos().at(staId).nss;
     }
     return m_nss;
 }
@@ -223,7 +213,7 @@ WifiTxVector::GetNssMax() const
     uint8_t nss = 0;
     if (IsMu())
     {
-        for (const auto& info : m_muUserInfos)
+        for (const auto& info : GetMuUserInfos())
         {
             nss = (nss < info.second.nss) ? info.second.nss : nss;
         }
@@ -243,8 +233,8 @@ WifiTxVector::GetNssTotal() const
     if (IsMu())
     {
         nss = std::accumulate(
-            m_muUserInfos.cbegin(),
-            m_muUserInfos.cend(),
+            GetMuUserInfos().cbegin(),
+            GetMuUserInfos().cend(),
             0,
             [](uint8_t prevNss, const auto& info) { return prevNss + info.second.nss; });
     }
@@ -297,7 +287,7 @@ WifiTxVector::SetMode(WifiMode mode, uint16_t staId)
 {
     NS_ABORT_MSG_IF(!IsMu(), "Not a MU transmission");
     NS_ABORT_MSG_IF(staId > 2048, "STA-ID should be correctly set for MU");
-    m_muUserInfos[staId].mcs = mode.GetMcsValue();
+    GetMuUserInfosForWrite()[staId].mcs = mode.GetMcsValue();
     m_modeInitialized = true;
 }
 
@@ -342,7 +332,7 @@ WifiTxVector::SetNss(uint8_t nss, uint16_t staId)
 {
     NS_ABORT_MSG_IF(!IsMu(), "Not a MU transmission");
     NS_ABORT_MSG_IF(staId > 2048, "STA-ID should be correctly set for MU");
-    m_muUserInfos[staId].nss = nss;
+    GetMuUserInfosForWrite()[staId].nss = nss;
 }
 
 void
@@ -420,21 +410,26 @@ WifiTxVector::GetSigBMode() const
 void
 WifiTxVector::SetRuAllocation(const RuAllocation& ruAlloc, uint8_t p20Index)
 {
-    if (ns3::IsDlMu(m_preamble) && !m_muUserInfos.empty())
+    if (ns3::IsDlMu(m_preamble) && !GetMuUserInfos().empty())
     {
         NS_ASSERT(ruAlloc == DeriveRuAllocation(p20Index));
     }
-    m_ruAllocation = ruAlloc;
+    m_ruAllocation = std::make_shared<const RuAllocation>(ruAlloc);
 }
 
 const RuAllocation&
 WifiTxVector::GetRuAllocation(uint8_t p20Index) const
 {
-    if (ns3::IsDlMu(m_preamble) && m_ruAllocation.empty())
+    if (ns3::IsDlMu(m_preamble) && (!m_ruAllocation || m_ruAllocation->empty()))
     {
-        m_ruAllocation = DeriveRuAllocation(p20Index);
+        m_ruAllocation = std::make_shared<const RuAllocation>(DeriveRuAllocation(p20Index));
     }
-    return m_ruAllocation;
+    if (!m_ruAllocation)
+    {
+        static const RuAllocation emptyRuAllocation;
+        return emptyRuAllocation;
+    }
+    return *m_ruAllocation;
 }
 
 void
@@ -495,7 +490,7 @@ WifiTxVector::IsValid() const
             }
         }
     }
-    for (const auto& userInfo : m_muUserInfos)
+    for (const auto& userInfo : GetMuUserInfos())
     {
         if (GetNumStasInRu(userInfo.second.ru) > 8)
         {
@@ -503,7 +498,7 @@ WifiTxVector::IsValid() const
         }
     }
     std::map<HeRu::RuSpec, uint8_t> streamsPerRu{};
-    for (const auto& info : m_muUserInfos)
+    for (const auto& info : GetMuUserInfos())
     {
         auto it = streamsPerRu.find(info.second.ru);
         if (it == streamsPerRu.end())
@@ -554,12 +549,12 @@ WifiTxVector::IsDlOfdma() const
     {
         return m_ehtPpduType == 0;
     }
-    if (m_muUserInfos.size() == 1)
+    if (GetMuUserInfos().size() == 1)
     {
         return true;
     }
     std::set<HeRu::RuSpec> rus{};
-    for (const auto& userInfo : m_muUserInfos)
+    for (const auto& userInfo : GetMuUserInfos())
     {
         rus.insert(userInfo.second.ru);
         if (rus.size() > 1)
@@ -581,7 +576,7 @@ WifiTxVector::IsDlMuMimo() const
     {
         return m_ehtPpduType == 2;
     }
-    if (m_muUserInfos.size() < 2)
+    if (GetMuUserInfos().size() < 2)
     {
         return false;
     }
@@ -592,15 +587,15 @@ WifiTxVector::IsDlMuMimo() const
 uint8_t
 WifiTxVector::GetNumStasInRu(const HeRu::RuSpec& ru) const
 {
-    return std::count_if(m_muUserInfos.cbegin(),
-                         m_muUserInfos.cend(),
+    return std::count_if(GetMuUserInfos().cbegin(),
+                         GetMuUserInfos().cend(),
                          [&ru](const auto& info) -> bool { return (ru == info.second.ru); });
 }
 
 bool
 WifiTxVector::IsAllocated(uint16_t staId) const
 {
-    return m_muUserInfos.count(staId) > 0;
+    return GetMuUserInfos().count(staId) > 0;
 }
 
 HeRu::RuSpec
@@ -608,7 +603,7 @@ WifiTxVector::GetRu(uint16_t staId) const
 {
     NS_ABORT_MSG_IF(!IsMu(), "RU only available for MU");
     NS_ABORT_MSG_IF(staId > 2048, "STA-ID should be correctly set for MU");
-    return m_muUserInfos.at(staId).ru;
+    return GetMuUserInfos().at(staId).ru;
 }
 
 void
@@ -616,14 +611,14 @@ WifiTxVector::SetRu(HeRu::RuSpec ru, uint16_t staId)
 {
     NS_ABORT_MSG_IF(!IsMu(), "RU only available for MU");
     NS_ABORT_MSG_IF(staId > 2048, "STA-ID should be correctly set for MU");
-    m_muUserInfos[staId].ru = ru;
+    GetMuUserInfosForWrite()[staId].ru = ru;
 }
 
 HeMuUserInfo
 WifiTxVector::GetHeMuUserInfo(uint16_t staId) const
 {
     NS_ABORT_MSG_IF(!IsMu(), "HE MU user info only available for MU");
-    return m_muUserInfos.at(staId);
+    return GetMuUserInfos().at(staId);
 }
 
 void
@@ -631,24 +626,46 @@ WifiTxVector::SetHeMuUserInfo(uint16_t staId, HeMuUserInfo userInfo)
 {
     NS_ABORT_MSG_IF(!IsMu(), "HE MU user info only available for MU");
     NS_ABORT_MSG_IF(staId > 2048, "STA-ID should be correctly set for MU");
-    m_muUserInfos[staId] = userInfo;
+    GetMuUserInfosForWrite()[staId] = userInfo;
     m_modeInitialized = true;
-    m_ruAllocation.clear();
+    m_ruAllocation.reset();
+}
+
+const WifiTxVector::HeMuUserInfoMap&
+WifiTxVector::GetMuUserInfos() const
+{
+    static const HeMuUserInfoMap emptyMuUserInfos;
+    return m_muUserInfos ? *m_muUserInfos : emptyMuUserInfos;
+}
+
+WifiTxVector::HeMuUserInfoMap&
+WifiTxVector::GetMuUserInfosForWrite()
+{
+    if (!m_muUserInfos)
+    {
+        m_muUserInfos = std::make_shared<HeMuUserInfoMap>();
+    }
+    else if (m_muUserInfos.use_count() > 1)
+    {
+        // the map is shared with other copies of this TXVECTOR
+        m_muUserInfos = std::make_shared<HeMuUserInfoMap>(*m_muUserInfos);
+    }
+    return *m_muUserInfos;
 }
 
 const WifiTxVector::HeMuUserInfoMap&
 WifiTxVector::GetHeMuUserInfoMap() const
 {
     NS_ABORT_MSG_IF(!IsMu(), "HE MU user info map only available for MU");
-    return m_muUserInfos;
+    return GetMuUserInfos();
 }
 
 WifiTxVector::HeMuUserInfoMap&
 WifiTxVector::GetHeMuUserInfoMap()
 {
     NS_ABORT_MSG_IF(!IsMu(), "HE MU user info map only available for MU");
-    m_ruAllocation.clear();
-    return m_muUserInfos;
+    m_ruAllocation.reset();
+    return GetMuUserInfosForWrite();
 }
 
 bool
@@ -729,7 +746,7 @@ operator<<(std::ostream& os, const WifiTxVector& v)
     }
     if (v.IsMu())
     {
-        WifiTxVector::HeMuUserInfoMap userInfoMap = v.GetHeMuUserInfoMap();
+        const auto& userInfoMap = v.GetHeMuUserInfoMap();
         os << " num User Infos: " << userInfoMap.size();
         for (auto& ui : userInfoMap)
         {
@@ -773,7 +790,7 @@ WifiTxVector::GetUserInfoMapOrderedByRus(uint8_t p20Index) const
 {
     auto heRuComparator = HeRu::RuSpecCompare(m_channelWidth, p20Index);
     UserInfoMapOrderedByRus orderedMap{heRuComparator};
-    for (const auto& userInfo : m_muUserInfos)
+    for (const auto& userInfo : GetMuUserInfos())
     {
         const auto ru = userInfo.second.ru;
         if (auto it = orderedMap.find(ru); it != orderedMap.end())
@@ -857,7 +874,7 @@ Center26ToneRuIndication
 WifiTxVector::DeriveCenter26ToneRuIndication() const
 {
     uint8_t center26ToneRuIndication{0};
-    for (const auto& userInfo : m_muUserInfos)
+    for (const auto& userInfo : GetMuUserInfos())
     {
         if ((userInfo.second.ru.GetRuType() == HeRu::RU_26_TONE) &&
             (userInfo.second.ru.GetIndex() == 19))
@@ -27,6 +27,7 @@
 #include "ns3/he-ru.h"
 
 #include <list>
+#include <memory>
 #include <optional>
 #include <set>
 #include <vector>
@@ -555,6 +556,19 @@ class WifiTxVector
      */
     uint8_t GetNumStasInRu(const HeRu::RuSpec& ru) const;
 
+    /**
+     * \return a const reference to the map of HE MU user-specific information, which
+     *         is empty if no user-specific information has been set
+     */
+    const HeMuUserInfoMap& GetMuUserInfos() const;
+    /**
+     * Get a reference to the map of HE MU user-specific information that can be
+     * modified. The map is copied first if it is shared with other TXVECTORs.
+     *
+     * \return a reference to the map of HE MU user-specific information
+     */
+    HeMuUserInfoMap& GetMuUserInfosForWrite();
+
     WifiMode m_mode;          /**< The DATARATE parameter in Table 15-4.
                               It is the value that will be passed
                               to PMD_RATE.request */
@@ -577,17 +591,20 @@ class WifiTxVector
     bool m_modeInitialized; /**< Internal initialization flag */
 
     // MU information
-    HeMuUserInfoMap m_muUserInfos; /**< HE MU specific per-user information
-                                        indexed by station ID (STA-ID) corresponding
-                                        to the 11 LSBs of the AID of the recipient STA
-                                        This list shall be used only for HE MU */
+    std::shared_ptr<HeMuUserInfoMap>
+        m_muUserInfos; /**< HE MU specific per-user information indexed by station ID
+                            (STA-ID) corresponding to the 11 LSBs of the AID of the
+                            recipient STA. This list shall be used only for HE MU. The
+                            map is shared among copies of this TXVECTOR until one of
+                            them modifies it (copy-on-write) */
     std::vector<bool>
         m_inactiveSubchannels; /**< Bitmap of inactive subchannels used for preamble puncturing */
 
     WifiMode m_sigBMcs; /**< MCS_SIG_B per Table 27-1 IEEE 802.11ax-2021 */
 
-    mutable RuAllocation m_ruAllocation; /**< RU allocations that are going to be carried
-                                              in SIG-B common field per Table 27-1 IEEE */
+    mutable std::shared_ptr<const RuAllocation>
+        m_ruAllocation; /**< RU allocations that are going to be carried in SIG-B common
+                             field per Table 27-1 IEEE (shared among copies of this TXVECTOR) */
 
     mutable std::optional<Center26ToneRuIndication>
         m_center26ToneRuIndication; /**< CENTER_26_TONE_RU field when format is HE_MU and
@@ -25,6 +25,7 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -33,6 +34,8 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 
+#include <map>
+
 namespace ns3
 {
 
@@ -57,11 +60,19 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("BatchedDelivery",
+                          "If true, a single event is scheduled to deliver a PPDU to all the "
+                          "receivers having the same propagation delay, instead of one event "
+                          "per receiver.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&YansWifiChannel::m_batchedDelivery),
+                          MakeBooleanChecker());
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_batchedDelivery(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -92,6 +103,7 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
     NS_LOG_FUNCTION(this << sender << ppdu << txPowerDbm);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
+    std::map<Time, BatchedReceivers> batches;
     for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
     {
         if (sender != (*i))
@@ -120,6 +132,12 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
                 dstNode = dstNetDevice->GetNode()->GetId();
             }
 
+            if (m_batchedDelivery)
+            {
+                batches[delay].push_back({*i, dstNode, rxPowerDbm});
+                continue;
+            }
+
             Simulator::ScheduleWithContext(dstNode,
                                            delay,
                                            &YansWifiChannel::Receive,
@@ -128,6 +146,31 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
                                            rxPowerDbm);
         }
     }
+
+    // all the events scheduled above share the same timestamp within a batch and
+    // have consecutive UIDs, hence processing a batch in a single event preserves
+    // the order in which receivers are notified
+    for (auto& [delay, receivers] : batches)
+    {
+        Simulator::ScheduleWithContext(receivers.front().context,
+                                       delay,
+                                       &YansWifiChannel::ReceiveBatch,
+                                       ppdu,
+                                       std::move(receivers));
+    }
+}
+
+void
+YansWifiChannel::ReceiveBatch(Ptr<const WifiPpdu> ppdu, const BatchedReceivers& receivers)
+{
+    NS_LOG_FUNCTION(ppdu << receivers.size());
+    const auto context = Simulator::GetContext();
+    for (const auto& receiver : receivers)
+    {
+        Simulator::SetContext(receiver.context);
+        Receive(receiver.phy, ppdu, receiver.rxPowerDbm);
+    }
+    Simulator::SetContext(context);
 }
 
 void
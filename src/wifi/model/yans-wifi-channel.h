@@ -22,6 +22,8 @@
 
 #include "ns3/channel.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -41,6 +43,13 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * By default, the channel schedules one event per receiving PHY for every
+ * transmitted PPDU. If the BatchedDelivery attribute is set, the receiving
+ * PHYs are grouped by propagation delay and a single event is scheduled for
+ * each group, which then hands the PPDU to all the PHYs in the group (after
+ * switching to the context of their node). Events are still processed in the
+ * same order, hence results are identical to those obtained without batching.
  */
 class YansWifiChannel : public Channel
 {
@@ -113,9 +122,33 @@ class YansWifiChannel : public Channel
      */
     static void Receive(Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, double txPowerDbm);
 
+    /**
+     * Information about a PHY receiving a PPDU in batched delivery mode
+     */
+    struct BatchedReceiver
+    {
+        Ptr<YansWifiPhy> phy; //!< the receiving PHY
+        uint32_t context;     //!< the context (node ID) of the receiving PHY
+        double rxPowerDbm;    //!< the received power (dBm)
+    };
+
+    /// List of PHYs receiving a PPDU after the same propagation delay
+    using BatchedReceivers = std::vector<BatchedReceiver>;
+
+    /**
+     * This method is scheduled by Send for each distinct propagation delay when
+     * batched delivery is enabled. It calls Receive for each of the given PHYs,
+     * in the context of the node the PHY belongs to.
+     *
+     * \param ppdu the PPDU being sent
+     * \param receivers the PHYs receiving the PPDU
+     */
+    static void ReceiveBatch(Ptr<const WifiPpdu> ppdu, const BatchedReceivers& receivers);
+
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    bool m_batchedDelivery; //!< whether receivers with the same delay share a single event
 };
 
 } // namespace ns3
@@ -18,6 +18,7 @@
  */
 
 #include "ns3/ap-wifi-mac.h"
+#include "ns3/block-ack-window.h"
 #include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/ctrl-headers.h"
@@ -40,6 +41,7 @@
 #include "ns3/wifi-net-device.h"
 #include "ns3/yans-wifi-helper.h"
 
+#include <algorithm>
 #include <list>
 
 using namespace ns3;
@@ -666,6 +668,78 @@ OriginatorBlockAckWindowTest::DoRun()
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test for the search functions of a large block ack window
+ */
+class BlockAckWindowSearchTest : public TestCase
+{
+  public:
+    BlockAckWindowSearchTest();
+
+  private:
+    void DoRun() override;
+};
+
+BlockAckWindowSearchTest::BlockAckWindowSearchTest()
+    : TestCase("Check the search functions of a large block ack window")
+{
+}
+
+void
+BlockAckWindowSearchTest::DoRun()
+{
+    const uint16_t winSize = 1000; // not a multiple of the size of a word of the bitmap
+    BlockAckWindow window;
+    window.Init(4000, winSize);
+
+    NS_TEST_EXPECT_MSG_EQ(window.FindNextSet(0), winSize, "Unexpected set element");
+    NS_TEST_EXPECT_MSG_EQ(window.FindNextUnset(0), 0, "Unexpected unset element");
+
+    // move the head close to the end of the bitmap, so that the window wraps around
+    window.Advance(990);
+    NS_TEST_EXPECT_MSG_EQ(window.GetWinStart(), (4000 + 990) % SEQNO_SPACE_SIZE, "Bad winStart");
+
+    const std::vector<std::size_t> set{3, 9, 10, 63, 64, 500, 999};
+    for (auto distance : set)
+    {
+        window.Set(distance);
+    }
+    // all the elements preceding the given ones are set, too
+    for (std::size_t distance = 0; distance < 3; distance++)
+    {
+        window.Set(distance);
+    }
+
+    std::vector<std::size_t> found;
+    for (auto i = window.FindNextSet(0); i < winSize; i = window.FindNextSet(i + 1))
+    {
+        found.push_back(i);
+    }
+    std::vector<std::size_t> expected{0, 1, 2, 3, 9, 10, 63, 64, 500, 999};
+    NS_TEST_EXPECT_MSG_EQ((found == expected), true, "Unexpected set elements");
+    for (std::size_t distance = 0; distance < winSize; distance++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(window.At(distance),
+                              (std::find(expected.cbegin(), expected.cend(), distance) !=
+                               expected.cend()),
+                              "Unexpected value for element at distance " << distance);
+    }
+    NS_TEST_EXPECT_MSG_EQ(window.FindNextUnset(0), 4, "Unexpected first unset element");
+    NS_TEST_EXPECT_MSG_EQ(window.FindNextUnset(9), 11, "Unexpected unset element after 9");
+
+    // advance the window across the word boundaries; the elements that become part of
+    // the tail of the window must be cleared
+    window.Advance(64);
+    NS_TEST_EXPECT_MSG_EQ(window.FindNextSet(0), 0, "Element at distance 64 not shifted");
+    NS_TEST_EXPECT_MSG_EQ(window.FindNextSet(1), 436, "Element at distance 500 not shifted");
+    NS_TEST_EXPECT_MSG_EQ(window.FindNextSet(437), 935, "Element at distance 999 not shifted");
+    NS_TEST_EXPECT_MSG_EQ(window.FindNextSet(936), winSize, "Tail of the window not cleared");
+    NS_TEST_EXPECT_MSG_EQ(window.FindNextUnset(0), 1, "Unexpected first unset element");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -2023,6 +2097,7 @@ BlockAckTestSuite::BlockAckTestSuite()
     AddTestCase(new PacketBufferingCaseA, TestCase::QUICK);
     AddTestCase(new PacketBufferingCaseB, TestCase::QUICK);
     AddTestCase(new OriginatorBlockAckWindowTest, TestCase::QUICK);
+    AddTestCase(new BlockAckWindowSearchTest, TestCase::QUICK);
     AddTestCase(new CtrlBAckResponseHeaderTest, TestCase::QUICK);
     AddTestCase(new BlockAckRecipientBufferTest(0), TestCase::QUICK);
     AddTestCase(new BlockAckRecipientBufferTest(4090), TestCase::QUICK);
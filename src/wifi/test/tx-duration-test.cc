@@ -32,6 +32,7 @@
 
 #include <list>
 #include <numeric>
+#include <utility>
 
 using namespace ns3;
 
@@ -1433,6 +1434,24 @@ HeSigBDurationTest::DoRun()
     NS_TEST_EXPECT_MSG_EQ(hePhy->GetDuration(WIFI_PPDU_FIELD_SIG_B, txVector),
                           m_expectedSigBDuration,
                           "Incorrect duration for HE-SIG-B");
+
+    // Verify that copies of the TXVECTOR share the per-user information until modified
+    auto txVectorCopy = txVector;
+    NS_TEST_EXPECT_MSG_EQ(&std::as_const(txVectorCopy).GetHeMuUserInfoMap(),
+                          &txVector.GetHeMuUserInfoMap(),
+                          "The copy of the TXVECTOR should share the per-user information");
+    auto userInfo = txVector.GetHeMuUserInfo(1);
+    userInfo.mcs = (userInfo.mcs + 1) % 12;
+    txVectorCopy.SetHeMuUserInfo(1, userInfo);
+    NS_TEST_EXPECT_MSG_EQ(+txVectorCopy.GetHeMuUserInfo(1).mcs,
+                          +userInfo.mcs,
+                          "Incorrect MCS in the modified copy of the TXVECTOR");
+    NS_TEST_EXPECT_MSG_EQ(+txVector.GetHeMuUserInfo(1).mcs,
+                          +m_userInfos.front().mcs,
+                          "Modifying a copy of the TXVECTOR altered the original TXVECTOR");
+    NS_TEST_EXPECT_MSG_EQ((txVector.GetRuAllocation(0) == m_expectedRuAllocation),
+                          true,
+                          "Modifying a copy of the TXVECTOR altered the RU_ALLOCATION");
 }
 
 /**
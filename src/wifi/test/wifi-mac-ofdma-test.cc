@@ -21,6 +21,7 @@
 #include "ns3/he-configuration.h"
 #include "ns3/he-frame-exchange-manager.h"
 #include "ns3/he-phy.h"
+#include "ns3/heap-multi-user-scheduler.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/multi-model-spectrum-channel.h"
 #include "ns3/multi-user-scheduler.h"
@@ -28,6 +29,7 @@
 #include "ns3/packet-socket-helper.h"
 #include "ns3/packet-socket-server.h"
 #include "ns3/packet.h"
+#include "ns3/pf-multi-user-scheduler.h"
 #include "ns3/qos-utils.h"
 #include "ns3/rng-seed-manager.h"
 #include "ns3/spectrum-wifi-helper.h"
@@ -41,6 +43,7 @@
 #include "ns3/wifi-psdu.h"
 
 #include <iomanip>
+#include <set>
 
 using namespace ns3;
 
@@ -2270,6 +2273,493 @@ OfdmaAckSequenceTest::DoRun()
     Config::SetGlobal("RngRun", UintegerValue(previousRun));
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that a StationCreditQueue grants and charges credits like the per-station
+ * credit update performed by RrMultiUserScheduler and that stations are visited in
+ * decreasing order of credits.
+ */
+class StationCreditQueueTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param nStations the number of associated stations
+     * \param nTxops the number of TXOPs to schedule
+     */
+    StationCreditQueueTest(std::size_t nStations, std::size_t nTxops);
+    ~StationCreditQueueTest() override = default;
+
+  private:
+    void DoRun() override;
+
+    std::size_t m_nStations; //!< the number of associated stations
+    std::size_t m_nTxops;    //!< the number of TXOPs to schedule
+};
+
+StationCreditQueueTest::StationCreditQueueTest(std::size_t nStations, std::size_t nTxops)
+    : TestCase("Schedule " + std::to_string(nTxops) + " TXOPs among " +
+               std::to_string(nStations) + " stations by using a StationCreditQueue"),
+      m_nStations(nStations),
+      m_nTxops(nTxops)
+{
+}
+
+void
+StationCreditQueueTest::DoRun()
+{
+    const double maxCredits = 1e6; // 1 second, the default value of the MaxCredits attribute
+    const std::size_t nRus = 9;    // 26-tone RUs in a 20 MHz channel
+    const double txDuration = 1000;
+
+    StationCreditQueue queue;
+    queue.SetMaxCredits(maxCredits);
+    std::vector<double> credits(m_nStations + 1, 0); // indexed by AID
+
+    for (uint16_t aid = 1; aid <= m_nStations; aid++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(queue.Add(aid, Mac48Address::Allocate()),
+                              true,
+                              "Station " << aid << " not added");
+    }
+    NS_TEST_EXPECT_MSG_EQ(queue.Add(1, Mac48Address::Allocate()),
+                          false,
+                          "A station must not be added twice");
+    NS_TEST_ASSERT_MSG_EQ(queue.GetSize(), m_nStations, "Unexpected number of stations");
+
+    std::vector<uint16_t> selected;
+
+    for (std::size_t txop = 0; txop < m_nTxops; txop++)
+    {
+        // select the stations with the largest amount of credits, skipping the stations
+        // for which the AP is assumed to have no frame to transmit
+        selected.clear();
+        for (auto it = queue.begin(); it != queue.end() && selected.size() < nRus; ++it)
+        {
+            if ((it->aid + txop) % 5 != 0)
+            {
+                selected.push_back(it->aid);
+            }
+        }
+
+        queue.AddCreditsToAll(txDuration / m_nStations);
+        for (auto aid : selected)
+        {
+            queue.Debit(aid, txDuration / nRus);
+        }
+
+        // update credits as done by RrMultiUserScheduler
+        for (auto& staCredits : credits)
+        {
+            staCredits = std::min(staCredits + txDuration / m_nStations, maxCredits);
+        }
+        for (auto aid : selected)
+        {
+            credits[aid] -= txDuration / nRus;
+        }
+    }
+
+    double prevCredits = maxCredits;
+    for (auto it = queue.begin(); it != queue.end(); ++it)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(queue.GetCredits(it),
+                                  credits[it->aid],
+                                  1e-3,
+                                  "Unexpected amount of credits for station " << it->aid);
+        NS_TEST_EXPECT_MSG_EQ((queue.GetCredits(it) <= prevCredits),
+                              true,
+                              "Stations not visited in decreasing order of credits");
+        prevCredits = queue.GetCredits(it);
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(queue.Remove(1), true, "Station 1 not removed");
+    NS_TEST_EXPECT_MSG_EQ(queue.Remove(1), false, "Station 1 removed twice");
+    NS_TEST_EXPECT_MSG_EQ(queue.GetSize(), m_nStations - 1, "Unexpected number of stations");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the max-weight matching and the assignment of RUs of different sizes
+ * performed by the PfMultiUserScheduler.
+ */
+class PfRuAssignmentTest : public TestCase
+{
+  public:
+    PfRuAssignmentTest();
+    ~PfRuAssignmentTest() override = default;
+
+  private:
+    void DoRun() override;
+};
+
+PfRuAssignmentTest::PfRuAssignmentTest()
+    : TestCase("Check the RU assignment performed by the PfMultiUserScheduler")
+{
+}
+
+void
+PfRuAssignmentTest::DoRun()
+{
+    // square matrix: the diagonal maximizes the sum of the weights
+    auto matching = PfMultiUserScheduler::GetMaxWeightMatching({{1, 2, 3}, {2, 4, 6}, {3, 6, 9}});
+    NS_TEST_EXPECT_MSG_EQ((matching == std::vector<std::size_t>{0, 1, 2}),
+                          true,
+                          "Unexpected max-weight matching");
+
+    // more columns than rows
+    matching = PfMultiUserScheduler::GetMaxWeightMatching({{5, 1, 0}, {6, 0, 0}});
+    NS_TEST_EXPECT_MSG_EQ((matching == std::vector<std::size_t>{1, 0}),
+                          true,
+                          "Unexpected max-weight matching");
+
+    // a single station is assigned the whole channel
+    auto assignment = PfMultiUserScheduler::AssignRus(20, 1, 4, [](auto, const auto& ru) {
+        return 1.0 * HeRu::GetBandwidth(ru.GetRuType());
+    });
+    NS_TEST_ASSERT_MSG_EQ(assignment.size(), 1, "Expected a single RU");
+    NS_TEST_EXPECT_MSG_EQ(assignment[0].first.GetRuType(),
+                          HeRu::RU_242_TONE,
+                          "Expected a 242-tone RU");
+
+    // The rate of a station on an RU is proportional to the bandwidth of the RU and to the
+    // average spectral efficiency of the station on the 20 MHz subchannels overlapping the RU
+    auto makeUtility = [](uint16_t bw, std::vector<std::set<std::size_t>> goodSubchannels) {
+        return [=](std::size_t sta, const HeRu::RuSpec& ru) {
+            const auto& rus242 = HeRu::GetRusOfType(bw, HeRu::RU_242_TONE);
+            double se = 0;
+            std::size_t nSubchannels = 0;
+            for (std::size_t subchannel = 0; subchannel < rus242.size(); ++subchannel)
+            {
+                if (HeRu::DoesOverlap(bw, ru, {rus242[subchannel]}))
+                {
+                    se += (goodSubchannels[sta].count(subchannel) > 0 ? 5 : 0.1);
+                    ++nSubchannels;
+                }
+            }
+            return HeRu::GetBandwidth(ru.GetRuType()) * se / nSubchannels;
+        };
+    };
+
+    // the utility of a station with a better channel but few buffered bytes is capped by
+    // its backlog, hence the whole channel is assigned to the other station
+    assignment = PfMultiUserScheduler::AssignRus(20, 2, 4, [](auto sta, const auto& ru) {
+        const auto rate = HeRu::GetBandwidth(ru.GetRuType()) * (sta == 0 ? 5.0 : 1.0);
+        return (sta == 0 ? std::min(rate, 10.0) : rate);
+    });
+    NS_TEST_ASSERT_MSG_EQ(assignment.size(), 1, "Expected a single RU");
+    NS_TEST_EXPECT_MSG_EQ(assignment[0].second, 1, "Expected the backlogged station");
+    NS_TEST_EXPECT_MSG_EQ(assignment[0].first.GetRuType(),
+                          HeRu::RU_242_TONE,
+                          "Expected a 242-tone RU");
+
+    // two stations with a good channel on distinct 20 MHz subchannels of a 40 MHz channel
+    const auto& rus242 = HeRu::GetRusOfType(40, HeRu::RU_242_TONE);
+    assignment = PfMultiUserScheduler::AssignRus(40, 2, 4, makeUtility(40, {{0}, {1}}));
+    NS_TEST_ASSERT_MSG_EQ(assignment.size(), 2, "Expected two RUs");
+    for (const auto& [ru, sta] : assignment)
+    {
+        NS_TEST_EXPECT_MSG_EQ((ru == rus242[sta]),
+                              true,
+                              "Station " << sta << " not assigned its best 20 MHz subchannel");
+    }
+
+    // a station with a good channel on the first half of an 80 MHz channel and two stations
+    // with a good channel on distinct 20 MHz subchannels of the second half
+    const std::size_t nStations = 3;
+    assignment = PfMultiUserScheduler::AssignRus(80,
+                                                 nStations,
+                                                 nStations,
+                                                 makeUtility(80, {{0, 1}, {2}, {3}}));
+    NS_TEST_EXPECT_MSG_GT(assignment.size(), 1, "Expected RUs of different sizes");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(assignment.size(), nStations, "Too many RUs assigned");
+
+    WifiTxVector txVector;
+    txVector.SetPreambleType(WIFI_PREAMBLE_HE_MU);
+    txVector.SetChannelWidth(80);
+    std::set<std::size_t> stations;
+    for (auto it = assignment.cbegin(); it != assignment.cend(); ++it)
+    {
+        NS_TEST_EXPECT_MSG_EQ(stations.insert(it->second).second,
+                              true,
+                              "Station " << it->second << " assigned multiple RUs");
+        for (auto other = std::next(it); other != assignment.cend(); ++other)
+        {
+            NS_TEST_EXPECT_MSG_EQ(HeRu::DoesOverlap(80, it->first, {other->first}),
+                                  false,
+                                  "RUs " << it->first << " and " << other->first << " overlap");
+        }
+        txVector.SetHeMuUserInfo(it->second + 1, {it->first, 5, 1});
+    }
+    NS_TEST_EXPECT_MSG_EQ(txVector.GetRuAllocation(0).size(), 4, "Unexpected RU allocation");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that a multi-user scheduler deriving from RrMultiUserScheduler delivers all
+ * the DL and UL traffic of a number of HE stations by using DL MU PPDUs and HE TB PPDUs
+ * and that every station is served in a DL MU PPDU.
+ */
+class MultiUserSchedulerTxTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param schedulerType the TypeId name of the multi-user scheduler to test
+     * \param channelWidth the PHY channel bandwidth in MHz
+     */
+    MultiUserSchedulerTxTest(const std::string& schedulerType, uint16_t channelWidth);
+    ~MultiUserSchedulerTxTest() override = default;
+
+    /**
+     * Function to trace packets received by the server application
+     * \param dl whether the packet was received by a station (DL) or by the AP (UL)
+     * \param p the packet
+     * \param addr the address
+     */
+    void L7Receive(bool dl, Ptr<const Packet> p, const Address& addr);
+
+    /**
+     * Callback invoked when FrameExchangeManager passes PSDUs to the PHY
+     * \param context the context
+     * \param psduMap the PSDU map
+     * \param txVector the TX vector
+     * \param txPowerW the tx power in Watts
+     */
+    void Transmit(std::string context,
+                  WifiConstPsduMap psduMap,
+                  WifiTxVector txVector,
+                  double txPowerW);
+
+  private:
+    void DoRun() override;
+
+    static constexpr uint16_t m_nStations = 4;  ///< number of stations
+    static constexpr uint32_t m_nPktsPerSta = 20; ///< number of packets generated per station
+
+    std::string m_schedulerType;     ///< the TypeId name of the multi-user scheduler
+    uint16_t m_channelWidth;         ///< PHY channel bandwidth in MHz
+    uint32_t m_dlReceived{0};        ///< number of packets received by the stations
+    uint32_t m_ulReceived{0};        ///< number of packets received by the AP
+    std::size_t m_nDlMuPpdus{0};     ///< number of DL MU PPDUs transmitted by the AP
+    std::size_t m_nTbPpdus{0};       ///< number of HE TB PPDUs carrying QoS data frames
+    std::set<uint16_t> m_dlMuServed; ///< AIDs of the stations served in a DL MU PPDU
+};
+
+MultiUserSchedulerTxTest::MultiUserSchedulerTxTest(const std::string& schedulerType,
+                                                   uint16_t channelWidth)
+    : TestCase("Check DL and UL OFDMA transmissions scheduled by " + schedulerType + " on a " +
+               std::to_string(channelWidth) + " MHz channel"),
+      m_schedulerType(schedulerType),
+      m_channelWidth(channelWidth)
+{
+}
+
+void
+MultiUserSchedulerTxTest::L7Receive(bool dl, Ptr<const Packet> p, const Address& addr)
+{
+    if (p->GetSize() == 1000)
+    {
+        ++(dl ? m_dlReceived : m_ulReceived);
+    }
+}
+
+void
+MultiUserSchedulerTxTest::Transmit(std::string context,
+                                   WifiConstPsduMap psduMap,
+                                   WifiTxVector txVector,
+                                   double txPowerW)
+{
+    if (txVector.IsDlMu())
+    {
+        ++m_nDlMuPpdus;
+        for (const auto& [staId, psdu] : psduMap)
+        {
+            if (psdu->GetHeader(0).IsQosData())
+            {
+                m_dlMuServed.insert(staId);
+            }
+        }
+    }
+    else if (txVector.GetPreambleType() == WIFI_PREAMBLE_HE_TB &&
+             psduMap.begin()->second->GetHeader(0).IsQosData())
+    {
+        ++m_nTbPpdus;
+    }
+}
+
+void
+MultiUserSchedulerTxTest::DoRun()
+{
+    uint32_t previousSeed = RngSeedManager::GetSeed();
+    uint64_t previousRun = RngSeedManager::GetRun();
+    Config::SetGlobal("RngSeed", UintegerValue(2));
+    Config::SetGlobal("RngRun", UintegerValue(2));
+    int64_t streamNumber = 10;
+
+    NodeContainer wifiApNode;
+    wifiApNode.Create(1);
+    NodeContainer wifiStaNodes;
+    wifiStaNodes.Create(m_nStations);
+
+    Ptr<MultiModelSpectrumChannel> spectrumChannel = CreateObject<MultiModelSpectrumChannel>();
+    spectrumChannel->AddPropagationLossModel(CreateObject<FriisPropagationLossModel>());
+    spectrumChannel->SetPropagationDelayModel(
+        CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    SpectrumWifiPhyHelper phy;
+    phy.SetErrorRateModel("ns3::NistErrorRateModel");
+    phy.SetChannel(spectrumChannel);
+    phy.Set("ChannelSettings",
+            StringValue(m_channelWidth == 20 ? "{36, 20, BAND_5GHZ, 0}"
+                                             : "{42, 80, BAND_5GHZ, 0}"));
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("HeMcs7"),
+                                 "ControlMode",
+                                 StringValue("HeMcs0"));
+
+    WifiMacHelper mac;
+    Ssid ssid = Ssid("ns-3-ssid");
+    mac.SetType("ns3::StaWifiMac",
+                "Ssid",
+                SsidValue(ssid),
+                "BE_MaxAmsduSize",
+                UintegerValue(0),
+                "BE_BlockAckThreshold",
+                UintegerValue(2),
+                "ActiveProbing",
+                BooleanValue(false));
+    NetDeviceContainer staDevices = wifi.Install(phy, mac, wifiStaNodes);
+
+    mac.SetType("ns3::ApWifiMac",
+                "Ssid",
+                SsidValue(ssid),
+                "BE_MaxAmsduSize",
+                UintegerValue(0),
+                "BE_BlockAckThreshold",
+                UintegerValue(2));
+    mac.SetMultiUserScheduler(m_schedulerType,
+                              "EnableUlOfdma",
+                              BooleanValue(true),
+                              "EnableBsrp",
+                              BooleanValue(true),
+                              "AccessReqInterval",
+                              TimeValue(MilliSeconds(5)));
+    mac.SetAckManager("ns3::WifiDefaultAckManager",
+                      "DlMuAckSequenceType",
+                      EnumValue(WifiAcknowledgment::DL_MU_AGGREGATE_TF));
+    auto apDevice = DynamicCast<WifiNetDevice>(wifi.Install(phy, mac, wifiApNode).Get(0));
+    // limit the duration of the DL MU PPDUs sent by the AP
+    apDevice->GetMac()->GetQosTxop(AC_BE)->SetTxopLimit(MicroSeconds(3008));
+
+    streamNumber += wifi.AssignStreams(NetDeviceContainer(apDevice), streamNumber);
+    streamNumber += wifi.AssignStreams(staDevices, streamNumber);
+
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(1.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(0.0, 1.0, 0.0));
+    positionAlloc->Add(Vector(-1.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(0.0, -1.0, 0.0));
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(wifiApNode);
+    mobility.Install(wifiStaNodes);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(wifiApNode);
+    packetSocket.Install(wifiStaNodes);
+
+    for (uint16_t i = 0; i < m_nStations; i++)
+    {
+        for (bool dl : {true, false})
+        {
+            auto srcNode = dl ? wifiApNode.Get(0) : wifiStaNodes.Get(i);
+            auto dstNode = dl ? wifiStaNodes.Get(i) : wifiApNode.Get(0);
+            auto srcDevice = dl ? Ptr<NetDevice>(apDevice) : staDevices.Get(i);
+            auto dstDevice = dl ? staDevices.Get(i) : Ptr<NetDevice>(apDevice);
+
+            PacketSocketAddress socket;
+            socket.SetSingleDevice(srcDevice->GetIfIndex());
+            socket.SetPhysicalAddress(dstDevice->GetAddress());
+            socket.SetProtocol(1);
+
+            // the first client application generates two packets in order
+            // to trigger the establishment of a Block Ack agreement
+            auto client1 = CreateObject<PacketSocketClient>();
+            client1->SetAttribute("PacketSize", UintegerValue(500));
+            client1->SetAttribute("MaxPackets", UintegerValue(2));
+            client1->SetAttribute("Interval", TimeValue(MicroSeconds(0)));
+            client1->SetRemote(socket);
+            srcNode->AddApplication(client1);
+            client1->SetStartTime(Seconds(1) + i * MilliSeconds(10) +
+                                  (dl ? Time(0) : MilliSeconds(5)));
+            client1->SetStopTime(Seconds(2));
+
+            // the second client application generates a burst of packets which are
+            // queued by all the stations (or by the AP for all the stations) at once
+            auto client2 = CreateObject<PacketSocketClient>();
+            client2->SetAttribute("PacketSize", UintegerValue(1000));
+            client2->SetAttribute("MaxPackets", UintegerValue(m_nPktsPerSta));
+            client2->SetAttribute("Interval", TimeValue(MicroSeconds(0)));
+            client2->SetRemote(socket);
+            srcNode->AddApplication(client2);
+            client2->SetStartTime(Seconds(1.5));
+            client2->SetStopTime(Seconds(2));
+
+            if (!dl && i > 0)
+            {
+                // a single server on the AP receives the packets sent by all the stations
+                continue;
+            }
+            auto server = CreateObject<PacketSocketServer>();
+            server->SetLocal(socket);
+            dstNode->AddApplication(server);
+            server->SetStartTime(Seconds(0));
+            server->SetStopTime(Seconds(3));
+            server->TraceConnectWithoutContext(
+                "Rx",
+                MakeCallback(&MultiUserSchedulerTxTest::L7Receive, this).Bind(dl));
+        }
+    }
+
+    Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyTxPsduBegin",
+                    MakeCallback(&MultiUserSchedulerTxTest::Transmit, this));
+
+    Simulator::Stop(Seconds(3));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_dlReceived,
+                          m_nStations * m_nPktsPerSta,
+                          "Not all the DL packets were received");
+    NS_TEST_EXPECT_MSG_EQ(m_ulReceived,
+                          m_nStations * m_nPktsPerSta,
+                          "Not all the UL packets were received");
+    NS_TEST_EXPECT_MSG_GT(m_nDlMuPpdus, 0, "Expected DL MU PPDUs to be transmitted");
+    NS_TEST_EXPECT_MSG_GT(m_nTbPpdus, 0, "Expected HE TB PPDUs carrying data frames");
+    NS_TEST_EXPECT_MSG_EQ(m_dlMuServed.size(),
+                          m_nStations,
+                          "Not all the stations were served in a DL MU PPDU");
+
+    Simulator::Destroy();
+
+    // Restore the seed and run number that were in effect before this test
+    Config::SetGlobal("RngSeed", UintegerValue(previousSeed));
+    Config::SetGlobal("RngRun", UintegerValue(previousRun));
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -2344,6 +2834,17 @@ WifiMacOfdmaTestSuite::WifiMacOfdmaTestSuite()
                         TestCase::QUICK);
         }
     }
+
+    AddTestCase(new StationCreditQueueTest(16, 1000), TestCase::QUICK);
+    AddTestCase(new PfRuAssignmentTest, TestCase::QUICK);
+    AddTestCase(new MultiUserSchedulerTxTest("ns3::HeapMultiUserScheduler", 20),
+                TestCase::QUICK);
+    AddTestCase(new MultiUserSchedulerTxTest("ns3::HeapMultiUserScheduler", 80),
+                TestCase::QUICK);
+    AddTestCase(new MultiUserSchedulerTxTest("ns3::PfMultiUserScheduler", 20),
+                TestCase::QUICK);
+    AddTestCase(new MultiUserSchedulerTxTest("ns3::PfMultiUserScheduler", 80),
+                TestCase::QUICK);
 }
 
 static WifiMacOfdmaTestSuite g_wifiMacOfdmaTestSuite; ///< the test suite
@@ -146,8 +146,9 @@ class WifiExtractExpiredMpdusTest : public TestCase
      * \param rxAddr Receiver Address of the MPDU
      * \param inflight whether the MPDU is inflight
      * \param expiryTime the expity time for the MPDU
+     * \return an iterator pointing to the enqueued MPDU
      */
-    void Enqueue(Mac48Address rxAddr, bool inflight, Time expiryTime);
+    WifiMacQueueContainer::iterator Enqueue(Mac48Address rxAddr, bool inflight, Time expiryTime);
 
     WifiMacQueueContainer m_container; //!< MAC queue container
     uint16_t m_currentSeqNo{0};        //!< sequence number of current MPDU
@@ -159,7 +160,7 @@ WifiExtractExpiredMpdusTest::WifiExtractExpiredMpdusTest()
 {
 }
 
-void
+WifiMacQueueContainer::iterator
 WifiExtractExpiredMpdusTest::Enqueue(Mac48Address rxAddr, bool inflight, Time expiryTime)
 {
     WifiMacHeader header(WIFI_MAC_QOSDATA);
@@ -171,12 +172,13 @@ WifiExtractExpiredMpdusTest::Enqueue(Mac48Address rxAddr, bool inflight, Time ex
 
     auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
     auto elemIt = m_container.insert(m_container.GetQueue(queueId).cend(), mpdu);
-    elemIt->expiryTime = expiryTime;
+    m_container.SetExpiryTime(elemIt, expiryTime);
     if (inflight)
     {
         elemIt->inflights.emplace(0, mpdu);
     }
     elemIt->deleter = [](auto mpdu) {};
+    return elemIt;
 }
 
 void
@@ -203,9 +205,9 @@ WifiExtractExpiredMpdusTest::DoRun()
      * │11 │12 │13 │14 │15 │16 │17 │18 │19 │
      * └───┴───┴───┴───┴───┴───┴───┴───┴───┘
      */
-    Enqueue(rxAddr1, true, MilliSeconds(10));
+    auto elemIt0 = Enqueue(rxAddr1, true, MilliSeconds(10));
     Enqueue(rxAddr1, false, MilliSeconds(10));
-    Enqueue(rxAddr1, true, MilliSeconds(12));
+    auto elemIt2 = Enqueue(rxAddr1, true, MilliSeconds(12));
     Enqueue(rxAddr1, false, MilliSeconds(15));
     Enqueue(rxAddr1, true, MilliSeconds(30));
     Enqueue(rxAddr1, false, MilliSeconds(30));
@@ -424,6 +426,45 @@ WifiExtractExpiredMpdusTest::DoRun()
                               "There should be no other MPDU in container queue 2");
     });
 
+    /**
+     * At simulation time 60ms, MPDUs 0 and 2 are no longer inflight:
+     *
+     * Container queue for rxAddr1
+     * ┌───┬───┬───┬───┬───┬───┐
+     * │Exp│Exp│Exp│Exp│   │   │
+     * │   │   │Inf│Inf│   │   │
+     * │ 0 │ 2 │ 4 │ 6 │ 9 │10 │
+     * └───┴───┴───┴───┴───┴───┘
+     *
+     * Container queue for rxAddr2 is unchanged
+     */
+    Simulator::Schedule(MilliSeconds(60), [&]() {
+        elemIt0->inflights.clear();
+        elemIt2->inflights.clear();
+
+        /**
+         * Extract all expired MPDUs: MPDUs 0 and 2 are extracted even if their lifetime
+         * expired before the previous extraction
+         */
+        auto [first, last] = m_container.ExtractAllExpiredMpdus();
+
+        std::set<uint16_t> expectedSeqNo{0, 2};
+        std::set<uint16_t> actualSeqNo;
+
+        std::transform(first, last, std::inserter(actualSeqNo, actualSeqNo.end()), [](auto& elem) {
+            return elem.mpdu->GetHeader().GetSequenceNumber();
+        });
+
+        NS_TEST_EXPECT_MSG_EQ((expectedSeqNo == actualSeqNo), true, "Unexpected extracted MPDUs");
+
+        NS_TEST_EXPECT_MSG_EQ(m_container.GetQueue(queueId1).size(),
+                              4,
+                              "Unexpected number of MPDUs in container queue 1");
+        NS_TEST_EXPECT_MSG_EQ(m_container.GetQueue(queueId2).size(),
+                              6,
+                              "Unexpected number of MPDUs in container queue 2");
+    });
+
     Simulator::Run();
     Simulator::Destroy();
 }
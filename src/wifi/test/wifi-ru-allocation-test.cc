@@ -17,9 +17,13 @@
  * Author: Stefano Avallone <stavallo@unina.it>
  */
 
+#include "ns3/he-ru.h"
+#include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/wifi-phy-operating-channel.h"
 
+#include <vector>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("WifiRuAllocationTest");
@@ -675,6 +679,131 @@ Wifi20MHzIndicesCoveringRuTest::DoRun()
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the HeRu::DoesOverlap() and HeRu::FindOverlappingRu() methods, which use
+ * cached bitmasks of the tones occupied by the RUs, against a direct comparison of the
+ * subcarrier ranges of the RUs.
+ */
+class HeRuOverlapTest : public TestCase
+{
+  public:
+    HeRuOverlapTest();
+    ~HeRuOverlapTest() override = default;
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Get all the RUs (including the central 26-tone RUs) available in a HE PPDU of the
+     * given bandwidth.
+     *
+     * \param bw the bandwidth (MHz) of the HE PPDU
+     * \return all the RUs available in a HE PPDU of the given bandwidth
+     */
+    static std::vector<HeRu::RuSpec> GetAllRus(uint16_t bw);
+
+    /**
+     * Check whether two RUs overlap by comparing their subcarrier ranges.
+     *
+     * \param bw the bandwidth (MHz) of the HE PPDU
+     * \param ru the first RU
+     * \param other the second RU
+     * \return whether the two RUs overlap
+     */
+    static bool DoRusOverlap(uint16_t bw, const HeRu::RuSpec& ru, const HeRu::RuSpec& other);
+};
+
+HeRuOverlapTest::HeRuOverlapTest()
+    : TestCase("Check the computation of overlapping HE RUs")
+{
+}
+
+std::vector<HeRu::RuSpec>
+HeRuOverlapTest::GetAllRus(uint16_t bw)
+{
+    std::vector<HeRu::RuSpec> rus;
+    for (auto ruType : {HeRu::RU_26_TONE,
+                        HeRu::RU_52_TONE,
+                        HeRu::RU_106_TONE,
+                        HeRu::RU_242_TONE,
+                        HeRu::RU_484_TONE,
+                        HeRu::RU_996_TONE,
+                        HeRu::RU_2x996_TONE})
+    {
+        if (HeRu::GetNRus(bw, ruType) > 0)
+        {
+            const auto& rusOfType = HeRu::GetRusOfType(bw, ruType);
+            rus.insert(rus.end(), rusOfType.cbegin(), rusOfType.cend());
+        }
+    }
+    return rus;
+}
+
+bool
+HeRuOverlapTest::DoRusOverlap(uint16_t bw, const HeRu::RuSpec& ru, const HeRu::RuSpec& other)
+{
+    if (bw == 160 && ru.GetRuType() == HeRu::RU_2x996_TONE)
+    {
+        return true;
+    }
+    if (ru.GetPrimary80MHz() != other.GetPrimary80MHz())
+    {
+        return false;
+    }
+    for (const auto& range : HeRu::GetSubcarrierGroup(bw, ru.GetRuType(), ru.GetIndex()))
+    {
+        for (const auto& otherRange :
+             HeRu::GetSubcarrierGroup(bw, other.GetRuType(), other.GetIndex()))
+        {
+            if (otherRange.second >= range.first && range.second >= otherRange.first)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void
+HeRuOverlapTest::DoRun()
+{
+    for (uint16_t bw : {20, 40, 80, 160})
+    {
+        const auto rus = GetAllRus(bw);
+        NS_TEST_ASSERT_MSG_EQ(rus.empty(), false, "No RU found for bw=" << bw);
+
+        // check that the RUs returned by GetRusOfType() do not change across calls
+        NS_TEST_EXPECT_MSG_EQ((GetAllRus(bw) == rus), true, "RUs changed for bw=" << bw);
+
+        for (const auto& ru : rus)
+        {
+            for (const auto& other : rus)
+            {
+                auto overlap = DoRusOverlap(bw, ru, other);
+                NS_TEST_EXPECT_MSG_EQ(HeRu::DoesOverlap(bw, ru, {other}),
+                                      overlap,
+                                      "Unexpected overlap for bw=" << bw << ", RU=" << ru
+                                                                   << ", other RU=" << other);
+            }
+            // an RU always overlaps with itself and with the RU of the same type
+            // returned by FindOverlappingRu()
+            NS_TEST_EXPECT_MSG_EQ(HeRu::DoesOverlap(bw, ru, {ru}),
+                                  true,
+                                  "RU " << ru << " does not overlap with itself");
+            if (ru.GetRuType() != HeRu::RU_2x996_TONE)
+            {
+                auto found = HeRu::FindOverlappingRu(bw, ru, HeRu::RU_26_TONE);
+                NS_TEST_EXPECT_MSG_EQ(DoRusOverlap(bw, ru, found),
+                                      true,
+                                      "26-tone RU " << found << " does not overlap with " << ru);
+            }
+        }
+    }
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -691,6 +820,7 @@ WifiRuAllocationTestSuite::WifiRuAllocationTestSuite()
     : TestSuite("wifi-ru-allocation", UNIT)
 {
     AddTestCase(new Wifi20MHzIndicesCoveringRuTest(), TestCase::QUICK);
+    AddTestCase(new HeRuOverlapTest(), TestCase::QUICK);
 }
 
 static WifiRuAllocationTestSuite g_wifiRuAllocationTestSuite; ///< the test suite
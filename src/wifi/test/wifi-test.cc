@@ -22,6 +22,7 @@
 
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/ap-wifi-mac.h"
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/error-model.h"
@@ -30,6 +31,7 @@
 #include "ns3/header-serialization-test.h"
 #include "ns3/ht-configuration.h"
 #include "ns3/interference-helper.h"
+#include "ns3/log.h"
 #include "ns3/mgt-headers.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/multi-model-spectrum-channel.h"
@@ -41,6 +43,7 @@
 #include "ns3/rng-seed-manager.h"
 #include "ns3/socket.h"
 #include "ns3/spectrum-wifi-helper.h"
+#include "ns3/sta-wifi-mac.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 #include "ns3/vht-phy.h"
@@ -58,9 +61,12 @@
 #include "ns3/yans-wifi-phy.h"
 
 #include <optional>
+#include <tuple>
 
 using namespace ns3;
 
+NS_LOG_COMPONENT_DEFINE("WifiDevicesTest");
+
 // Helper function to assign streams to random variables, to control
 // randomness in the tests
 static void
@@ -3778,6 +3784,479 @@ WifiMgtHeaderTest::DoRun()
     TestHeaderSerialization(frame);
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Make sure that enabling batched delivery on the YANS channel does not change the
+ * simulation results.
+ *
+ * A node transmits a few broadcast frames that are received by nodes placed at
+ * different distances, some of which share the same propagation delay. For each
+ * frame received by a node, the reception time and the simulation context are
+ * recorded. The test is run with and without batched delivery and the recorded
+ * receptions must be identical in the two runs. Also, the context of every
+ * reception must match the ID of the receiving node.
+ */
+class YansWifiChannelBatchedDeliveryTest : public TestCase
+{
+  public:
+    YansWifiChannelBatchedDeliveryTest();
+    void DoRun() override;
+
+  private:
+    /// Information about a frame received by a node (time, node ID, context)
+    using RxInfo = std::tuple<Time, uint32_t, uint32_t>;
+
+    /**
+     * Run one simulation
+     * \param batchedDelivery whether batched delivery is enabled on the channel
+     * \return the list of receptions
+     */
+    std::vector<RxInfo> RunOne(bool batchedDelivery);
+
+    /**
+     * Callback invoked when a MAC receives a frame
+     * \param context the context
+     * \param p the received packet
+     */
+    void Receive(std::string context, Ptr<const Packet> p);
+
+    std::vector<RxInfo> m_rxInfo; ///< receptions of the current run
+};
+
+YansWifiChannelBatchedDeliveryTest::YansWifiChannelBatchedDeliveryTest()
+    : TestCase("Check that batched delivery on the YANS channel preserves results")
+{
+}
+
+void
+YansWifiChannelBatchedDeliveryTest::Receive(std::string context, Ptr<const Packet> p)
+{
+    auto nodeId = static_cast<uint32_t>(std::stoul(context.substr(10))); // skip "/NodeList/"
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetContext(), nodeId, "Unexpected context at reception");
+    m_rxInfo.emplace_back(Simulator::Now(), nodeId, Simulator::GetContext());
+}
+
+std::vector<YansWifiChannelBatchedDeliveryTest::RxInfo>
+YansWifiChannelBatchedDeliveryTest::RunOne(bool batchedDelivery)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    m_rxInfo.clear();
+
+    NodeContainer nodes;
+    nodes.Create(7);
+
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    auto yansChannel = channel.Create();
+    yansChannel->SetAttribute("BatchedDelivery", BooleanValue(batchedDelivery));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(yansChannel);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager");
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    auto devices = wifi.Install(phy, mac, nodes);
+    wifi.AssignStreams(devices, 100);
+
+    MobilityHelper mobility;
+    auto positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(5.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(0.0, 5.0, 0.0));
+    positionAlloc->Add(Vector(-5.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(10.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(0.0, -10.0, 0.0));
+    positionAlloc->Add(Vector(20.0, 0.0, 0.0));
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/MacRx",
+                    MakeCallback(&YansWifiChannelBatchedDeliveryTest::Receive, this));
+
+    auto sender = devices.Get(0);
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        Simulator::Schedule(Seconds(1.0) + MilliSeconds(i),
+                            &NetDevice::Send,
+                            sender,
+                            Create<Packet>(500),
+                            sender->GetBroadcast(),
+                            1);
+    }
+
+    Simulator::Stop(Seconds(2.0));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    return m_rxInfo;
+}
+
+void
+YansWifiChannelBatchedDeliveryTest::DoRun()
+{
+    auto expected = RunOne(false);
+    NS_TEST_ASSERT_MSG_EQ(expected.size(), 30, "Unexpected number of received frames");
+
+    auto actual = RunOne(true);
+    NS_TEST_ASSERT_MSG_EQ(actual.size(), expected.size(), "Unexpected number of received frames");
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(std::get<0>(actual[i]),
+                              std::get<0>(expected[i]),
+                              "Unexpected reception time for frame #" << i);
+        NS_TEST_EXPECT_MSG_EQ(std::get<1>(actual[i]),
+                              std::get<1>(expected[i]),
+                              "Unexpected receiver for frame #" << i);
+        NS_TEST_EXPECT_MSG_EQ(std::get<2>(actual[i]),
+                              std::get<2>(expected[i]),
+                              "Unexpected context for frame #" << i);
+    }
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the Beacon frames sent by an AP caching the Beacon frame body
+ * are identical to those sent by an AP building the Beacon frame body every time.
+ *
+ * An 802.11ax AP is configured on a 20 MHz channel. An 802.11n station associates
+ * with the AP first, followed by a non-HT station, whose association changes the
+ * HT Protection field of the HT Operation element. Later, the SSID of the AP is
+ * changed. The test is run with and without caching Beacon frames and the bytes of
+ * the Beacon frames transmitted in the two runs must be identical. Also, the Beacon
+ * frames sent with caching enabled must advertise the updated BSS configuration.
+ */
+class WifiBeaconCachingTest : public TestCase
+{
+  public:
+    WifiBeaconCachingTest();
+    void DoRun() override;
+
+  private:
+    /**
+     * Run one simulation
+     * \param cacheBeacons whether the AP caches Beacon frames
+     * \return the list of transmitted Beacon frames
+     */
+    std::vector<Ptr<const Packet>> RunOne(bool cacheBeacons);
+
+    /**
+     * Callback invoked when the PHY of the AP starts transmitting a frame
+     * \param p the packet being transmitted
+     * \param txPowerW the transmit power in Watts
+     */
+    void Transmit(Ptr<const Packet> p, double txPowerW);
+
+    std::vector<Ptr<const Packet>> m_beacons; ///< Beacon frames sent in the current run
+};
+
+WifiBeaconCachingTest::WifiBeaconCachingTest()
+    : TestCase("Check that caching Beacon frames does not change the transmitted frames")
+{
+}
+
+void
+WifiBeaconCachingTest::Transmit(Ptr<const Packet> p, double txPowerW)
+{
+    WifiMacHeader hdr;
+    p->PeekHeader(hdr);
+    if (hdr.IsBeacon())
+    {
+        m_beacons.push_back(p->Copy());
+    }
+}
+
+std::vector<Ptr<const Packet>>
+WifiBeaconCachingTest::RunOne(bool cacheBeacons)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    m_beacons.clear();
+
+    NodeContainer apNode;
+    apNode.Create(1);
+    NodeContainer staNodes;
+    staNodes.Create(2);
+
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+    phy.Set("ChannelSettings", StringValue("{36, 20, BAND_5GHZ, 0}"));
+
+    WifiHelper wifi;
+    wifi.SetRemoteStationManager("ns3::IdealWifiManager");
+    WifiMacHelper mac;
+    Ssid ssid("beacon-caching");
+
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    mac.SetType("ns3::ApWifiMac",
+                "Ssid",
+                SsidValue(ssid),
+                "CacheBeacons",
+                BooleanValue(cacheBeacons));
+    auto apDevice = wifi.Install(phy, mac, apNode);
+
+    mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+    wifi.SetStandard(WIFI_STANDARD_80211n);
+    auto htStaDevice = wifi.Install(phy, mac, staNodes.Get(0));
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    auto nonHtStaDevice = wifi.Install(phy, mac, staNodes.Get(1));
+
+    NetDeviceContainer devices(apDevice, htStaDevice);
+    devices.Add(nonHtStaDevice);
+    wifi.AssignStreams(devices, 100);
+
+    MobilityHelper mobility;
+    auto positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(5.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(0.0, 5.0, 0.0));
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(apNode);
+    mobility.Install(staNodes);
+
+    // the non-HT station starts scanning when the HT station is associated
+    auto nonHtStaMac =
+        DynamicCast<StaWifiMac>(DynamicCast<WifiNetDevice>(nonHtStaDevice.Get(0))->GetMac());
+    nonHtStaMac->SetSsid(Ssid("unknown"));
+    Simulator::Schedule(Seconds(0.5), &WifiMac::SetSsid, nonHtStaMac, ssid);
+
+    auto apMac = DynamicCast<WifiNetDevice>(apDevice.Get(0))->GetMac();
+    Simulator::Schedule(Seconds(1.5), &WifiMac::SetSsid, apMac, Ssid("beacon-caching-2"));
+
+    DynamicCast<WifiNetDevice>(apDevice.Get(0))
+        ->GetPhy()
+        ->TraceConnectWithoutContext("PhyTxBegin",
+                                     MakeCallback(&WifiBeaconCachingTest::Transmit, this));
+
+    Simulator::Stop(Seconds(2.0));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    return m_beacons;
+}
+
+void
+WifiBeaconCachingTest::DoRun()
+{
+    auto expected = RunOne(false);
+    NS_TEST_ASSERT_MSG_GT(expected.size(), 10, "Too few Beacon frames transmitted");
+
+    auto actual = RunOne(true);
+    NS_TEST_ASSERT_MSG_EQ(actual.size(), expected.size(), "Unexpected number of Beacon frames");
+
+    bool htProtection = false;
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(actual[i]->GetSize(),
+                              expected[i]->GetSize(),
+                              "Unexpected size for Beacon frame #" << i);
+        std::vector<uint8_t> actualBytes(actual[i]->GetSize());
+        actual[i]->CopyData(actualBytes.data(), actualBytes.size());
+        std::vector<uint8_t> expectedBytes(expected[i]->GetSize());
+        expected[i]->CopyData(expectedBytes.data(), expectedBytes.size());
+        NS_TEST_EXPECT_MSG_EQ((actualBytes == expectedBytes),
+                              true,
+                              "Unexpected content for Beacon frame #" << i);
+
+        auto packet = actual[i]->Copy();
+        WifiMacHeader hdr;
+        packet->RemoveHeader(hdr);
+        MgtBeaconHeader beacon;
+        packet->RemoveHeader(beacon);
+        NS_TEST_ASSERT_MSG_EQ(beacon.Get<HtOperation>().has_value(),
+                              true,
+                              "Expected an HT Operation element in Beacon frame #" << i);
+        if (beacon.Get<HtOperation>()->GetHtProtection() == MIXED_MODE_PROTECTION)
+        {
+            htProtection = true;
+        }
+        if (i + 1 == expected.size())
+        {
+            NS_TEST_EXPECT_MSG_EQ(beacon.Get<Ssid>()->IsEqual(Ssid("beacon-caching-2")),
+                                  true,
+                                  "The last Beacon frame does not advertise the updated SSID");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(htProtection,
+                          true,
+                          "No Beacon frame advertised the association of the non-HT station");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the serialized MAC header cached by WifiMacHeader is kept
+ * consistent with the header fields.
+ *
+ * Headers of the common layouts are serialized and deserialized, and the
+ * deserialized headers are checked to be re-serialized identically. Headers
+ * modified after being serialized must be serialized again with the new values,
+ * and bits of the Frame Control field that are not modelled (e.g., the Protocol
+ * Version) must not be re-emitted by a deserialized header. The time taken to
+ * serialize the MAC header is measured by utils/bench-packets.
+ */
+class WifiMacHeaderSerializationTest : public HeaderSerializationTestCase
+{
+  public:
+    WifiMacHeaderSerializationTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that the given header is correctly serialized and deserialized.
+     *
+     * \param hdr the given header
+     */
+    void CheckHeader(const WifiMacHeader& hdr);
+
+    /**
+     * \param hdr the given header
+     * \return the serialized header
+     */
+    static std::vector<uint8_t> Serialize(const WifiMacHeader& hdr);
+
+    /**
+     * \param bytes the serialized header
+     * \return the header deserialized from the given bytes
+     */
+    static WifiMacHeader Deserialize(const std::vector<uint8_t>& bytes);
+};
+
+WifiMacHeaderSerializationTest::WifiMacHeaderSerializationTest()
+    : HeaderSerializationTestCase("Check cached serialization of the MAC header")
+{
+}
+
+std::vector<uint8_t>
+WifiMacHeaderSerializationTest::Serialize(const WifiMacHeader& hdr)
+{
+    Buffer buffer;
+    buffer.AddAtStart(hdr.GetSerializedSize());
+    hdr.Serialize(buffer.Begin());
+    std::vector<uint8_t> bytes(buffer.GetSize());
+    buffer.CopyData(bytes.data(), bytes.size());
+    return bytes;
+}
+
+WifiMacHeader
+WifiMacHeaderSerializationTest::Deserialize(const std::vector<uint8_t>& bytes)
+{
+    Buffer buffer;
+    buffer.AddAtStart(bytes.size());
+    buffer.Begin().Write(bytes.data(), bytes.size());
+    WifiMacHeader hdr;
+    hdr.Deserialize(buffer.Begin());
+    return hdr;
+}
+
+void
+WifiMacHeaderSerializationTest::CheckHeader(const WifiMacHeader& hdr)
+{
+    TestHeaderSerialization(hdr);
+
+    const auto bytes = Serialize(hdr);
+    Buffer buffer;
+    buffer.AddAtStart(bytes.size());
+    buffer.Begin().Write(bytes.data(), bytes.size());
+    WifiMacHeader rxHdr;
+    NS_TEST_EXPECT_MSG_EQ(rxHdr.Deserialize(buffer.Begin()),
+                          bytes.size(),
+                          "Unexpected deserialized size for " << hdr);
+    NS_TEST_EXPECT_MSG_EQ(rxHdr.GetType(), hdr.GetType(), "Unexpected type for " << hdr);
+    NS_TEST_EXPECT_MSG_EQ(rxHdr.GetAddr1(), hdr.GetAddr1(), "Unexpected Addr1 for " << hdr);
+    NS_TEST_EXPECT_MSG_EQ((Serialize(rxHdr) == bytes),
+                          true,
+                          "Header fields not deserialized correctly for " << hdr);
+}
+
+void
+WifiMacHeaderSerializationTest::DoRun()
+{
+    auto addr1 = Mac48Address("00:00:00:00:00:01");
+    auto addr2 = Mac48Address("00:00:00:00:00:02");
+    auto addr3 = Mac48Address("00:00:00:00:00:03");
+    auto addr4 = Mac48Address("00:00:00:00:00:04");
+
+    WifiMacHeader qosData(WIFI_MAC_QOSDATA);
+    qosData.SetAddr1(addr1);
+    qosData.SetAddr2(addr2);
+    qosData.SetAddr3(addr3);
+    qosData.SetDsNotTo();
+    qosData.SetDsFrom();
+    qosData.SetSequenceNumber(1234);
+    qosData.SetQosTid(5);
+    qosData.SetQosAckPolicy(WifiMacHeader::BLOCK_ACK);
+    qosData.SetQosAmsdu();
+    qosData.SetDuration(MicroSeconds(44));
+    CheckHeader(qosData);
+
+    WifiMacHeader qosData4Addr = qosData;
+    qosData4Addr.SetDsTo();
+    qosData4Addr.SetAddr4(addr4);
+    CheckHeader(qosData4Addr);
+
+    WifiMacHeader data(WIFI_MAC_DATA);
+    data.SetAddr1(addr1);
+    data.SetAddr2(addr2);
+    data.SetAddr3(addr3);
+    data.SetFragmentNumber(3);
+    data.SetMoreFragments();
+    CheckHeader(data);
+
+    for (auto type : {WIFI_MAC_CTL_ACK,
+                      WIFI_MAC_CTL_CTS,
+                      WIFI_MAC_CTL_RTS,
+                      WIFI_MAC_CTL_BACKREQ,
+                      WIFI_MAC_CTL_BACKRESP,
+                      WIFI_MAC_CTL_TRIGGER,
+                      WIFI_MAC_MGT_BEACON,
+                      WIFI_MAC_MGT_ACTION})
+    {
+        WifiMacHeader hdr(type);
+        hdr.SetAddr1(addr1);
+        hdr.SetAddr2(addr2);
+        hdr.SetAddr3(addr3);
+        hdr.SetDuration(MicroSeconds(32));
+        CheckHeader(hdr);
+    }
+
+    // modifying a header after serializing it must be reflected by the next serialization
+    auto before = Serialize(qosData);
+    qosData.SetRetry();
+    qosData.SetSequenceNumber(1235);
+    auto after = Serialize(qosData);
+    NS_TEST_EXPECT_MSG_EQ((before != after), true, "Cached header not invalidated by setters");
+    auto rxHdr = Deserialize(after);
+    NS_TEST_EXPECT_MSG_EQ(rxHdr.IsRetry(), true, "Retry flag not serialized");
+    NS_TEST_EXPECT_MSG_EQ(rxHdr.GetSequenceNumber(), 1235, "Sequence number not serialized");
+    rxHdr.SetNoRetry();
+    NS_TEST_EXPECT_MSG_EQ((Serialize(rxHdr) == before),
+                          false,
+                          "Sequence number of the deserialized header lost");
+    rxHdr.SetSequenceNumber(1234);
+    NS_TEST_EXPECT_MSG_EQ((Serialize(rxHdr) == before),
+                          true,
+                          "Cached header of the deserialized header not invalidated");
+
+    // the Protocol Version is not modelled, hence it is not re-emitted
+    auto withVersion = before;
+    withVersion[0] |= 0x01;
+    NS_TEST_EXPECT_MSG_EQ((Serialize(Deserialize(withVersion)) == before),
+                          true,
+                          "Unmodelled Frame Control bits re-emitted by a deserialized header");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -3811,6 +4290,9 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new IdealRateManagerMimoTest, TestCase::QUICK);
     AddTestCase(new HeRuMcsDataRateTestCase, TestCase::QUICK);
     AddTestCase(new WifiMgtHeaderTest, TestCase::QUICK);
+    AddTestCase(new YansWifiChannelBatchedDeliveryTest, TestCase::QUICK);
+    AddTestCase(new WifiBeaconCachingTest, TestCase::QUICK);
+    AddTestCase(new WifiMacHeaderSerializationTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
@@ -25,6 +25,8 @@
 #include "ns3/wifi-standards.h"
 
 #include <cmath>
+#include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -306,6 +308,108 @@ WifiOfdmMaskSlopesTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test checks that transmit PSDs obtained from the cache of PSD templates match
+ * the PSDs returned when the templates are built.
+ */
+class WifiTxPsdCacheTestCase : public TestCase
+{
+  public:
+    WifiTxPsdCacheTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that the given PSDs are equal. Both PSDs are derived from the same template,
+     * hence they must be identical.
+     *
+     * \param actual the PSD obtained from the cache
+     * \param expected the PSD obtained when the template was built
+     * \param msg the message to print in case of mismatch
+     */
+    void CheckPsd(Ptr<const SpectrumValue> actual,
+                  Ptr<const SpectrumValue> expected,
+                  const std::string& msg);
+};
+
+WifiTxPsdCacheTestCase::WifiTxPsdCacheTestCase()
+    : TestCase("Check the cache of transmit PSD templates")
+{
+}
+
+void
+WifiTxPsdCacheTestCase::CheckPsd(Ptr<const SpectrumValue> actual,
+                                 Ptr<const SpectrumValue> expected,
+                                 const std::string& msg)
+{
+    NS_TEST_ASSERT_MSG_EQ(actual->GetValuesN(), expected->GetValuesN(), msg << ": size mismatch");
+    for (uint32_t i = 0; i < actual->GetValuesN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ((*actual)[i],
+                              (*expected)[i],
+                              msg << ": mismatch for subcarrier " << i);
+    }
+}
+
+void
+WifiTxPsdCacheTestCase::DoRun()
+{
+    const std::vector<bool> punctured{false, true, false, false};
+    const WifiSpectrumBandIndices ru{100, 341};
+
+    WifiSpectrumValueHelper::ClearTxPsdCache();
+    auto heMiss = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(5210, 80, 0.1, 80);
+    auto heMuMiss =
+        WifiSpectrumValueHelper::CreateHeMuOfdmTxPowerSpectralDensity(5210, 80, 0.1, 80, ru);
+    auto puncturedMiss = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(5210,
+                                                                                    80,
+                                                                                    0.1,
+                                                                                    80,
+                                                                                    -20,
+                                                                                    -28,
+                                                                                    -40,
+                                                                                    punctured);
+    auto stats = WifiSpectrumValueHelper::GetTxPsdCacheStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.hits, 0, "Unexpected cache hits");
+    NS_TEST_EXPECT_MSG_EQ(stats.misses, 3, "Unexpected cache misses");
+
+    // templates are now cached; a PSD returned by the cache must not be shared
+    auto heHit = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(5210, 80, 0.1, 80);
+    *heHit *= 2;
+    heHit = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(5210, 80, 0.1, 80);
+    CheckPsd(heHit, heMiss, "HE OFDM PSD");
+    auto heMuHit =
+        WifiSpectrumValueHelper::CreateHeMuOfdmTxPowerSpectralDensity(5210, 80, 0.1, 80, ru);
+    CheckPsd(heMuHit, heMuMiss, "HE MU OFDM PSD");
+    auto puncturedHit = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(5210,
+                                                                                   80,
+                                                                                   0.1,
+                                                                                   80,
+                                                                                   -20,
+                                                                                   -28,
+                                                                                   -40,
+                                                                                   punctured);
+    CheckPsd(puncturedHit, puncturedMiss, "Punctured HE OFDM PSD");
+    stats = WifiSpectrumValueHelper::GetTxPsdCacheStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.hits, 4, "Unexpected cache hits");
+    NS_TEST_EXPECT_MSG_EQ(stats.misses, 3, "Unexpected cache misses");
+
+    // a PSD for another transmit power is obtained by scaling the cached template
+    auto scaledHit =
+        WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(5210, 80, 0.04, 80);
+    WifiSpectrumValueHelper::ClearTxPsdCache();
+    auto scaledMiss =
+        WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(5210, 80, 0.04, 80);
+    CheckPsd(scaledHit, scaledMiss, "Scaled HE OFDM PSD");
+    stats = WifiSpectrumValueHelper::GetTxPsdCacheStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.hits, 0, "Cache statistics not reset");
+    NS_TEST_EXPECT_MSG_EQ(stats.misses, 1, "Cache statistics not reset");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1320,4 +1424,6 @@ WifiTransmitMaskTestSuite::WifiTransmitMaskTestSuite()
                                        prec,
                                        {false, false, false, false, false, false, true, true}),
         TestCase::QUICK);
+
+    AddTestCase(new WifiTxPsdCacheTestCase, TestCase::QUICK);
 }
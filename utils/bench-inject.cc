@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/**
+ *  Benchmark of the injection of events from threads other than the main
+ *  thread, as done by the emulation devices (e.g., FdNetDevice reader threads).
+ *
+ *  Each producer thread schedules a given number of events for immediate
+ *  execution by means of Simulator::ScheduleWithContext(), while the main
+ *  thread runs the simulation and polls for injected events between two
+ *  events of its own.
+ */
+class InjectionBench
+{
+  public:
+    /**
+     * Constructor
+     * \param [in] threads The number of producer threads.
+     * \param [in] events The number of events injected by each thread.
+     */
+    InjectionBench(uint32_t threads, uint64_t events)
+        : m_threads(threads),
+          m_events(events),
+          m_received(0)
+    {
+    }
+
+    /**
+     * Run the benchmark once.
+     * \return The wall clock time of the run, in seconds.
+     */
+    double Run();
+
+  private:
+    /** Start the producer threads, from the main thread. */
+    void Start();
+    /**
+     * Inject events into the simulator.
+     * \param [in] context The context of the injected events.
+     */
+    void Produce(uint32_t context);
+    /** Executed for each injected event. */
+    void Receive();
+    /** Keep the main thread busy until all the injected events are executed. */
+    void Poll();
+
+    uint32_t m_threads;                   //!< Number of producer threads.
+    uint64_t m_events;                    //!< Number of events per producer thread.
+    uint64_t m_received;                  //!< Number of injected events executed.
+    std::vector<std::thread> m_producers; //!< Producer threads.
+};
+
+void
+InjectionBench::Start()
+{
+    for (uint32_t i = 0; i < m_threads; ++i)
+    {
+        m_producers.emplace_back(&InjectionBench::Produce, this, i);
+    }
+    Poll();
+}
+
+void
+InjectionBench::Produce(uint32_t context)
+{
+    for (uint64_t i = 0; i < m_events; ++i)
+    {
+        Simulator::ScheduleWithContext(context, Time(0), &InjectionBench::Receive, this);
+    }
+}
+
+void
+InjectionBench::Receive()
+{
+    ++m_received;
+}
+
+void
+InjectionBench::Poll()
+{
+    if (m_received < m_threads * m_events)
+    {
+        Simulator::Schedule(NanoSeconds(1), &InjectionBench::Poll, this);
+    }
+}
+
+double
+InjectionBench::Run()
+{
+    m_received = 0;
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Schedule(Time(0), &InjectionBench::Start, this);
+    Simulator::Run();
+    double elapsed = timer.End() / 1000.0;
+    for (auto& producer : m_producers)
+    {
+        producer.join();
+    }
+    m_producers.clear();
+    Simulator::Destroy();
+    NS_ABORT_MSG_IF(m_received != m_threads * m_events, "Injected events were lost");
+    return elapsed;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t threads = 4;
+    uint64_t events = 1000000;
+    uint64_t runs = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the injection of events from threads other than the main thread.\n"
+              "\n"
+              "Each producer thread schedules events with Simulator::ScheduleWithContext()\n"
+              "while the main thread runs the simulation.");
+    cmd.AddValue("threads", "number of producer threads", threads);
+    cmd.AddValue("events", "number of events injected by each thread", events);
+    cmd.AddValue("runs", "number of runs", runs);
+    cmd.Parse(argc, argv);
+
+    LOG(cmd.GetName() << ": Benchmark the injection of events from other threads");
+    LOG("  Producer threads:      " << threads);
+    LOG("  Events per thread:     " << events);
+    LOG("  Number of runs:        " << runs);
+    LOG("");
+    LOG(std::left << std::setw(8) << "Run" << std::setw(12) << "Time (s)" << "Events/s");
+
+    InjectionBench bench(threads, events);
+    double total = 0;
+    for (uint64_t run = 0; run < runs; ++run)
+    {
+        double elapsed = bench.Run();
+        total += elapsed;
+        LOG(std::left << std::setw(8) << run << std::setw(12) << elapsed
+                      << threads * events / elapsed);
+    }
+    LOG(std::left << std::setw(8) << "Average" << std::setw(12) << total / runs
+                  << threads * events * runs / total);
+    return 0;
+}
@@ -26,6 +26,10 @@
 #include "ns3/packet.h"
 #include "ns3/system-wall-clock-ms.h"
 
+#ifdef HAVE_WIFI
+#include "ns3/wifi-mac-header.h"
+#endif
+
 #include <algorithm>
 #include <iostream>
 #include <limits>
@@ -350,6 +354,136 @@ benchByteTags(uint32_t n)
     }
 }
 
+static void
+benchAmsdu(uint32_t n)
+{
+    BenchHeader<8> llc;       // LLC/SNAP header
+    BenchHeader<14> subframe; // A-MSDU subframe header
+    BenchHeader<26> mac;      // QoS Data MAC header
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        // aggregate four MSDUs, padding all of them but the last one to a
+        // multiple of four bytes
+        Ptr<Packet> amsdu = Create<Packet>();
+        for (uint32_t j = 0; j < 4; j++)
+        {
+            Ptr<Packet> msdu = Create<Packet>(1500);
+            msdu->AddHeader(llc);
+            Ptr<Packet> copy = msdu->Copy();
+            copy->AddHeader(subframe);
+            if (j < 3)
+            {
+                copy->AddPaddingAtEnd((4 - copy->GetSize() % 4) % 4);
+            }
+            amsdu->AddAtEnd(copy);
+        }
+        amsdu->AddHeader(mac);
+
+        // deaggregate a copy of the A-MSDU at the receiver
+        Ptr<Packet> rx = amsdu->Copy();
+        rx->RemoveHeader(mac);
+        uint32_t subframeSize = 14 + 8 + 1500;
+        for (uint32_t offset = 0; offset < rx->GetSize();
+             offset += subframeSize + (4 - subframeSize % 4) % 4)
+        {
+            Ptr<Packet> msdu = rx->CreateFragment(offset, subframeSize);
+            msdu->RemoveHeader(subframe);
+            msdu->RemoveHeader(llc);
+        }
+    }
+}
+
+static void
+benchWifiTags(uint32_t n)
+{
+    BenchHeader<8> llc;  // LLC/SNAP header
+    BenchHeader<26> mac; // QoS Data MAC header
+    BenchTag<1> priority;
+    BenchTag<4> flowId;
+    BenchTag<12> txParams;
+    BenchTag<16> rxParams;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        // tags added by the application and the upper layers
+        Ptr<Packet> p = Create<Packet>(1500);
+        p->AddByteTag(flowId);
+        p->AddPacketTag(priority);
+        p->AddHeader(llc);
+
+        // the MAC transmits a copy of the packet, and a copy of the packet
+        // for the retransmission
+        for (uint32_t attempt = 0; attempt < 2; attempt++)
+        {
+            Ptr<Packet> mpdu = p->Copy();
+            mpdu->AddHeader(mac);
+            mpdu->AddPacketTag(txParams);
+
+            // the receiver gets a copy of the transmitted packet
+            Ptr<Packet> rx = mpdu->Copy();
+            rx->RemovePacketTag(txParams);
+            rx->AddPacketTag(rxParams);
+            rx->PeekPacketTag(priority);
+            rx->RemovePacketTag(rxParams);
+            rx->RemoveHeader(mac);
+            rx->RemoveHeader(llc);
+            rx->FindFirstMatchingByteTag(flowId);
+        }
+    }
+}
+
+#ifdef HAVE_WIFI
+/**
+ * \return a QoS Data header
+ */
+static WifiMacHeader
+MakeQosDataHeader()
+{
+    WifiMacHeader hdr(WIFI_MAC_QOSDATA);
+    hdr.SetAddr1(Mac48Address("00:00:00:00:00:01"));
+    hdr.SetAddr2(Mac48Address("00:00:00:00:00:02"));
+    hdr.SetAddr3(Mac48Address("00:00:00:00:00:03"));
+    hdr.SetDsNotTo();
+    hdr.SetDsFrom();
+    hdr.SetSequenceNumber(1234);
+    hdr.SetQosTid(5);
+    hdr.SetQosAckPolicy(WifiMacHeader::BLOCK_ACK);
+    hdr.SetDuration(MicroSeconds(44));
+    return hdr;
+}
+
+static void
+benchWifiMacHeader(uint32_t n)
+{
+    WifiMacHeader qosData = MakeQosDataHeader();
+    WifiMacHeader hdr;
+    Ptr<Packet> p = Create<Packet>(1500);
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        p->AddHeader(qosData);
+        p->RemoveHeader(hdr);
+    }
+}
+
+static void
+benchWifiMacHeaderModified(uint32_t n)
+{
+    WifiMacHeader qosData = MakeQosDataHeader();
+    WifiMacHeader hdr;
+    Ptr<Packet> p = Create<Packet>(1500);
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        // the serialized header cannot be reused after modifying the header
+        qosData.SetSequenceNumber(i % 4096);
+        p->AddHeader(qosData);
+        p->RemoveHeader(hdr);
+    }
+}
+#endif
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -407,6 +541,12 @@ main(int argc, char* argv[])
     runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
     runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
     runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    runBench(&benchAmsdu, n, minIterations, "A-MSDU aggregation and deaggregation");
+    runBench(&benchWifiTags, n, minIterations, "Wi-Fi tags and retransmissions");
+#ifdef HAVE_WIFI
+    runBench(&benchWifiMacHeader, n, minIterations, "Wi-Fi MAC header, unmodified");
+    runBench(&benchWifiMacHeaderModified, n, minIterations, "Wi-Fi MAC header, modified");
+#endif
 
     return 0;
 }
@@ -451,12 +451,71 @@ GetRandomStream(std::string filename)
     return stream;
 }
 
+/**
+ *  Create a RandomVariableStream to generate next event delays shaped like
+ *  the events of an 802.11ax simulation in the 5 GHz band.
+ *
+ *  Delays are drawn from a mixture of SIFS intervals, AIFS plus backoff,
+ *  backoff slot boundaries, PPDU durations, response timeouts and beacon
+ *  intervals, so that many events are a few microseconds apart and a few
+ *  are tens of milliseconds in the future.
+ *
+ *  \returns The RandomVariableStream.
+ */
+Ptr<RandomVariableStream>
+GetWifiStream()
+{
+    LOG("  Event time distribution:      Wi-Fi shaped");
+
+    const double sifs = 16000;     // ns
+    const double slot = 9000;      // ns
+    const double aifs = 34000;     // ns (AIFSN = 2)
+    const double timeout = 75000;  // ns (Ack timeout)
+    const double beacon = 1.024e8; // ns (100 TUs)
+
+    auto uniform = CreateObject<UniformRandomVariable>();
+    std::vector<double> nsValues(1000000);
+    for (auto& value : nsValues)
+    {
+        double u = uniform->GetValue();
+        if (u < 0.35)
+        {
+            value = sifs;
+        }
+        else if (u < 0.55)
+        {
+            value = aifs + slot * uniform->GetInteger(0, 15);
+        }
+        else if (u < 0.70)
+        {
+            value = slot;
+        }
+        else if (u < 0.90)
+        {
+            // PPDU duration, multiple of 4 us, up to the maximum PPDU duration
+            value = 4000 * uniform->GetInteger(10, 1371);
+        }
+        else if (u < 0.97)
+        {
+            value = timeout;
+        }
+        else
+        {
+            value = beacon;
+        }
+    }
+    auto drv = CreateObject<DeterministicRandomVariable>();
+    drv->SetValueArray(nsValues);
+    return drv;
+}
+
 int
 main(int argc, char* argv[])
 {
     bool allSched = false;
     bool schedCal = false;
     bool schedHeap = false;
+    bool schedLadder = false;
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
@@ -465,6 +524,7 @@ main(int argc, char* argv[])
     uint64_t total = 1000000;
     uint64_t runs = 1;
     std::string filename = "";
+    bool wifi = false;
     bool calRev = false;
 
     CommandLine cmd(__FILE__);
@@ -474,6 +534,7 @@ main(int argc, char* argv[])
               "  an exponential distribution, with mean 100 ns,\n"
               "  an ascii file, given by the --file=\"<filename>\" argument,\n"
               "  or standard input, by the argument --file=\"-\"\n"
+              "  or a Wi-Fi shaped distribution, given by the --wifi argument.\n"
               "In the case of either --file form, the input is expected\n"
               "to be ascii, giving the relative event times in ns.\n"
               "\n"
@@ -482,6 +543,7 @@ main(int argc, char* argv[])
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -490,6 +552,7 @@ main(int argc, char* argv[])
     cmd.AddValue("total", "total number of events to run", total);
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
+    cmd.AddValue("wifi", "use a Wi-Fi shaped distribution of event times", wifi);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
     cmd.Parse(argc, argv);
 
@@ -505,15 +568,15 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ))
     {
         schedMap = true;
     }
 
-    auto eventStream = GetRandomStream(filename);
+    auto eventStream = wifi ? GetWifiStream() : GetRandomStream(filename);
 
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
@@ -532,6 +595,11 @@ main(int argc, char* argv[])
         factory.SetTypeId("ns3::HeapScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
     if (schedList)
     {
         factory.SetTypeId("ns3::ListScheduler");
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/**
+ * Reference counted object passed to the trace sinks, standing for the
+ * packets passed to the sinks of the trace sources of the network models.
+ */
+class TracedItem : public SimpleRefCount<TracedItem>
+{
+  public:
+    uint32_t m_size{1500}; //!< The size of the item.
+};
+
+/**
+ *  Benchmark of the invocation of a TracedCallback, with a given number of
+ *  trace sinks connected, as done by the trace sources of the network models
+ *  (e.g., WifiPhy::PhyRxBegin or Queue::Enqueue).
+ */
+class TracedCallbackBench
+{
+  public:
+    /**
+     * Constructor
+     * \param [in] sinks The number of trace sinks.
+     */
+    TracedCallbackBench(uint32_t sinks);
+
+    /**
+     * Fire the trace source a given number of times.
+     * \param [in] iterations The number of times the trace source is fired.
+     * \return The wall clock time, in seconds.
+     */
+    double Run(uint64_t iterations);
+
+    /** \return The total size received by the trace sinks. */
+    uint64_t GetTotal() const;
+
+  private:
+    /**
+     * A trace sink.
+     * \param [in] item The traced item.
+     * \param [in] power A traced value.
+     */
+    void Sink(Ptr<const TracedItem> item, double power);
+
+    TracedCallback<Ptr<const TracedItem>, double> m_trace; //!< The trace source.
+    uint64_t m_total;                                      //!< The total traced size.
+};
+
+TracedCallbackBench::TracedCallbackBench(uint32_t sinks)
+    : m_total(0)
+{
+    for (uint32_t i = 0; i < sinks; ++i)
+    {
+        m_trace.ConnectWithoutContext(MakeCallback(&TracedCallbackBench::Sink, this));
+    }
+}
+
+void
+TracedCallbackBench::Sink(Ptr<const TracedItem> item, double power)
+{
+    m_total += item->m_size + static_cast<uint64_t>(power);
+}
+
+uint64_t
+TracedCallbackBench::GetTotal() const
+{
+    return m_total;
+}
+
+double
+TracedCallbackBench::Run(uint64_t iterations)
+{
+    Ptr<TracedItem> item = Create<TracedItem>();
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        m_trace(item, static_cast<double>(i & 0xff));
+    }
+    return timer.End() / 1000.0;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string sinkList = "0,1,4";
+    uint64_t iterations = 10000000;
+    uint64_t runs = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the invocation of a TracedCallback.\n"
+              "\n"
+              "A TracedCallback with the given numbers of trace sinks connected\n"
+              "is fired with a reference counted object and a double.");
+    cmd.AddValue("sinks", "comma separated list of numbers of trace sinks", sinkList);
+    cmd.AddValue("iterations", "number of times the trace source is fired per run", iterations);
+    cmd.AddValue("runs", "number of runs", runs);
+    cmd.Parse(argc, argv);
+
+    std::vector<uint32_t> sinks;
+    std::istringstream iss(sinkList);
+    std::string token;
+    while (std::getline(iss, token, ','))
+    {
+        sinks.push_back(std::stoul(token));
+    }
+
+    LOG(cmd.GetName() << ": Benchmark the invocation of a TracedCallback");
+    LOG("  Iterations per run:    " << iterations);
+    LOG("  Number of runs:        " << runs);
+    LOG("");
+    LOG(std::left << std::setw(8) << "Sinks" << std::setw(12) << "Time (s)" << "ns/fire");
+
+    for (auto n : sinks)
+    {
+        TracedCallbackBench bench(n);
+        double total = 0;
+        for (uint64_t run = 0; run < runs; ++run)
+        {
+            total += bench.Run(iterations);
+        }
+        NS_ABORT_MSG_IF(bench.GetTotal() == 0 && n > 0, "Trace sinks not invoked");
+        LOG(std::left << std::setw(8) << n << std::setw(12) << total / runs
+                      << total * 1e9 / (iterations * runs));
+    }
+    return 0;
+}